@@ -9,6 +9,7 @@
 #include "control/layout/LayoutsManager.hpp"
 #include "control/media/MediaParsersRepo.hpp"
 #include "control/media/webview/LocalWebServer.hpp"
+#include "control/media/webview/WebViewWidgetFactory.hpp"
 #include "control/screenshot/ScreeShoterFactory.hpp"
 #include "control/screenshot/ScreenShotInterval.hpp"
 
@@ -20,14 +21,18 @@
 #include "cms/xmds/SoapRequestSender.hpp"
 #include "cms/xmds/XmdsRequestSender.hpp"
 #include "networking/HttpClient.hpp"
+#include "networking/PeerDiscovery.hpp"
 
 #include "common/PlayerRuntimeError.hpp"
 #include "common/crypto/RsaManager.hpp"
 #include "common/fs/FileSystem.hpp"
 #include "common/logger/Logging.hpp"
+#include "common/logger/XmlLogsRepo.hpp"
 #include "common/storage/FileCacheImpl.hpp"
 #include "common/system/System.hpp"
 
+#include <sstream>
+
 static std::unique_ptr<XiboApp> g_app;
 
 XiboApp& xiboApp()
@@ -53,7 +58,10 @@ XiboApp::XiboApp(const std::string& name) :
     if (!FileSystem::exists(AppConfig::cmsSettingsPath()))
         throw PlayerRuntimeError{"XiboApp", "Update CMS settings using player options app"};
 
+    attachLogsSpool();
     playerSettings_.logLevel().valueChanged().connect([](const std::string& logLevel) { Log::setLevel(logLevel); });
+    playerSettings_.subsystemLogLevels().valueChanged().connect(
+        [](const std::string& levels) { Log::setSubsystemLevels(levels); });
 
     cmsSettings_.fromFile(AppConfig::cmsSettingsPath());
     playerSettings_.fromFile(AppConfig::playerSettingsPath());
@@ -64,9 +72,25 @@ XiboApp::XiboApp(const std::string& name) :
     checkResourceDirectory();
 
     webserver_->setRootDirectory(cmsSettings_.resourcesPath());
+    auto webServerCacheKiB = std::max(cmsSettings_.webServerCacheSize().value(), 0);
+    webserver_->setAssetCacheSize(static_cast<size_t>(webServerCacheKiB) * 1024);
+    fileCache_->fileSaved().connect([this](const std::string& fileName) { webserver_->invalidate(fileName); });
+    try
+    {
+        webserver_->setCacheControl(CacheControlRules::fromString(cmsSettings_.webServerCacheControl()));
+    }
+    catch (std::exception& e)
+    {
+        Log::error("[XiboApp] Web server cache control ignored: {}", e.what());
+    }
+    webserver_->setThreadsCount(cmsSettings_.webServerThreads());
+    webserver_->setIdleTimeout(std::chrono::seconds{std::max(cmsSettings_.webServerIdleTimeout().value(), 1)});
+    auto webProxyCacheMiB = std::max(cmsSettings_.webProxyCacheSize().value(), 0);
+    webserver_->setProxyCache(AppConfig::webProxyCacheDirectory(), static_cast<uint64_t>(webProxyCacheMiB) << 20);
     webserver_->run(playerSettings_.embeddedServerPort());
 
-    HttpClient::instance().setProxyServer(cmsSettings_.proxy());
+    configureHttpClient();
+    configureLanSharing();
     RsaManager::instance().load();
     xmrManager_ = createXmrManager();
 
@@ -76,6 +100,10 @@ XiboApp::XiboApp(const std::string& name) :
         layoutManager_.reset();
         xmrManager_->stop();
         HttpClient::instance().shutdown();
+        if (peerDiscovery_)
+        {
+            peerDiscovery_->stop();
+        }
         if (collectionInterval_)
         {
             collectionInterval_->stop();
@@ -111,6 +139,10 @@ std::unique_ptr<XmrManager> XiboApp::createXmrManager()
 int XiboApp::run()
 {
     mainWindow_ = createMainWindow();
+    WebViewWidgetFactory::configure(AppConfig::webViewCacheDirectory(),
+                                    cmsSettings_.webViewCacheModel(),
+                                    cmsSettings_.webViewProcesses(),
+                                    webserver_->proxyAddress());
     layoutManager_ = createLayoutManager();
 
     playerSettings_.statsEnabled().valueChanged().connect(
@@ -118,10 +150,12 @@ int XiboApp::run()
 
     xmdsManager_ =
         std::make_unique<XmdsRequestSender>(cmsSettings_.address(), cmsSettings_.key(), cmsSettings_.displayId());
+    xmdsManager_->setUploadCompression(cmsSettings_.compressRequests());
     screenShotInterval_ = createScreenshotInterval(*xmdsManager_, *mainWindow_);
     collectionInterval_ = createCollectionInterval(*xmdsManager_);
 
     collectionInterval_->setCurrentLayoutId(scheduler_->currentLayoutId());
+    collectionInterval_->setPeerDiscovery(peerDiscovery_.get());
 
     scheduler_->layoutUpdated().connect(
         [this]() { collectionInterval_->setCurrentLayoutId(scheduler_->currentLayoutId()); });
@@ -156,8 +190,11 @@ std::shared_ptr<ApplicationWindowGtk> XiboApp::createMainWindow()
 
     window->statusScreenShown().connect([this, window]() {
         CHECK_UI_THREAD();
-        StatusInfo info{
-            collectGeneralInfo(), collectionInterval_->status(), scheduler_->status(), xmrManager_->status()};
+        StatusInfo info{collectGeneralInfo(),
+                        collectionInterval_->status(),
+                        scheduler_->status(),
+                        xmrManager_->status(),
+                        screenShotInterval_->status()};
 
         window->updateStatusScreen(info, fileCache_->invalidFiles());
     });
@@ -172,6 +209,17 @@ std::unique_ptr<LayoutsManager> XiboApp::createLayoutManager()
     auto manager =
         std::make_unique<LayoutsManager>(*scheduler_, *statsRecorder_, *fileCache_, playerSettings_.statsEnabled());
 
+    std::istringstream hiddenWebViews{cmsSettings_.hiddenWebViews()};
+    HiddenWebViews policy;
+    if (hiddenWebViews >> policy)
+    {
+        manager->hiddenWebViews(policy);
+    }
+    else
+    {
+        Log::error("[XiboApp] Hidden web views policy {} ignored", cmsSettings_.hiddenWebViews().value());
+    }
+
     manager->mainLayoutFetched().connect([this](const MainLayoutWidget& layout) {
         CHECK_UI_THREAD();
         if (layout)
@@ -229,6 +277,94 @@ void XiboApp::checkResourceDirectory()
     }
 }
 
+void XiboApp::attachLogsSpool()
+{
+    try
+    {
+        XmlLogsRepo::get().attachSpool(AppConfig::logsSpoolPath().string());
+    }
+    catch (std::exception& e)
+    {
+        Log::error("[XiboApp] Logs will be kept in memory: {}", e.what());
+    }
+}
+
+void XiboApp::configureHttpClient()
+{
+    HttpTimeouts timeouts;
+    timeouts.connect = std::chrono::seconds{cmsSettings_.connectTimeout().value()};
+    timeouts.handshake = std::chrono::seconds{cmsSettings_.handshakeTimeout().value()};
+    timeouts.firstByte = std::chrono::seconds{cmsSettings_.firstByteTimeout().value()};
+    timeouts.idle = std::chrono::seconds{cmsSettings_.idleTimeout().value()};
+
+    HttpRetryPolicy retryPolicy;
+    retryPolicy.maxAttempts = static_cast<unsigned int>(std::max(cmsSettings_.requestAttempts().value(), 1));
+    retryPolicy.hedging = cmsSettings_.hedgeChunkRequests();
+
+    auto&& client = HttpClient::instance();
+    client.setProxyServer(cmsSettings_.proxy());
+    client.setTimeouts(timeouts);
+    client.setRetryPolicy(retryPolicy);
+
+    applyBandwidthLimits();
+    applyDownloadWindows(playerSettings_.downloadWindows());
+    playerSettings_.maxDownloadRate().valueChanged().connect([this](int) { applyBandwidthLimits(); });
+    playerSettings_.maxRequestDownloadRate().valueChanged().connect([this](int) { applyBandwidthLimits(); });
+    playerSettings_.downloadWindows().valueChanged().connect(
+        [this](const std::string& windows) { applyDownloadWindows(windows); });
+
+    try
+    {
+        if (!cmsSettings_.httpReplayFile().value().empty())
+            client.replayFrom(cmsSettings_.httpReplayFile().value(), cmsSettings_.httpReplaySpeed());
+        else if (!cmsSettings_.httpCaptureFile().value().empty())
+            client.startCapture(cmsSettings_.httpCaptureFile().value());
+    }
+    catch (std::exception& e)
+    {
+        Log::error("[XiboApp] HTTP capture disabled: {}", e.what());
+    }
+}
+
+void XiboApp::applyBandwidthLimits()
+{
+    auto kibToBytes = [](int kib) { return static_cast<uint64_t>(std::max(kib, 0)) * 1024; };
+    HttpClient::instance().setBandwidthLimits(kibToBytes(playerSettings_.maxDownloadRate()),
+                                              kibToBytes(playerSettings_.maxRequestDownloadRate()));
+}
+
+void XiboApp::applyDownloadWindows(const std::string& windows)
+{
+    try
+    {
+        HttpClient::instance().setDownloadWindows(DownloadWindows::fromString(windows));
+    }
+    catch (std::exception& e)
+    {
+        Log::error("[XiboApp] Download windows ignored: {}", e.what());
+    }
+}
+
+void XiboApp::configureLanSharing()
+{
+    if (!cmsSettings_.lanSharing()) return;
+
+    webserver_->shareOnLan(cmsSettings_.lanSharingAddress(),
+                           static_cast<unsigned short>(cmsSettings_.lanSharingPort().value()),
+                           [this](const std::string& md5) -> boost::optional<FilePath> {
+                               if (auto file = fileCache_->cachedFile(Md5Hash{md5}))
+                               {
+                                   return FilePath{cmsSettings_.resourcesPath().value() / *file};
+                               }
+                               return {};
+                           });
+
+    auto discoveryPort = static_cast<unsigned short>(cmsSettings_.lanDiscoveryPort().value());
+    peerDiscovery_ = std::make_unique<PeerDiscovery>(discoveryPort);
+    peerDiscovery_->addStaticPeers(cmsSettings_.lanPeers());
+    peerDiscovery_->start(static_cast<unsigned short>(cmsSettings_.lanSharingPort().value()));
+}
+
 std::unique_ptr<CollectionInterval> XiboApp::createCollectionInterval(XmdsRequestSender& xmdsManager)
 {
     auto interval = std::make_unique<CollectionInterval>(
@@ -255,6 +391,16 @@ std::unique_ptr<ScreenShotInterval> XiboApp::createScreenshotInterval(XmdsReques
 {
     auto interval = std::make_unique<ScreenShotInterval>(xmdsManager, window);
 
+    std::istringstream screenshotFormat{cmsSettings_.screenshotFormat()};
+    ScreenShotFormat format;
+    if (!(screenshotFormat >> format))
+    {
+        Log::error("[XiboApp] Screenshot format {} ignored, JPEG is used", cmsSettings_.screenshotFormat().value());
+        format = ScreenShotFormat::Jpeg;
+    }
+    interval->setEncoding(format, cmsSettings_.screenshotQuality(), cmsSettings_.screenshotMaxSize());
+    interval->setMaxAge(std::chrono::minutes{std::max(cmsSettings_.screenshotMaxAge().value(), 0)});
+
     interval->updateInterval(playerSettings_.screenshotInterval());
     playerSettings_.screenshotInterval().valueChanged().connect(
         std::bind(&ScreenShotInterval::updateInterval, interval.get(), ph::_1));
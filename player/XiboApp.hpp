@@ -21,6 +21,7 @@ class PlayerError;
 class XmrManager;
 using ApplicationWindowGtk = ApplicationWindow<WindowGtk>;
 class LocalWebServer;
+class PeerDiscovery;
 namespace Stats
 {
     class Recorder;
@@ -51,6 +52,11 @@ private:
     void onCollectionFinished(const PlayerError& error);
     GeneralInfo collectGeneralInfo();
     void checkResourceDirectory();
+    void attachLogsSpool();
+    void configureHttpClient();
+    void applyBandwidthLimits();
+    void applyDownloadWindows(const std::string& windows);
+    void configureLanSharing();
 
 private:
     PlayerSettings playerSettings_;
@@ -66,5 +72,6 @@ private:
     std::unique_ptr<XmrManager> xmrManager_;
     std::shared_ptr<ApplicationWindowGtk> mainWindow_;
     std::shared_ptr<LocalWebServer> webserver_;
+    std::unique_ptr<PeerDiscovery> peerDiscovery_;
     std::unique_ptr<LayoutsManager> layoutManager_;
 };
@@ -25,21 +25,30 @@ struct fmt::formatter<std::atomic<int>> : fmt::formatter<int> {
 #include "config/AppConfig.hpp"
 
 #include "cms/xmds/XmdsRequestSender.hpp"
-#include "stat/Recorder.hpp"
-#include "stat/records/XmlFormatter.hpp"
+#include "networking/HttpClient.hpp"
 
 namespace ph = std::placeholders;
 
+bool allSucceeded(DownloadResults results)
+{
+    bool succeeded = true;
+    for (auto&& result : results)
+    {
+        succeeded = result.get() && succeeded;
+    }
+    return succeeded;
+}
+
 CollectionInterval::CollectionInterval(XmdsRequestSender& xmdsSender,
                                        Stats::Recorder& statsRecorder,
                                        FileCache& fileCache,
                                        const FilePath& resourceDirectory,
                                        const std::string& displayName) :
     xmdsSender_{xmdsSender},
-    statsRecorder_{statsRecorder},
     fileCache_{fileCache},
     resourceDirectory_{resourceDirectory},
     displayName_{displayName},
+    statsUploader_{std::make_unique<StatsUploader>(xmdsSender, statsRecorder)},
     intervalTimer_{std::make_unique<Timer>()},
     collectInterval_{DefaultInterval},
     running_{false},
@@ -56,6 +65,7 @@ bool CollectionInterval::running() const
 
 void CollectionInterval::stop()
 {
+    statsUploader_->stop();
     workerThread_.reset();
 }
 
@@ -74,7 +84,7 @@ void CollectionInterval::collectNow()
 
             auto registerDisplayResult =
                 xmdsSender_.registerDisplay(AppConfig::codeVersion(), AppConfig::releaseVersion(), displayName_).get();
-            onDisplayRegistered(registerDisplayResult);
+            onDisplayRegistered(std::move(registerDisplayResult));
         });
     }
 }
@@ -85,12 +95,30 @@ void CollectionInterval::sessionFinished(const PlayerError& error)
     startTimer();
     Log::debug("[CollectionInterval] Finished. Next collection will start in {} seconds", collectInterval_);
 
+    auto transfer = HttpClient::instance().transferStats();
+    Log::debug("[HttpClient] Received {} bytes ({} decoded), sent {} bytes ({} before compression)",
+               transfer.receivedBytes,
+               transfer.decodedBytes,
+               transfer.sentBytes,
+               transfer.unencodedSentBytes);
+    Log::debug("[HttpClient] {} resolves ({} cached) in {} ms, {} connects ({} fallbacks) in {} ms",
+               transfer.resolves,
+               transfer.resolveCacheHits,
+               transfer.resolveTime.count(),
+               transfer.connects,
+               transfer.connectFallbacks,
+               transfer.connectTime.count());
+    Log::debug("[HttpClient] {} timeouts, {} retries, {} hedged requests",
+               transfer.timeouts,
+               transfer.retries,
+               transfer.hedges);
+
     MainLoop::pushToUiThread([this, error]() { collectionFinished_(error); });
 }
 
-void CollectionInterval::onDisplayRegistered(const ResponseResult<RegisterDisplay::Result>& registerDisplay)
+void CollectionInterval::onDisplayRegistered(ResponseResult<RegisterDisplay::Result>&& registerDisplay)
 {
-    auto [error, result] = registerDisplay;
+    auto&& [error, result] = registerDisplay;
     if (!error)
     {
         auto displayError = displayStatus(result.status);
@@ -103,11 +131,8 @@ void CollectionInterval::onDisplayRegistered(const ResponseResult<RegisterDispla
 
             MainLoop::pushToUiThread([this, result = std::move(result.playerSettings)]() { settingsUpdated_(result); });
 
-            auto requiredFilesResult = xmdsSender_.requiredFiles().get();
-            auto scheduleResult = xmdsSender_.schedule().get();
-
-            onSchedule(scheduleResult);
-            onRequiredFiles(requiredFilesResult);
+            updateSchedule(result.scheduleChecksum);
+            updateRequiredFiles(result.requiredFilesChecksum);
 
             submitLogs();
             submitStats();
@@ -126,6 +151,11 @@ void CollectionInterval::setCurrentLayoutId(const LayoutId& currentLayoutId)
     currentLayoutId_ = currentLayoutId;
 }
 
+void CollectionInterval::setPeerDiscovery(PeerDiscovery* peerDiscovery)
+{
+    peerDiscovery_ = peerDiscovery;
+}
+
 PlayerError CollectionInterval::displayStatus(const RegisterDisplay::Result::Status& status)
 {
     using DisplayCode = RegisterDisplay::Result::Status::Code;
@@ -174,27 +204,74 @@ SignalFilesDownloaded& CollectionInterval::filesDownloaded()
     return filesDownloaded_;
 }
 
-void CollectionInterval::onRequiredFiles(const ResponseResult<RequiredFiles::Result>& requiredFiles)
+// CMS checksum from RegisterDisplay allows to skip the request itself, otherwise the payload fingerprint
+// is used to skip the processing of an unchanged response
+void CollectionInterval::updateRequiredFiles(const std::string& checksum)
+{
+    if (!checksum.empty() && checksum == requiredFilesChecksum_)
+    {
+        Log::debug("[XMDS::RequiredFiles] Not changed");
+        return;
+    }
+
+    onRequiredFiles(xmdsSender_.requiredFiles().get(), checksum);
+}
+
+void CollectionInterval::updateSchedule(const std::string& checksum)
+{
+    if (!checksum.empty() && checksum == scheduleChecksum_)
+    {
+        Log::debug("[XMDS::Schedule] Not changed");
+        return;
+    }
+
+    onSchedule(xmdsSender_.schedule().get(), checksum);
+}
+
+void CollectionInterval::onRequiredFiles(ResponseResult<RequiredFiles::Result>&& requiredFiles,
+                                         const std::string& checksum)
 {
-    auto [error, result] = requiredFiles;
+    auto&& [error, result] = requiredFiles;
     if (!error)
     {
         Log::debug("[XMDS::RequiredFiles] Received");
 
-        RequiredFilesDownloader downloader{xmdsSender_, fileCache_};
+        if (result.fingerprint() == requiredFilesFingerprint_)
+        {
+            Log::debug("[XMDS::RequiredFiles] Content not changed");
+            requiredFilesChecksum_ = checksum;
+            return;
+        }
+
+        RequiredFilesDownloader downloader{xmdsSender_, fileCache_, peerDiscovery_};
 
         auto&& files = result.requiredFiles();
         auto&& resources = result.requiredResources();
 
         status_.requiredFiles = files.size() + resources.size();
 
+        // waiting for the next download window would hold the rest of the collection back for hours
+        bool filesAllowed = HttpClient::instance().downloadsAllowed();
+        if (!filesAllowed)
+        {
+            Log::info("[CollectionInterval] Files will be downloaded in the next download window");
+        }
+
         auto resourcesResult = downloader.download(resources);
-        auto filesResult = downloader.download(files);
+        auto filesResult = filesAllowed ? downloader.download(files) : boost::make_ready_future(DownloadResults{});
 
-        resourcesResult.wait();
-        filesResult.wait();
+        // both have to be waited for as the downloader is destroyed afterwards
+        bool resourcesDownloaded = allSucceeded(resourcesResult.get());
+        bool filesDownloaded = allSucceeded(filesResult.get());
+        bool downloaded = filesAllowed && resourcesDownloaded && filesDownloaded;
+        bool inventorySubmitted = updateMediaInventory(result);
 
-        updateMediaInventory(result);
+        // failed downloads should be retried next time so the response is not remembered
+        if (downloaded && inventorySubmitted)
+        {
+            requiredFilesFingerprint_ = result.fingerprint();
+            requiredFilesChecksum_ = checksum;
+        }
 
         MainLoop::pushToUiThread([this]() { filesDownloaded_(); });
     }
@@ -204,7 +281,7 @@ void CollectionInterval::onRequiredFiles(const ResponseResult<RequiredFiles::Res
     }
 }
 
-void CollectionInterval::updateMediaInventory(const RequiredFiles::Result& result)
+bool CollectionInterval::updateMediaInventory(const RequiredFiles::Result& result)
 {
     MediaInventoryItems items;
     for (auto&& file : result.requiredFiles())
@@ -215,18 +292,37 @@ void CollectionInterval::updateMediaInventory(const RequiredFiles::Result& resul
     {
         items.emplace_back(file, fileCache_.valid(file.name()));
     }
-    onSubmitted("MediaInventory", xmdsSender_.mediaInventory(std::move(items)).get());
+    if (items == submittedInventory_)
+    {
+        Log::debug("[XMDS::MediaInventory] Not changed");
+        return true;
+    }
+
+    auto submitResult = xmdsSender_.mediaInventory(MediaInventoryItems{items}).get();
+    onSubmitted("MediaInventory", submitResult);
+
+    auto&& [error, submitted] = submitResult;
+    if (error || !submitted.success) return false;
+
+    submittedInventory_ = std::move(items);
+    return true;
 }
 
-void CollectionInterval::onSchedule(const ResponseResult<Schedule::Result>& schedule)
+void CollectionInterval::onSchedule(ResponseResult<Schedule::Result>&& schedule, const std::string& checksum)
 {
-    auto [error, result] = schedule;
+    auto&& [error, result] = schedule;
     if (!error)
     {
         Log::debug("[XMDS::Schedule] Received");
-        MainLoop::pushToUiThread([this, result = std::move(result)]() {
-            scheduleAvailable_(LayoutSchedule::fromString(result.scheduleXml));
-        });
+
+        scheduleChecksum_ = checksum;
+        if (result.fingerprint == scheduleFingerprint_)
+        {
+            Log::debug("[XMDS::Schedule] Content not changed");
+            return;
+        }
+        scheduleFingerprint_ = result.fingerprint;
+        MainLoop::pushToUiThread([this, result = std::move(result)]() { scheduleAvailable_(result.schedule); });
     }
     else
     {
@@ -234,42 +330,29 @@ void CollectionInterval::onSchedule(const ResponseResult<Schedule::Result>& sche
     }
 }
 
+// Logs are sent in bounded chunks and removed from the spool only after the CMS accepted them
 void CollectionInterval::submitLogs()
 {
     XmlLogsRetriever logsRetriever;
-    auto submitLogsResult = xmdsSender_.submitLogs(logsRetriever.retrieveLogs()).get();
-    onSubmitted("SubmitLogs", submitLogsResult);
-}
-
-void CollectionInterval::submitStats()
-{
-    try
+    for (size_t chunk = 0; chunk != MaxLogChunksPerCollection; ++chunk)
     {
-        const auto recordsCount = statsRecorder_.recordsCount();
-        if (recordsCount > 0)
-        {
-            const auto RecordsToSend = [recordsCount]() -> size_t {
-                if (recordsCount > 500)
-                    return 300;
-                else
-                    return recordsCount > 50 ? 50 : recordsCount;
-            }();
-
-            Log::debug("[CollectionInterval] Total records: {} Records to send {}", recordsCount, RecordsToSend);
+        auto logs = logsRetriever.retrieveLogs(MaxLogChunkSize);
+        if (logs.empty()) break;
 
-            auto records = statsRecorder_.records(RecordsToSend);
-            statsRecorder_.removeFromQueue(RecordsToSend);
-
-            Stats::XmlFormatter formatter;
-            auto submitStatsResult = xmdsSender_.submitStats(formatter.format(records)).get();
-            onSubmitted("SubmitStats", submitStatsResult);
+        auto submitLogsResult = xmdsSender_.submitLogs(logs.xml).get();
+        auto&& [error, result] = submitLogsResult;
+        if (error || !result.success)
+        {
+            onSubmitted("SubmitLogs", submitLogsResult);
+            break;
         }
+        logsRetriever.commit(logs);
     }
-    catch (const std::exception& e)
-    {
-        Log::error("[CollectionInterval] {}", e.what());
-        Log::error("[CollectionInterval] Failed to submit stats");
-    }
+}
+
+void CollectionInterval::submitStats()
+{
+    statsUploader_->upload();
 }
 
 void CollectionInterval::notifyStatus()
@@ -281,14 +364,26 @@ void CollectionInterval::notifyStatus()
     notifyInfo.spaceUsageInfo = FileSystem::storageUsageFor(resourceDirectory_);
     notifyInfo.timezone = DateTime::currentTimezone();
 
+    if (submittedStatus_ && !notifyInfo.differsFrom(*submittedStatus_))
+    {
+        Log::debug("[XMDS::NotifyStatus] Not changed");
+        return;
+    }
+
     auto notifyStatusResult = xmdsSender_.notifyStatus(notifyInfo.string()).get();
     onSubmitted("NotifyStatus", notifyStatusResult);
+
+    auto&& [error, result] = notifyStatusResult;
+    if (!error && result.success)
+    {
+        submittedStatus_ = notifyInfo;
+    }
 }
 
 template <typename Result>
 void CollectionInterval::onSubmitted(std::string_view requestName, const ResponseResult<Result>& submitResult)
 {
-    auto [error, result] = submitResult;
+    auto&& [error, result] = submitResult;
     if (!error)
     {
         if (result.success)
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "CmsStatus.hpp"
+#include "NotifyStatusInfo.hpp"
 #include "RequiredFilesDownloader.hpp"
+#include "StatsUploader.hpp"
 
+#include "cms/xmds/MediaInventoryItem.hpp"
 #include "cms/xmds/NotifyStatus.hpp"
 #include "cms/xmds/RegisterDisplay.hpp"
 #include "cms/xmds/RequiredFiles.hpp"
@@ -17,6 +20,7 @@
 #include "common/fs/FilePath.hpp"
 
 #include <boost/signals2/signal.hpp>
+#include <optional>
 
 using CollectionResultCallback = std::function<void(const PlayerError&)>;
 using SignalSettingsUpdated = boost::signals2::signal<void(const PlayerSettings&)>;
@@ -30,10 +34,13 @@ namespace Stats
     class Recorder;
 }
 class FileCache;
+class PeerDiscovery;
 
 class CollectionInterval
 {
     static constexpr const uint DefaultInterval = 900;
+    static constexpr const size_t MaxLogChunkSize = 256 * 1024;
+    static constexpr const size_t MaxLogChunksPerCollection = 16;
 
 public:
     CollectionInterval(XmdsRequestSender& xmdsSender,
@@ -54,16 +61,20 @@ public:
     SignalFilesDownloaded& filesDownloaded();
 
     void setCurrentLayoutId(const LayoutId& currentLayoutId);
+    // media is requested from the discovered LAN peers before the CMS
+    void setPeerDiscovery(PeerDiscovery* peerDiscovery);
 
 private:
     void startTimer();
     void sessionFinished(const PlayerError& = {});
 
-    void onDisplayRegistered(const ResponseResult<RegisterDisplay::Result>& registerDisplay);
+    void onDisplayRegistered(ResponseResult<RegisterDisplay::Result>&& registerDisplay);
     PlayerError displayStatus(const RegisterDisplay::Result::Status& status);
-    void onRequiredFiles(const ResponseResult<RequiredFiles::Result>& requiredFiles);
-    void updateMediaInventory(const RequiredFiles::Result& requiredFilesResult);
-    void onSchedule(const ResponseResult<Schedule::Result>& schedule);
+    void updateRequiredFiles(const std::string& checksum);
+    void updateSchedule(const std::string& checksum);
+    void onRequiredFiles(ResponseResult<RequiredFiles::Result>&& requiredFiles, const std::string& checksum);
+    bool updateMediaInventory(const RequiredFiles::Result& requiredFilesResult);
+    void onSchedule(ResponseResult<Schedule::Result>&& schedule, const std::string& checksum);
     void submitLogs();
     void submitStats();
     void notifyStatus();
@@ -72,11 +83,12 @@ private:
 
 private:
     XmdsRequestSender& xmdsSender_;
-    Stats::Recorder& statsRecorder_;
     FileCache& fileCache_;
+    PeerDiscovery* peerDiscovery_ = nullptr;
     FilePath resourceDirectory_;
     std::string displayName_;
 
+    std::unique_ptr<StatsUploader> statsUploader_;
     std::unique_ptr<JoinableThread> workerThread_;
     std::unique_ptr<Timer> intervalTimer_;
     std::atomic_int collectInterval_;
@@ -84,6 +96,14 @@ private:
     CmsStatus status_;
     LayoutId currentLayoutId_;
 
+    // state of the last fully processed responses, used to skip unchanged ones
+    std::string requiredFilesChecksum_;
+    std::string scheduleChecksum_;
+    Md5Hash requiredFilesFingerprint_;
+    Md5Hash scheduleFingerprint_;
+    MediaInventoryItems submittedInventory_;
+    std::optional<NotifyStatusInfo> submittedStatus_;
+
     SignalSettingsUpdated settingsUpdated_;
     SignalScheduleAvailable scheduleAvailable_;
     SignalCollectionFinished collectionFinished_;
@@ -2,6 +2,8 @@
 
 #include "common/parsing/Parsing.hpp"
 
+const std::uintmax_t AvailableSpaceThreshold = 10 * 1024 * 1024;
+
 std::string NotifyStatusInfo::string() const
 {
     JsonNode tree;
@@ -13,3 +15,16 @@ std::string NotifyStatusInfo::string() const
     tree.put("timeZone", timezone);
     return Parsing::jsonToString(tree);
 }
+
+// Available space changes with every written file so only noticeable changes are reported
+bool NotifyStatusInfo::differsFrom(const NotifyStatusInfo& other) const
+{
+    auto spaceDelta = spaceUsageInfo.available > other.spaceUsageInfo.available
+                          ? spaceUsageInfo.available - other.spaceUsageInfo.available
+                          : other.spaceUsageInfo.available - spaceUsageInfo.available;
+
+    return currentLayoutId != other.currentLayoutId || spaceUsageInfo.total != other.spaceUsageInfo.total ||
+           spaceDelta >= AvailableSpaceThreshold ||
+           static_cast<const std::string&>(deviceName) != static_cast<const std::string&>(other.deviceName) ||
+           timezone != other.timezone;
+}
@@ -7,6 +7,7 @@
 struct NotifyStatusInfo
 {
     std::string string() const;
+    bool differsFrom(const NotifyStatusInfo& other) const;
 
     LayoutId currentLayoutId;
     StorageUsageInfo spaceUsageInfo;
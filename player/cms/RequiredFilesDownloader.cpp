@@ -3,47 +3,54 @@
 #include "cms/xmds/XmdsFileDownloader.hpp"
 #include "cms/xmds/XmdsRequestSender.hpp"
 #include "common/storage/FileCache.hpp"
+#include "common/logger/Logging.hpp"
 #include "networking/HttpClient.hpp"
+#include "networking/PeerDiscovery.hpp"
 
-RequiredFilesDownloader::RequiredFilesDownloader(XmdsRequestSender& xmdsRequestSender, FileCache& fileCache) :
+static LogRateLimiter g_downloadedLogLimiter{10, 50};
+
+RequiredFilesDownloader::RequiredFilesDownloader(XmdsRequestSender& xmdsRequestSender,
+                                                 FileCache& fileCache,
+                                                 PeerDiscovery* peerDiscovery) :
     xmdsRequestSender_{xmdsRequestSender},
     fileCache_{fileCache},
+    peerDiscovery_{peerDiscovery},
     xmdsFileDownloader_{std::make_unique<XmdsFileDownloader>(xmdsRequestSender)}
 {
 }
 
 RequiredFilesDownloader::~RequiredFilesDownloader() {}
 
-bool RequiredFilesDownloader::onRegularFileDownloaded(const ResponseContentResult& result, const RegularFile& file)
+bool RequiredFilesDownloader::onRegularFileDownloaded(ResponseContentResult&& result, const RegularFile& file)
 {
-    auto [error, fileContent] = result;
+    auto&& [error, fileContent] = result;
     if (!error)
     {
         fileCache_.save(file.name(), fileContent, file.hash());
 
-        Log::debug("[{}] Downloaded", file.name());
+        Log::limited(g_downloadedLogLimiter, spdlog::level::debug, "[RequiredFilesDownloader] {} downloaded", file.name());
         return true;
     }
     else
     {
-        Log::error("[{}] Download error: {}", file.name(), error);
+        Log::error("[RequiredFilesDownloader] {} download error: {}", file.name(), error);
         return false;
     }
 }
 
-bool RequiredFilesDownloader::onResourceFileDownloaded(const ResponseContentResult& result, const ResourceFile& file)
+bool RequiredFilesDownloader::onResourceFileDownloaded(ResponseContentResult&& result, const ResourceFile& file)
 {
-    auto [error, fileContent] = result;
+    auto&& [error, fileContent] = result;
     if (!error)
     {
         fileCache_.save(file.name(), fileContent, file.lastUpdate());
 
-        Log::debug("[{}] Downloaded", file.name());
+        Log::limited(g_downloadedLogLimiter, spdlog::level::debug, "[RequiredFilesDownloader] {} downloaded", file.name());
         return true;
     }
     else
     {
-        Log::error("[{}] Download error: {}", file.name(), error);
+        Log::error("[RequiredFilesDownloader] {} download error: {}", file.name(), error);
         return false;
     }
 }
@@ -54,16 +61,100 @@ DownloadResult RequiredFilesDownloader::downloadRequiredFile(const ResourceFile&
         .then([this, file](auto future) {
             auto [error, result] = future.get();
 
-            return onResourceFileDownloaded(ResponseContentResult{error, result.resource}, file);
+            return onResourceFileDownloaded(ResponseContentResult{std::move(error), std::move(result.resource)}, file);
         });
 }
 
+// Players on the same LAN usually need the same media, so peers which already have a file are asked
+// for it before the CMS. Whatever a peer sends is checked against the hash from RequiredFiles.
 DownloadResult RequiredFilesDownloader::downloadRequiredFile(const RegularFile& file)
+{
+    auto peers = peerDiscovery_ ? peerDiscovery_->peers() : std::vector<Uri>{};
+    if (peers.empty()) return downloadFromCms(file);
+
+    std::vector<Uri> sources;
+    for (size_t i = 0; i != std::min(peers.size(), MaxPeerAttempts); ++i)
+    {
+        sources.emplace_back(Uri::fromString(peers[i].string() + "files/" + static_cast<std::string>(file.hash())));
+    }
+
+    auto result = std::make_shared<boost::promise<bool>>();
+    downloadFromPeers(file, std::move(sources), 0, result);
+    return result->get_future();
+}
+
+// Each attempt is started from the continuation of the previous one, so no thread waits for the peers
+void RequiredFilesDownloader::downloadFromPeers(const RegularFile& file,
+                                                std::vector<Uri> sources,
+                                                size_t attempt,
+                                                std::shared_ptr<boost::promise<bool>> result)
+{
+    if (attempt == sources.size())
+    {
+        try
+        {
+            downloadFromCms(file).then([result](DownloadResult future) {
+                try
+                {
+                    result->set_value(future.get());
+                }
+                catch (...)
+                {
+                    result->set_exception(boost::current_exception());
+                }
+            });
+        }
+        catch (...)
+        {
+            result->set_exception(boost::current_exception());
+        }
+        return;
+    }
+
+    HttpClient::instance()
+        .get(sources[attempt], RequestTraffic::Peer)
+        .then([this, file, sources = std::move(sources), attempt, result](
+                  boost::future<HttpResponseResult> future) mutable {
+            try
+            {
+                if (onPeerFileDownloaded(future.get(), file, sources[attempt])) return result->set_value(true);
+            }
+            catch (std::exception& e)
+            {
+                Log::error("[RequiredFilesDownloader] {}", e.what());
+            }
+            downloadFromPeers(file, std::move(sources), attempt + 1, std::move(result));
+        });
+}
+
+bool RequiredFilesDownloader::onPeerFileDownloaded(ResponseContentResult&& result,
+                                                   const RegularFile& file,
+                                                   const Uri& uri)
+{
+    auto&& [error, content] = result;
+    if (error) return false;
+
+    if (Md5Hash::fromString(content) != file.hash())
+    {
+        Log::error("[RequiredFilesDownloader] {} from {} doesn't match its hash", file.name(), uri.string());
+        return false;
+    }
+
+    fileCache_.save(file.name(), content, file.hash());
+    Log::limited(g_downloadedLogLimiter,
+                 spdlog::level::debug,
+                 "[RequiredFilesDownloader] {} downloaded from {}",
+                 file.name(),
+                 static_cast<std::string>(uri.authority().host()));
+    return true;
+}
+
+DownloadResult RequiredFilesDownloader::downloadFromCms(const RegularFile& file)
 {
     if (file.downloadType() == RegularFile::DownloadType::HTTP)
     {
         auto uri = Uri::fromString(file.url());
-        return HttpClient::instance().get(uri).then([this, file](boost::future<HttpResponseResult> future) {
+        return HttpClient::instance().get(uri, RequestTraffic::Download).then([this, file](boost::future<HttpResponseResult> future) {
             return onRegularFileDownloaded(future.get(), file);
         });
     }
@@ -3,6 +3,7 @@
 #include "common/crypto/Md5Hash.hpp"
 #include "common/logger/Logging.hpp"
 #include "common/storage/RequiredItems.hpp"
+#include "common/types/Uri.hpp"
 
 #include "networking/ResponseResult.hpp"
 
@@ -15,11 +16,16 @@ using ResponseContentResult = ResponseResult<std::string>;
 class XmdsFileDownloader;
 class XmdsRequestSender;
 class FileCache;
+class PeerDiscovery;
 
 class RequiredFilesDownloader
 {
+    static constexpr const size_t MaxPeerAttempts = 3;
+
 public:
-    RequiredFilesDownloader(XmdsRequestSender& xmdsRequestSender, FileCache& fileCache);
+    RequiredFilesDownloader(XmdsRequestSender& xmdsRequestSender,
+                            FileCache& fileCache,
+                            PeerDiscovery* peerDiscovery = nullptr);
     ~RequiredFilesDownloader();
 
     template <typename RequiredFileType>
@@ -72,19 +78,24 @@ private:
         return results;
     }
 
-    bool onRegularFileDownloaded(const ResponseContentResult& result, const RegularFile& file);
-    bool onResourceFileDownloaded(const ResponseContentResult& result, const ResourceFile& file);
+    bool onRegularFileDownloaded(ResponseContentResult&& result, const RegularFile& file);
+    bool onResourceFileDownloaded(ResponseContentResult&& result, const ResourceFile& file);
 
     bool shouldBeDownloaded(const RegularFile& file) const;
     bool shouldBeDownloaded(const ResourceFile& file) const;
 
     DownloadResult downloadRequiredFile(const ResourceFile& file);
     DownloadResult downloadRequiredFile(const RegularFile& file);
-    DownloadResult downloadHttpFile(const RegularFile& file);
-    DownloadResult downloadXmdsFile(const RegularFile& file);
+    DownloadResult downloadFromCms(const RegularFile& file);
+    void downloadFromPeers(const RegularFile& file,
+                           std::vector<Uri> sources,
+                           size_t attempt,
+                           std::shared_ptr<boost::promise<bool>> result);
+    bool onPeerFileDownloaded(ResponseContentResult&& result, const RegularFile& file, const Uri& uri);
 
 private:
     XmdsRequestSender& xmdsRequestSender_;
     FileCache& fileCache_;
+    PeerDiscovery* peerDiscovery_;
     std::unique_ptr<XmdsFileDownloader> xmdsFileDownloader_;
 };
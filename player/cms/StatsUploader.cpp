@@ -0,0 +1,134 @@
+#include "StatsUploader.hpp"
+
+#include "cms/xmds/XmdsRequestSender.hpp"
+#include "common/logger/Logging.hpp"
+#include "stat/Recorder.hpp"
+#include "stat/records/XmlFormatter.hpp"
+
+#include <algorithm>
+
+StatsUploader::StatsUploader(XmdsRequestSender& xmdsSender, Stats::Recorder& statsRecorder) :
+    xmdsSender_{xmdsSender},
+    statsRecorder_{statsRecorder},
+    running_{false},
+    stopped_{false},
+    batchSize_{DefaultBatchSize}
+{
+}
+
+StatsUploader::~StatsUploader()
+{
+    stop();
+}
+
+void StatsUploader::upload()
+{
+    std::lock_guard<std::mutex> lock{workerLock_};
+
+    if (running_ || stopped_) return;
+
+    running_ = true;
+    workerThread_ = std::make_unique<JoinableThread>([this]() {
+        uploadQueue();
+        running_ = false;
+    });
+}
+
+void StatsUploader::stop()
+{
+    std::lock_guard<std::mutex> lock{workerLock_};
+
+    stopped_ = true;
+    workerThread_.reset();
+}
+
+bool StatsUploader::running() const
+{
+    return running_;
+}
+
+void StatsUploader::uploadQueue()
+{
+    try
+    {
+        Log::debug("[StatsUploader] Started. Records in queue: {}", statsRecorder_.recordsCount());
+
+        int lastSubmittedId = Stats::InvalidId;
+        size_t bytesSent = 0;
+        size_t batchesSent = 0;
+
+        while (!stopped_ && bytesSent < MaxBytesPerUpload)
+        {
+            if (!submitBatch(lastSubmittedId, bytesSent)) break;
+
+            ++batchesSent;
+        }
+
+        Log::debug("[StatsUploader] Finished. Batches sent: {} Bytes sent: {} Records left: {}",
+                   batchesSent,
+                   bytesSent,
+                   statsRecorder_.recordsCount());
+    }
+    catch (const std::exception& e)
+    {
+        Log::error("[StatsUploader] {}", e.what());
+    }
+}
+
+// Returns true when the batch has been acknowledged or dropped and more records may be waiting
+bool StatsUploader::submitBatch(int& lastSubmittedId, size_t& bytesSent)
+{
+    Stats::XmlFormatter formatter;
+
+    auto batch = statsRecorder_.records(lastSubmittedId, batchSize_);
+    if (batch.firstId == Stats::InvalidId) return false;
+
+    auto statsXml = formatter.format(batch.records);
+    while (statsXml.size() > MaxBatchBytes && batchSize_ > MinBatchSize)
+    {
+        decreaseBatchSize();
+        batch = statsRecorder_.records(lastSubmittedId, batchSize_);
+        statsXml = formatter.format(batch.records);
+    }
+
+    // none of the stored rows could be turned into a record, so there is nothing to send for them
+    if (batch.empty())
+    {
+        Log::error("[StatsUploader] Dropping unreadable records {}-{}", batch.firstId, batch.lastId);
+
+        statsRecorder_.removeFromQueue(batch.firstId, batch.lastId);
+        lastSubmittedId = batch.lastId;
+        return true;
+    }
+
+    Log::trace("[StatsUploader] Sending records {}-{} ({} bytes)", batch.firstId, batch.lastId, statsXml.size());
+
+    auto [error, result] = xmdsSender_.submitStats(statsXml).get();
+    if (error || !result.success)
+    {
+        if (error)
+            Log::error("[XMDS::SubmitStats] {}", error);
+        else
+            Log::error("[XMDS::SubmitStats] Not submited due to unknown error");
+
+        decreaseBatchSize();
+        return false;
+    }
+
+    statsRecorder_.removeFromQueue(batch.firstId, batch.lastId);
+    lastSubmittedId = batch.lastId;
+    bytesSent += statsXml.size();
+    increaseBatchSize();
+
+    return true;
+}
+
+void StatsUploader::increaseBatchSize()
+{
+    batchSize_ = std::min(batchSize_ * 2, MaxBatchSize);
+}
+
+void StatsUploader::decreaseBatchSize()
+{
+    batchSize_ = std::max(batchSize_ / 2, MinBatchSize);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "common/JoinableThread.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+class XmdsRequestSender;
+namespace Stats
+{
+    class Recorder;
+}
+
+// Drains the stats queue in batches on its own thread. Records are removed from the queue
+// only after the CMS acknowledged the batch they were sent in.
+class StatsUploader
+{
+    static constexpr const size_t MinBatchSize = 50;
+    static constexpr const size_t MaxBatchSize = 1000;
+    static constexpr const size_t DefaultBatchSize = 300;
+    static constexpr const size_t MaxBatchBytes = 512 * 1024;
+    static constexpr const size_t MaxBytesPerUpload = 8 * 1024 * 1024;
+
+public:
+    StatsUploader(XmdsRequestSender& xmdsSender, Stats::Recorder& statsRecorder);
+    ~StatsUploader();
+
+    void upload();
+    void stop();
+    bool running() const;
+
+private:
+    void uploadQueue();
+    bool submitBatch(int& lastSubmittedId, size_t& bytesSent);
+    void increaseBatchSize();
+    void decreaseBatchSize();
+
+private:
+    XmdsRequestSender& xmdsSender_;
+    Stats::Recorder& statsRecorder_;
+
+    std::mutex workerLock_;
+    std::unique_ptr<JoinableThread> workerThread_;
+    std::atomic_bool running_;
+    std::atomic_bool stopped_;
+    size_t batchSize_;
+};
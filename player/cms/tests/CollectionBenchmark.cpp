@@ -0,0 +1,199 @@
+#include "FakeXmdsServer.hpp"
+#include "MemoryFileCache.hpp"
+
+#include "cms/RequiredFilesDownloader.hpp"
+#include "cms/xmds/SoapRequestSender.hpp"
+#include "cms/xmds/XmdsRequestSender.hpp"
+
+#include <spdlog/sinks/null_sink.h>
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sys/resource.h>
+
+// Drives the collection sequence of CollectionInterval (RegisterDisplay, RequiredFiles, downloads,
+// MediaInventory, Schedule) against FakeXmdsServer and reports time, traffic, peak RSS and threads.
+//
+// Usage: cms_benchmark [--files=20] [--size=1048576] [--download=http|xmds] [--latency=0] [--rate=0]
+//                      [--error-rate=0] [--stall-after=0] [--stall=0] [--cycles=1]
+// latency and stall are in milliseconds, rate in bytes per second (0 means unlimited)
+
+struct Options
+{
+    size_t files = 20;
+    size_t size = 1024 * 1024;
+    FakeXmdsServer::Download download = FakeXmdsServer::Download::Http;
+    FakeXmdsServer::Faults faults;
+    size_t cycles = 1;
+};
+
+struct CycleResult
+{
+    std::chrono::milliseconds duration{0};
+    size_t downloaded = 0;
+    bool succeeded = true;
+};
+
+static Options parseOptions(int argc, char* argv[])
+{
+    std::map<std::string, std::string> values;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto equals = arg.find('=');
+        if (arg.compare(0, 2, "--") != 0 || equals == std::string::npos)
+            throw std::invalid_argument{"Unexpected argument " + arg};
+
+        values[arg.substr(2, equals - 2)] = arg.substr(equals + 1);
+    }
+
+    auto number = [&values](const std::string& name, auto defaultValue) {
+        auto it = values.find(name);
+        return it != values.end() ? static_cast<decltype(defaultValue)>(std::stod(it->second)) : defaultValue;
+    };
+
+    Options options;
+    options.files = number("files", options.files);
+    options.size = number("size", options.size);
+    options.download = values["download"] == "xmds" ? FakeXmdsServer::Download::Xmds : FakeXmdsServer::Download::Http;
+    options.faults.latency = std::chrono::milliseconds{number("latency", 0)};
+    options.faults.bytesPerSecond = number("rate", uint64_t{0});
+    options.faults.errorRate = number("error-rate", 0.0);
+    options.faults.stallAfterBytes = number("stall-after", size_t{0});
+    options.faults.stallDuration = std::chrono::milliseconds{number("stall", 0)};
+    options.cycles = number("cycles", options.cycles);
+    return options;
+}
+
+static void registerDisplay(const std::string& address)
+{
+    RegisterDisplay::Request request;
+    request.serverKey = "serverKey";
+    request.hardwareKey = "hardwareKey";
+    request.clientType = "linux";
+    request.clientCode = "1";
+    request.clientVersion = "benchmark";
+    request.displayName = "benchmark";
+
+    auto uri = Uri::fromString(address + "/xmds.php?v=5");
+    auto [error, result] = SoapRequestHelper::sendRequest<RegisterDisplay::Result>(
+                               uri, request, RequestCompression::None, RequestRetry::Idempotent)
+                               .get();
+    if (error) throw std::runtime_error{"RegisterDisplay failed: " + error.message()};
+}
+
+static bool allSucceeded(DownloadResults&& results)
+{
+    bool succeeded = true;
+    for (auto&& result : results)
+    {
+        succeeded = result.get() && succeeded;
+    }
+    return succeeded;
+}
+
+static CycleResult collect(const std::string& address, XmdsRequestSender& sender, MemoryFileCache& cache)
+{
+    auto start = std::chrono::steady_clock::now();
+    CycleResult cycle;
+
+    registerDisplay(address);
+
+    auto [filesError, files] = sender.requiredFiles().get();
+    if (filesError) throw std::runtime_error{"RequiredFiles failed: " + filesError.message()};
+
+    auto cachedBefore = cache.size();
+    RequiredFilesDownloader downloader{sender, cache};
+    auto resourcesResult = downloader.download(files.requiredResources());
+    auto filesResult = downloader.download(files.requiredFiles());
+    cycle.succeeded = allSucceeded(resourcesResult.get()) && allSucceeded(filesResult.get());
+    cycle.downloaded = cache.size() - cachedBefore;
+
+    MediaInventoryItems items;
+    for (auto&& file : files.requiredFiles())
+    {
+        items.emplace_back(file, cache.valid(file.name()));
+    }
+    for (auto&& file : files.requiredResources())
+    {
+        items.emplace_back(file, cache.valid(file.name()));
+    }
+    auto [inventoryError, inventory] = sender.mediaInventory(std::move(items)).get();
+    cycle.succeeded = !inventoryError && cycle.succeeded;
+
+    auto [scheduleError, schedule] = sender.schedule().get();
+    cycle.succeeded = !scheduleError && cycle.succeeded;
+
+    cycle.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    return cycle;
+}
+
+static long peakRssKiB()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static int threadCount()
+{
+    std::ifstream status{"/proc/self/status"};
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 8, "Threads:") == 0) return std::stoi(line.substr(8));
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        auto options = parseOptions(argc, argv);
+
+        std::vector<spdlog::sink_ptr> sinks{std::make_shared<spdlog::sinks::null_sink_mt>()};
+        Log::create(sinks);
+
+        FakeXmdsServer server;
+        for (size_t i = 0; i < options.files; ++i)
+        {
+            auto id = static_cast<int>(i + 1);
+            server.addFile(id, std::to_string(id) + ".bin", std::string(options.size, static_cast<char>('a' + i % 26)),
+                           options.download);
+        }
+        server.addResource(1, 1, 1000, "<html></html>");
+        server.setDefaultLayout(1);
+        server.setFaults(options.faults);
+
+        XmdsRequestSender sender{server.address(), "serverKey", "hardwareKey"};
+        MemoryFileCache cache;
+        int peakThreads = threadCount();
+
+        for (size_t i = 0; i < options.cycles; ++i)
+        {
+            auto cycle = collect(server.address(), sender, cache);
+            peakThreads = std::max(peakThreads, threadCount());
+
+            std::cout << "cycle " << i + 1 << ": " << cycle.duration.count() << " ms, " << cycle.downloaded
+                      << " files downloaded" << (cycle.succeeded ? "" : ", with failures") << std::endl;
+        }
+
+        auto stats = HttpClient::instance().transferStats();
+        std::cout << "server sent " << server.bytesSent() << " body bytes" << std::endl;
+        std::cout << "client received " << stats.receivedBytes << " bytes (" << stats.decodedBytes << " decoded), sent "
+                  << stats.sentBytes << " bytes" << std::endl;
+        std::cout << "timeouts " << stats.timeouts << ", retries " << stats.retries << ", hedges " << stats.hedges
+                  << ", connects " << stats.connects << std::endl;
+        std::cout << "peak RSS " << peakRssKiB() << " KiB, peak threads " << peakThreads << std::endl;
+
+        HttpClient::instance().shutdown();
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
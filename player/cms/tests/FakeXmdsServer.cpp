@@ -0,0 +1,414 @@
+#include "FakeXmdsServer.hpp"
+
+#include "common/crypto/CryptoUtils.hpp"
+#include "common/crypto/Md5Hash.hpp"
+#include "common/parsing/XmlWriter.hpp"
+
+#include <boost/asio/write.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/read.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/write.hpp>
+
+#include <fmt/format.h>
+#include <regex>
+#include <thread>
+
+namespace http = boost::beast::http;
+
+const std::string XmdsTarget = "/xmds.php";
+const std::string MediaTarget = "/media/";
+const std::string PeerTarget = "/files/";
+const size_t WriteSliceSize = 16 * 1024;
+
+FakeXmdsServer::FakeXmdsServer() : acceptor_{ioc_, ip::tcp::endpoint{ip::address_v4::loopback(), 0}}
+{
+    acceptThread_ = std::make_unique<JoinableThread>([this]() { accept(); });
+}
+
+FakeXmdsServer::~FakeXmdsServer()
+{
+    stopped_ = true;
+
+    // a blocking accept is not interrupted by close, so wake it up with a last connection
+    boost::system::error_code ignored;
+    ip::tcp::socket wakeUp{ioc_};
+    wakeUp.connect(acceptor_.local_endpoint(), ignored);
+    acceptThread_.reset();
+    acceptor_.close(ignored);
+
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        for (auto&& connection : connections_)
+        {
+            if (auto socket = connection.lock())
+            {
+                socket->shutdown(ip::tcp::socket::shutdown_both, ignored);
+            }
+        }
+    }
+    connectionThreads_.clear();
+}
+
+std::string FakeXmdsServer::address() const
+{
+    return "http://127.0.0.1:" + std::to_string(acceptor_.local_endpoint().port());
+}
+
+void FakeXmdsServer::setFaults(const Faults& faults)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    faults_ = faults;
+}
+
+void FakeXmdsServer::failRequests(size_t count)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    failedRequests_ = count;
+}
+
+void FakeXmdsServer::addFile(int id, const std::string& name, std::string content, Download download)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    auto md5 = static_cast<std::string>(Md5Hash::fromString(content));
+    files_.push_back(File{id, name, std::move(content), std::move(md5), download});
+}
+
+void FakeXmdsServer::addPeerFile(const std::string& md5, std::string content)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    peerFiles_[md5] = std::move(content);
+}
+
+void FakeXmdsServer::addResource(int layoutId, int regionId, int mediaId, std::string content)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    resources_.push_back(Resource{layoutId, regionId, mediaId, std::move(content)});
+}
+
+void FakeXmdsServer::setDefaultLayout(int layoutId)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    defaultLayout_ = layoutId;
+}
+
+void FakeXmdsServer::setResponse(const std::string& method, std::string responseContent)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    responses_[method] = std::move(responseContent);
+}
+
+size_t FakeXmdsServer::requestCount(const std::string& method) const
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    auto it = requestCounts_.find(method);
+    return it != requestCounts_.end() ? it->second : 0;
+}
+
+uint64_t FakeXmdsServer::bytesSent() const
+{
+    return bytesSent_;
+}
+
+std::string FakeXmdsServer::soapResponse(const std::string& method, const std::string& content)
+{
+    return R"(<?xml version="1.0" encoding="UTF-8"?>)"
+           R"(<SOAP-ENV:Envelope xmlns:SOAP-ENV="http://schemas.xmlsoap.org/soap/envelope/" xmlns:ns1="urn:xmds">)"
+           "<SOAP-ENV:Body><ns1:" +
+           method + "Response>" + content + "</ns1:" + method + "Response></SOAP-ENV:Body></SOAP-ENV:Envelope>";
+}
+
+void FakeXmdsServer::accept()
+{
+    while (!stopped_)
+    {
+        auto socket = std::make_shared<ip::tcp::socket>(ioc_);
+
+        boost::system::error_code ec;
+        acceptor_.accept(*socket, ec);
+        if (ec || stopped_) continue;
+
+        std::unique_lock<std::mutex> lock{mutex_};
+        connections_.push_back(socket);
+        connectionThreads_.push_back(std::make_unique<JoinableThread>([this, socket]() { serve(socket); }));
+    }
+}
+
+void FakeXmdsServer::serve(std::shared_ptr<ip::tcp::socket> socket)
+{
+    boost::beast::flat_buffer buffer;
+    while (!stopped_)
+    {
+        http::request<http::string_body> request;
+
+        boost::system::error_code ec;
+        http::read(*socket, buffer, request, ec);
+        if (ec) return;
+
+        auto response = route(std::string{request.target()}, request.body());
+        write(*socket, response, request.keep_alive());
+
+        if (!request.keep_alive()) return;
+    }
+}
+
+FakeXmdsServer::Response FakeXmdsServer::route(const std::string& target, const std::string& body)
+{
+    if (shouldFail()) return Response{503, "text/plain", "Service Unavailable"};
+
+    if (target.compare(0, XmdsTarget.size(), XmdsTarget) == 0) return xmdsResponse(body);
+    if (target.compare(0, MediaTarget.size(), MediaTarget) == 0) return mediaResponse(target);
+    if (target.compare(0, PeerTarget.size(), PeerTarget) == 0) return peerResponse(target);
+
+    return Response{404, "text/plain", "Not Found"};
+}
+
+FakeXmdsServer::Response FakeXmdsServer::xmdsResponse(const std::string& body)
+{
+    static const std::regex MethodPattern{"<tns:(\\w+)>"};
+
+    std::smatch match;
+    if (!std::regex_search(body, match, MethodPattern)) return Response{400, "text/plain", "Bad Request"};
+
+    auto method = match[1].str();
+    std::string content;
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        ++requestCounts_[method];
+
+        auto scripted = responses_.find(method);
+        if (scripted != responses_.end()) return Response{200, "text/xml", soapResponse(method, scripted->second)};
+    }
+
+    if (method == "RegisterDisplay")
+        content = registerDisplayContent();
+    else if (method == "RequiredFiles")
+        content = requiredFilesContent();
+    else if (method == "Schedule")
+        content = scheduleContent();
+    else if (method == "GetFile")
+        content = getFileContent(body);
+    else if (method == "GetResource")
+        content = getResourceContent(body);
+    else
+        content = "<success>true</success>";
+
+    return Response{200, "text/xml", soapResponse(method, content)};
+}
+
+FakeXmdsServer::Response FakeXmdsServer::mediaResponse(const std::string& target)
+{
+    auto name = target.substr(MediaTarget.size());
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    ++requestCounts_["media"];
+    for (auto&& file : files_)
+    {
+        if (file.download == Download::Http && file.name == name)
+            return Response{200, "application/octet-stream", file.content};
+    }
+    return Response{404, "text/plain", "Not Found"};
+}
+
+FakeXmdsServer::Response FakeXmdsServer::peerResponse(const std::string& target)
+{
+    auto md5 = target.substr(PeerTarget.size());
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    ++requestCounts_["peer"];
+
+    auto peerFile = peerFiles_.find(md5);
+    if (peerFile != peerFiles_.end()) return Response{200, "application/octet-stream", peerFile->second};
+    for (auto&& file : files_)
+    {
+        if (file.md5 == md5) return Response{200, "application/octet-stream", file.content};
+    }
+    return Response{404, "text/plain", "Not Found"};
+}
+
+// The body goes out in slices so that bandwidth limits and stalls apply in the middle of a response
+void FakeXmdsServer::write(ip::tcp::socket& socket, const Response& response, bool keepAlive)
+{
+    Faults faults;
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        faults = faults_;
+    }
+
+    std::this_thread::sleep_for(faults.latency);
+
+    http::response<http::empty_body> header{static_cast<http::status>(response.status), 11};
+    header.set(http::field::content_type, response.contentType);
+    header.content_length(response.body.size());
+    header.keep_alive(keepAlive);
+
+    boost::system::error_code ec;
+    http::response_serializer<http::empty_body> serializer{header};
+    http::write_header(socket, serializer, ec);
+    if (ec) return;
+
+    size_t sent = 0;
+    bool stalled = false;
+    while (sent < response.body.size() && !stopped_)
+    {
+        auto slice = std::min(WriteSliceSize, response.body.size() - sent);
+        if (faults.stallAfterBytes != 0 && !stalled && sent + slice > faults.stallAfterBytes)
+        {
+            stalled = true;
+            std::this_thread::sleep_for(faults.stallDuration);
+        }
+
+        boost::asio::write(socket, boost::asio::buffer(response.body.data() + sent, slice), ec);
+        if (ec) return;
+
+        sent += slice;
+        bytesSent_ += slice;
+        if (faults.bytesPerSecond != 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds{slice * 1000000 / faults.bytesPerSecond});
+        }
+    }
+}
+
+bool FakeXmdsServer::shouldFail()
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    if (failedRequests_ > 0)
+    {
+        --failedRequests_;
+        return true;
+    }
+    return std::uniform_real_distribution<double>{0, 1}(random_) < faults_.errorRate;
+}
+
+std::string FakeXmdsServer::registerDisplayContent() const
+{
+    XmlWriter display;
+    display.startElement("display")
+        .attribute("status", 0)
+        .attribute("code", "READY")
+        .attribute("message", "Display is active and ready to start.")
+        .attribute("checkRf", "")
+        .attribute("checkSchedule", "");
+
+    auto setting = [&display](std::string_view name, std::string_view value) {
+        display.startElement(name).text(value).endElement();
+    };
+    setting("collectInterval", "900");
+    setting("statsEnabled", "0");
+    setting("xmrNetworkAddress", "");
+    setting("sizeX", "1920");
+    setting("sizeY", "1080");
+    setting("offsetX", "0");
+    setting("offsetY", "0");
+    setting("logLevel", "error");
+    setting("screenShotRequestInterval", "0");
+    setting("embeddedServerPort", "9696");
+    setting("preventSleep", "0");
+    setting("displayName", "Fake Display");
+    display.endElement();
+
+    return "<ActivationMessage>" + escaped(display.string()) + "</ActivationMessage>";
+}
+
+std::string FakeXmdsServer::requiredFilesContent() const
+{
+    XmlWriter files;
+    std::unique_lock<std::mutex> lock{mutex_};
+    files.startElement("files");
+    addGeneratedAttributes(files, requestCounts_.at("RequiredFiles"));
+    for (auto&& file : files_)
+    {
+        bool http = file.download == Download::Http;
+        files.startElement("file")
+            .attribute("type", "media")
+            .attribute("id", file.id)
+            .attribute("size", file.content.size())
+            .attribute("md5", file.md5)
+            .attribute("download", http ? "http" : "xmds")
+            .attribute("path", http ? address() + MediaTarget + file.name : file.name)
+            .attribute("saveAs", file.name)
+            .endElement();
+    }
+    for (auto&& resource : resources_)
+    {
+        files.startElement("file")
+            .attribute("type", "resource")
+            .attribute("layoutid", resource.layoutId)
+            .attribute("regionid", resource.regionId)
+            .attribute("mediaid", resource.mediaId)
+            .attribute("updated", 0)
+            .endElement();
+    }
+    files.endElement();
+
+    return "<RequiredFilesXml>" + escaped(files.string()) + "</RequiredFilesXml>";
+}
+
+std::string FakeXmdsServer::scheduleContent() const
+{
+    XmlWriter schedule;
+    std::unique_lock<std::mutex> lock{mutex_};
+    schedule.startElement("schedule");
+    addGeneratedAttributes(schedule, requestCounts_.at("Schedule"));
+    schedule.startElement("default").attribute("file", defaultLayout_).endElement();
+    schedule.endElement();
+
+    return "<ScheduleXml>" + escaped(schedule.string()) + "</ScheduleXml>";
+}
+
+// The CMS stamps every response with the time it was generated and the range it was filtered by
+void FakeXmdsServer::addGeneratedAttributes(XmlWriter& writer, size_t responseNumber)
+{
+    auto seconds = responseNumber % 60;
+    writer.attribute("generated", fmt::format("2020-01-01 00:00:{:02}", seconds))
+        .attribute("filterFrom", fmt::format("2020-01-01 00:00:{:02}", seconds))
+        .attribute("filterTo", fmt::format("2020-01-02 00:00:{:02}", seconds));
+}
+
+std::string FakeXmdsServer::getFileContent(const std::string& request) const
+{
+    auto id = std::stoi(field(request, "fileId"));
+    auto offset = std::stoull(field(request, "chunkOffset"));
+    auto size = std::stoull(field(request, "chuckSize"));  // field name as sent by GetFile::Request
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    for (auto&& file : files_)
+    {
+        if (file.id == id && offset <= file.content.size())
+            return "<file>" + CryptoUtils::toBase64(file.content.substr(offset, size)) + "</file>";
+    }
+    return "<file></file>";
+}
+
+std::string FakeXmdsServer::getResourceContent(const std::string& request) const
+{
+    auto mediaId = std::stoi(field(request, "mediaId"));
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    for (auto&& resource : resources_)
+    {
+        if (resource.mediaId == mediaId) return "<resource>" + escaped(resource.content) + "</resource>";
+    }
+    return "<resource></resource>";
+}
+
+std::string FakeXmdsServer::field(const std::string& request, const std::string& name)
+{
+    auto start = request.find("<" + name);
+    if (start == std::string::npos) return {};
+
+    start = request.find('>', start) + 1;
+    return request.substr(start, request.find("</" + name, start) - start);
+}
+
+std::string FakeXmdsServer::escaped(const std::string& xml)
+{
+    std::string result;
+    XmlWriter::escape(result, xml);
+    return result;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "common/JoinableThread.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ip = boost::asio::ip;
+
+class XmlWriter;
+
+// In-process stand-in for the CMS. Serves scripted XMDS responses on /xmds.php and media files over
+// plain HTTP on a loopback port. Faults are applied to every response so networking changes can be
+// evaluated against slow, lossy or failing servers without a live CMS.
+class FakeXmdsServer
+{
+public:
+    struct Faults
+    {
+        std::chrono::milliseconds latency{0};  // before the response header
+        uint64_t bytesPerSecond = 0;           // 0 means unlimited
+        size_t stallAfterBytes = 0;            // 0 disables stalls
+        std::chrono::milliseconds stallDuration{0};
+        double errorRate = 0;  // share of responses replaced with 503
+    };
+
+    enum class Download
+    {
+        Http,
+        Xmds
+    };
+
+    FakeXmdsServer();
+    ~FakeXmdsServer();
+
+    std::string address() const;
+
+    void setFaults(const Faults& faults);
+    // the next count responses are 503 regardless of the error rate
+    void failRequests(size_t count);
+
+    // Files are listed in RequiredFiles and served either at /media/<name> or through GetFile
+    void addFile(int id, const std::string& name, std::string content, Download download);
+    void addResource(int layoutId, int regionId, int mediaId, std::string content);
+    // Files are also served at /files/<md5> like a LAN peer does. A peer file replaces the content sent
+    // there for the given hash, which doesn't have to match it.
+    void addPeerFile(const std::string& md5, std::string content);
+    void setDefaultLayout(int layoutId);
+    // replaces the generated response for the given XMDS method, e.g. "NotifyStatus"
+    void setResponse(const std::string& method, std::string responseContent);
+
+    size_t requestCount(const std::string& method) const;
+    uint64_t bytesSent() const;
+
+    static std::string soapResponse(const std::string& method, const std::string& content);
+
+private:
+    struct File
+    {
+        int id;
+        std::string name;
+        std::string content;
+        std::string md5;
+        Download download;
+    };
+
+    struct Resource
+    {
+        int layoutId;
+        int regionId;
+        int mediaId;
+        std::string content;
+    };
+
+    struct Response
+    {
+        unsigned int status = 200;
+        std::string contentType = "text/xml; charset=utf-8";
+        std::string body;
+    };
+
+    void accept();
+    void serve(std::shared_ptr<ip::tcp::socket> socket);
+    Response route(const std::string& target, const std::string& body);
+    Response xmdsResponse(const std::string& body);
+    Response mediaResponse(const std::string& target);
+    Response peerResponse(const std::string& target);
+    void write(ip::tcp::socket& socket, const Response& response, bool keepAlive);
+    bool shouldFail();
+
+    std::string registerDisplayContent() const;
+    std::string requiredFilesContent() const;
+    std::string scheduleContent() const;
+    std::string getFileContent(const std::string& request) const;
+    std::string getResourceContent(const std::string& request) const;
+
+    static void addGeneratedAttributes(XmlWriter& writer, size_t responseNumber);
+    static std::string field(const std::string& request, const std::string& name);
+    static std::string escaped(const std::string& xml);
+
+private:
+    boost::asio::io_context ioc_;
+    ip::tcp::acceptor acceptor_;
+    std::unique_ptr<JoinableThread> acceptThread_;
+    std::vector<std::unique_ptr<JoinableThread>> connectionThreads_;
+    std::vector<std::weak_ptr<ip::tcp::socket>> connections_;
+    std::atomic<bool> stopped_ = false;
+
+    mutable std::mutex mutex_;
+    Faults faults_;
+    size_t failedRequests_ = 0;
+    std::mt19937 random_{42};
+    std::vector<File> files_;
+    std::vector<Resource> resources_;
+    std::map<std::string, std::string> peerFiles_;
+    int defaultLayout_ = 0;
+    std::map<std::string, std::string> responses_;
+    std::map<std::string, size_t> requestCounts_;
+    std::atomic<uint64_t> bytesSent_ = 0;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "common/storage/FileCache.hpp"
+
+#include <map>
+#include <mutex>
+
+// FileCache which keeps downloaded content in memory so tests and the benchmark don't touch the disk
+class MemoryFileCache : public FileCache
+{
+public:
+    void loadFrom(const FilePath&) override {}
+
+    bool valid(const std::string& filename) const override
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        return files_.count(filename) > 0;
+    }
+
+    bool cached(const RegularFile& file) const override
+    {
+        return cached(file.name(), file.hash());
+    }
+
+    bool cached(const ResourceFile& file) const override
+    {
+        return valid(file.name());
+    }
+
+    bool cached(const std::string& filename, const Md5Hash& hash) const override
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        auto it = files_.find(filename);
+        return it != files_.end() && Md5Hash::fromString(it->second) == hash;
+    }
+
+    std::vector<std::string> cachedFiles() const override
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        std::vector<std::string> names;
+        for (auto&& [name, content] : files_)
+        {
+            names.push_back(name);
+        }
+        return names;
+    }
+
+    boost::optional<std::string> cachedFile(const Md5Hash& hash) const override
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        for (auto&& [name, content] : files_)
+        {
+            if (Md5Hash::fromString(content) == hash) return name;
+        }
+        return {};
+    }
+
+    std::vector<std::string> invalidFiles() const override
+    {
+        return {};
+    }
+
+    void markAsInvalid(const std::string& filename) override
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        files_.erase(filename);
+    }
+
+    void save(const std::string& filename, const std::string& content, const Md5Hash&) override
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            files_[filename] = content;
+        }
+        fileSaved_(filename);
+    }
+
+    void save(const std::string& filename, const std::string& content, const DateTime&) override
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            files_[filename] = content;
+        }
+        fileSaved_(filename);
+    }
+
+    SignalFileSaved& fileSaved() override
+    {
+        return fileSaved_;
+    }
+
+    std::string content(const std::string& filename) const
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        auto it = files_.find(filename);
+        return it != files_.end() ? it->second : std::string{};
+    }
+
+    size_t size() const
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        return files_.size();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::string> files_;
+    SignalFileSaved fileSaved_;
+};
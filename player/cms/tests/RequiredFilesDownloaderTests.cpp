@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include "FakeXmdsServer.hpp"
+#include "MemoryFileCache.hpp"
+
+#include "cms/RequiredFilesDownloader.hpp"
+#include "cms/xmds/XmdsRequestSender.hpp"
+#include "networking/PeerDiscovery.hpp"
+
+const size_t LargeFileSize = 1024 * 1024 + 17;  // spans several GetFile chunks
+
+static RequiredFiles::Result requiredFiles(XmdsRequestSender& sender)
+{
+    auto [error, result] = sender.requiredFiles().get();
+    EXPECT_FALSE(error);
+    return result;
+}
+
+static size_t downloadAll(XmdsRequestSender& sender, MemoryFileCache& cache, PeerDiscovery* peers = nullptr)
+{
+    RequiredFilesDownloader downloader{sender, cache, peers};
+    auto files = requiredFiles(sender);
+
+    auto results = downloader.download(files.requiredFiles()).get();
+    auto resources = downloader.download(files.requiredResources()).get();
+
+    size_t downloaded = 0;
+    for (auto&& result : results)
+    {
+        downloaded += result.get();
+    }
+    for (auto&& result : resources)
+    {
+        downloaded += result.get();
+    }
+    return downloaded;
+}
+
+TEST(RequiredFilesDownloader, DownloadsHttpXmdsAndResources)
+{
+    FakeXmdsServer server;
+    std::string large(LargeFileSize, 'v');
+    server.addFile(1, "video.mp4", large, FakeXmdsServer::Download::Xmds);
+    server.addFile(2, "image.png", "png", FakeXmdsServer::Download::Http);
+    server.addResource(1, 2, 3, "<html>&</html>");
+    XmdsRequestSender sender{server.address(), "serverKey", "hardwareKey"};
+    MemoryFileCache cache;
+
+    ASSERT_EQ(downloadAll(sender, cache), 3);
+
+    EXPECT_EQ(cache.content("video.mp4"), large);
+    EXPECT_EQ(cache.content("image.png"), "png");
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_EQ(server.requestCount("GetFile"), 3);
+    EXPECT_EQ(server.requestCount("GetResource"), 1);
+}
+
+TEST(RequiredFilesDownloader, CachedFilesSkipped)
+{
+    FakeXmdsServer server;
+    server.addFile(1, "video.mp4", "mp4", FakeXmdsServer::Download::Xmds);
+    server.addFile(2, "image.png", "png", FakeXmdsServer::Download::Http);
+    XmdsRequestSender sender{server.address(), "serverKey", "hardwareKey"};
+    MemoryFileCache cache;
+
+    ASSERT_EQ(downloadAll(sender, cache), 2);
+    ASSERT_EQ(downloadAll(sender, cache), 0);
+
+    EXPECT_EQ(server.requestCount("GetFile"), 1);
+    EXPECT_EQ(server.requestCount("media"), 1);
+}
+
+TEST(RequiredFilesDownloader, ServerErrorsRecovered)
+{
+    FakeXmdsServer server;
+    server.addFile(2, "image.png", "png", FakeXmdsServer::Download::Http);
+    XmdsRequestSender sender{server.address(), "serverKey", "hardwareKey"};
+    MemoryFileCache cache;
+    RequiredFilesDownloader downloader{sender, cache};
+    auto files = requiredFiles(sender);
+
+    server.failRequests(1);
+    auto results = downloader.download(files.requiredFiles()).get();
+
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_TRUE(results[0].get());
+    EXPECT_EQ(cache.content("image.png"), "png");
+}
+
+static std::string hostAndPort(const FakeXmdsServer& server)
+{
+    return server.address().substr(std::string{"http://"}.size());
+}
+
+TEST(RequiredFilesDownloader, PeersAskedBeforeCms)
+{
+    FakeXmdsServer server;
+    FakeXmdsServer peer;
+    std::string large(LargeFileSize, 'v');
+    for (auto&& target : {&server, &peer})
+    {
+        target->addFile(1, "video.mp4", large, FakeXmdsServer::Download::Xmds);
+        target->addFile(2, "image.png", "png", FakeXmdsServer::Download::Http);
+    }
+    PeerDiscovery discovery{0};
+    discovery.addStaticPeers(hostAndPort(peer));
+    XmdsRequestSender sender{server.address(), "serverKey", "hardwareKey"};
+    MemoryFileCache cache;
+
+    ASSERT_EQ(downloadAll(sender, cache, &discovery), 2);
+
+    EXPECT_EQ(cache.content("video.mp4"), large);
+    EXPECT_EQ(cache.content("image.png"), "png");
+    EXPECT_EQ(peer.requestCount("peer"), 2);
+    EXPECT_EQ(server.requestCount("GetFile"), 0);
+    EXPECT_EQ(server.requestCount("media"), 0);
+}
+
+TEST(RequiredFilesDownloader, CmsUsedWhenPeersFail)
+{
+    FakeXmdsServer server;
+    server.addFile(1, "video.mp4", "mp4", FakeXmdsServer::Download::Xmds);
+    server.addFile(2, "image.png", "png", FakeXmdsServer::Download::Http);
+    FakeXmdsServer corruptPeer;
+    corruptPeer.addPeerFile(static_cast<std::string>(Md5Hash::fromString("mp4")), "corrupted");
+    FakeXmdsServer emptyPeer;
+    PeerDiscovery discovery{0};
+    discovery.addStaticPeers(hostAndPort(corruptPeer) + ", " + hostAndPort(emptyPeer));
+    XmdsRequestSender sender{server.address(), "serverKey", "hardwareKey"};
+    MemoryFileCache cache;
+
+    ASSERT_EQ(downloadAll(sender, cache, &discovery), 2);
+
+    EXPECT_EQ(cache.content("video.mp4"), "mp4");
+    EXPECT_EQ(cache.content("image.png"), "png");
+    EXPECT_EQ(corruptPeer.requestCount("peer"), 2);
+    EXPECT_EQ(emptyPeer.requestCount("peer"), 2);
+    EXPECT_EQ(server.requestCount("GetFile"), 1);
+    EXPECT_EQ(server.requestCount("media"), 1);
+}
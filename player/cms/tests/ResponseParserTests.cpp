@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "FakeXmdsServer.hpp"
+
+#include "cms/xmds/RequiredFiles.hpp"
+
+static ResponseResult<RequiredFiles::Result> parseRequiredFiles(const std::string& response)
+{
+    return Soap::ResponseParser<RequiredFiles::Result>{response}.get();
+}
+
+static std::string requiredFilesResponse(const std::string& escapedFiles)
+{
+    return FakeXmdsServer::soapResponse("RequiredFiles", "<RequiredFilesXml>" + escapedFiles + "</RequiredFilesXml>");
+}
+
+TEST(StreamResponseParser, RequiredFiles)
+{
+    auto response = requiredFilesResponse(
+        "&lt;?xml version=\"1.0\"?&gt;"
+        "&lt;files&gt;"
+        "&lt;file type=\"layout\" id=\"1\" size=\"10\" md5=\"aa\" download=\"xmds\" path=\"1\"/&gt;"
+        "&lt;file type=\"media\" id=\"2\" size=\"20\" md5=\"bb\" download=\"http\" path=\"http://cms/a&amp;amp;b\" "
+        "saveAs=\"a&amp;amp;b.png\"&gt;&lt;unknown/&gt;&lt;/file&gt;"
+        "&lt;file type=\"blacklist\" id=\"3\"/&gt;"
+        "&lt;file type=\"resource\" layoutid=\"1\" regionid=\"2\" mediaid=\"3\" updated=\"0\"/&gt;"
+        "&lt;/files&gt;");
+
+    auto [error, result] = parseRequiredFiles(response);
+
+    ASSERT_FALSE(error) << error.message();
+    ASSERT_EQ(result.requiredFiles().size(), 2);
+    EXPECT_EQ(result.requiredFiles()[0].name(), "1.xlf");
+    EXPECT_EQ(result.requiredFiles()[0].size(), 10);
+    EXPECT_EQ(result.requiredFiles()[1].url(), "http://cms/a&b");
+    EXPECT_EQ(result.requiredFiles()[1].name(), "a&b.png");
+    ASSERT_EQ(result.requiredResources().size(), 1);
+    EXPECT_EQ(result.requiredResources()[0].regionId(), 2);
+}
+
+TEST(StreamResponseParser, EmptyFiles)
+{
+    auto [error, result] = parseRequiredFiles(requiredFilesResponse("&lt;files/&gt;"));
+
+    ASSERT_FALSE(error) << error.message();
+    EXPECT_TRUE(result.requiredFiles().empty());
+    EXPECT_TRUE(result.requiredResources().empty());
+}
+
+TEST(StreamResponseParser, Fault)
+{
+    auto response = R"(<SOAP-ENV:Envelope xmlns:SOAP-ENV="http://schemas.xmlsoap.org/soap/envelope/">)"
+                    "<SOAP-ENV:Body><SOAP-ENV:Fault><faultcode>Sender</faultcode>"
+                    "<faultstring>Display not &lt;licensed&gt;</faultstring></SOAP-ENV:Fault>"
+                    "</SOAP-ENV:Body></SOAP-ENV:Envelope>";
+
+    auto [error, result] = parseRequiredFiles(response);
+
+    ASSERT_TRUE(error);
+    EXPECT_EQ(error.message(), "Display not <licensed>");
+}
+
+TEST(StreamResponseParser, MalformedEnvelope)
+{
+    EXPECT_TRUE(parseRequiredFiles("").first);
+    EXPECT_TRUE(parseRequiredFiles("<html>Service unavailable</html>").first);
+    EXPECT_TRUE(parseRequiredFiles("<SOAP-ENV:Envelope><SOAP-ENV:Body>").first);
+    EXPECT_TRUE(parseRequiredFiles("<SOAP-ENV:Envelope><SOAP-ENV:Header/></SOAP-ENV:Envelope>").first);
+}
+
+TEST(StreamResponseParser, MalformedBody)
+{
+    EXPECT_TRUE(parseRequiredFiles(FakeXmdsServer::soapResponse("RequiredFiles", "")).first);
+    EXPECT_TRUE(parseRequiredFiles(requiredFilesResponse("&lt;layouts/&gt;")).first);
+    EXPECT_TRUE(parseRequiredFiles(requiredFilesResponse("&lt;files&gt;&lt;file type=\"media\"/&gt;")).first);
+    EXPECT_TRUE(parseRequiredFiles(requiredFilesResponse("&lt;files&gt;&lt;file type=\"media\" id=\"x\" size=\"1\" "
+                                                         "md5=\"a\" download=\"xmds\" path=\"1\"/&gt;&lt;/files&gt;"))
+                    .first);
+}
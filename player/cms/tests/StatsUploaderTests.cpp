@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "FakeXmdsServer.hpp"
+
+#include "cms/StatsUploader.hpp"
+#include "cms/xmds/XmdsRequestSender.hpp"
+#include "stat/Recorder.hpp"
+
+#include <algorithm>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Keeps records in memory in id order like the database does
+    class MemoryDataProvider : public Stats::DataProvider
+    {
+    public:
+        void save(const Stats::RecordDto& record) override
+        {
+            records_.push_back(record);
+            records_.back().id = ++lastId_;
+        }
+
+        void save(Stats::PlayingRecordDtoCollection&& records) override
+        {
+            for (auto&& record : records)
+            {
+                save(record);
+            }
+        }
+
+        Stats::PlayingRecordDtoCollection retrieve(int afterId, size_t count) const override
+        {
+            Stats::PlayingRecordDtoCollection page;
+            for (auto&& record : records_)
+            {
+                if (record.id > afterId && page.size() < count) page.push_back(record);
+            }
+            return page;
+        }
+
+        void removeAll() override
+        {
+            records_.clear();
+        }
+
+        void remove(int fromId, int toId) override
+        {
+            records_.erase(std::remove_if(records_.begin(),
+                                          records_.end(),
+                                          [=](const auto& record) { return record.id >= fromId && record.id <= toId; }),
+                           records_.end());
+        }
+
+        size_t recordsCount() const override
+        {
+            return records_.size();
+        }
+
+    private:
+        Stats::PlayingRecordDtoCollection records_;
+        int lastId_ = 0;
+    };
+
+    Stats::RecordDto layoutRecord()
+    {
+        auto now = DateTime::now();
+        return Stats::RecordDto{Stats::InvalidId, Stats::RecordType::Layout, now, now, 1, 2, {}, 0, 1};
+    }
+
+    // type no record can be created from, e.g. written by a newer player version
+    Stats::RecordDto unreadableRecord()
+    {
+        auto record = layoutRecord();
+        record.type = static_cast<Stats::RecordType>(-1);
+        return record;
+    }
+
+    void uploadAndWait(StatsUploader& uploader)
+    {
+        uploader.upload();
+        while (uploader.running())
+        {
+            std::this_thread::sleep_for(10ms);
+        }
+    }
+}
+
+TEST(StatsUploader, QueueDrainedInBatches)
+{
+    FakeXmdsServer server;
+    XmdsRequestSender sender{server.address(), "serverKey", "hardwareKey"};
+    auto provider = std::make_unique<MemoryDataProvider>();
+    for (int i = 0; i != 500; ++i)
+    {
+        provider->save(layoutRecord());
+    }
+    Stats::Recorder recorder{std::move(provider)};
+    StatsUploader uploader{sender, recorder};
+
+    uploadAndWait(uploader);
+
+    EXPECT_EQ(recorder.recordsCount(), 0);
+    EXPECT_EQ(server.requestCount("SubmitStats"), 2);
+}
+
+TEST(StatsUploader, RecordsKeptWhenNotAcknowledged)
+{
+    FakeXmdsServer server;
+    server.setResponse("SubmitStats", "<success>false</success>");
+    XmdsRequestSender sender{server.address(), "serverKey", "hardwareKey"};
+    auto provider = std::make_unique<MemoryDataProvider>();
+    provider->save(layoutRecord());
+    Stats::Recorder recorder{std::move(provider)};
+    StatsUploader uploader{sender, recorder};
+
+    uploadAndWait(uploader);
+
+    EXPECT_EQ(recorder.recordsCount(), 1);
+    EXPECT_EQ(server.requestCount("SubmitStats"), 1);
+}
+
+TEST(StatsUploader, UnreadablePageSkipped)
+{
+    FakeXmdsServer server;
+    XmdsRequestSender sender{server.address(), "serverKey", "hardwareKey"};
+    auto provider = std::make_unique<MemoryDataProvider>();
+    for (int i = 0; i != 400; ++i)
+    {
+        provider->save(unreadableRecord());
+    }
+    for (int i = 0; i != 10; ++i)
+    {
+        provider->save(layoutRecord());
+    }
+    Stats::Recorder recorder{std::move(provider)};
+    StatsUploader uploader{sender, recorder};
+
+    uploadAndWait(uploader);
+
+    EXPECT_EQ(recorder.recordsCount(), 0);
+    EXPECT_EQ(server.requestCount("SubmitStats"), 1);
+}
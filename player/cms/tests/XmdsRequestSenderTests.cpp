@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include "FakeXmdsServer.hpp"
+
+#include "cms/xmds/XmdsRequestSender.hpp"
+#include "common/crypto/CryptoUtils.hpp"
+
+using namespace std::chrono_literals;
+
+const std::string ServerKey = "serverKey";
+const std::string HardwareKey = "hardwareKey";
+
+TEST(XmdsRequestSender, RequiredFiles)
+{
+    FakeXmdsServer server;
+    server.addFile(1, "1.xlf", "<layout/>", FakeXmdsServer::Download::Xmds);
+    server.addFile(2, "image.png", std::string(1000, 'x'), FakeXmdsServer::Download::Http);
+    server.addResource(1, 2, 3, "<html/>");
+    XmdsRequestSender sender{server.address(), ServerKey, HardwareKey};
+
+    auto [error, result] = sender.requiredFiles().get();
+
+    ASSERT_FALSE(error);
+    ASSERT_EQ(result.requiredFiles().size(), 2);
+    EXPECT_EQ(result.requiredFiles()[0].downloadType(), RegularFile::DownloadType::XMDS);
+    EXPECT_EQ(result.requiredFiles()[1].downloadType(), RegularFile::DownloadType::HTTP);
+    EXPECT_EQ(result.requiredFiles()[1].size(), 1000);
+    EXPECT_EQ(result.requiredFiles()[1].url(), server.address() + "/media/image.png");
+    ASSERT_EQ(result.requiredResources().size(), 1);
+    EXPECT_EQ(result.requiredResources()[0].mediaId(), 3);
+}
+
+TEST(XmdsRequestSender, Schedule)
+{
+    FakeXmdsServer server;
+    server.setDefaultLayout(7);
+    XmdsRequestSender sender{server.address(), ServerKey, HardwareKey};
+
+    auto [error, result] = sender.schedule().get();
+
+    ASSERT_FALSE(error);
+    EXPECT_EQ(result.schedule.defaultLayout.id, 7);
+}
+
+TEST(XmdsRequestSender, GetFileChunk)
+{
+    FakeXmdsServer server;
+    server.addFile(5, "video.mp4", "0123456789", FakeXmdsServer::Download::Xmds);
+    XmdsRequestSender sender{server.address(), ServerKey, HardwareKey};
+
+    auto [error, result] = sender.getFile(5, "media", 2, 4).get();
+
+    ASSERT_FALSE(error);
+    EXPECT_EQ(CryptoUtils::fromBase64(result.base64chunk), "2345");
+}
+
+TEST(XmdsRequestSender, ScriptedResponse)
+{
+    FakeXmdsServer server;
+    server.setResponse("NotifyStatus", "<success>false</success>");
+    XmdsRequestSender sender{server.address(), ServerKey, HardwareKey};
+
+    auto [error, result] = sender.notifyStatus("{}").get();
+
+    ASSERT_FALSE(error);
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(server.requestCount("NotifyStatus"), 1);
+}
+
+TEST(XmdsRequestSender, RetriedAfterServerErrors)
+{
+    FakeXmdsServer server;
+    server.failRequests(2);
+    XmdsRequestSender sender{server.address(), ServerKey, HardwareKey};
+
+    auto [error, result] = sender.requiredFiles().get();
+
+    ASSERT_FALSE(error);
+    EXPECT_EQ(server.requestCount("RequiredFiles"), 1);
+}
+
+TEST(XmdsRequestSender, StalledResponseTimesOut)
+{
+    FakeXmdsServer server;
+    server.addFile(5, "video.mp4", std::string(256 * 1024, 'x'), FakeXmdsServer::Download::Xmds);
+    server.setFaults(FakeXmdsServer::Faults{0ms, 0, 64 * 1024, 1s, 0});
+    XmdsRequestSender sender{server.address(), ServerKey, HardwareKey};
+
+    HttpTimeouts timeouts;
+    timeouts.idle = 300ms;
+    HttpRetryPolicy retry;
+    retry.maxAttempts = 1;
+    HttpClient::instance().setTimeouts(timeouts);
+    HttpClient::instance().setRetryPolicy(retry);
+
+    auto [error, result] = sender.getFile(5, "media", 0, 256 * 1024).get();
+
+    HttpClient::instance().setTimeouts(HttpTimeouts{});
+    HttpClient::instance().setRetryPolicy(HttpRetryPolicy{});
+
+    EXPECT_TRUE(error);
+}
+
+TEST(XmdsRequestSender, RequiredFilesFingerprintIgnoresGenerationTime)
+{
+    FakeXmdsServer server;
+    server.addFile(1, "1.xlf", "<layout/>", FakeXmdsServer::Download::Xmds);
+    server.addFile(2, "image.png", "png", FakeXmdsServer::Download::Http);
+    server.addResource(1, 2, 3, "<html/>");
+    XmdsRequestSender sender{server.address(), ServerKey, HardwareKey};
+
+    auto first = sender.requiredFiles().get().second.fingerprint();
+    auto second = sender.requiredFiles().get().second.fingerprint();
+    server.addFile(3, "video.mp4", "mp4", FakeXmdsServer::Download::Http);
+    auto changed = sender.requiredFiles().get().second.fingerprint();
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(second, changed);
+}
+
+TEST(XmdsRequestSender, ScheduleFingerprintIgnoresGenerationTime)
+{
+    FakeXmdsServer server;
+    server.setDefaultLayout(7);
+    XmdsRequestSender sender{server.address(), ServerKey, HardwareKey};
+
+    auto [error, first] = sender.schedule().get();
+    auto second = sender.schedule().get().second;
+    server.setDefaultLayout(8);
+    auto changed = sender.schedule().get().second;
+
+    ASSERT_FALSE(error);
+    EXPECT_NE(first.schedule.generatedTime, second.schedule.generatedTime);
+    EXPECT_EQ(first.fingerprint, second.fingerprint);
+    EXPECT_NE(second.fingerprint, changed.fingerprint);
+}
@@ -1,10 +1,18 @@
 #pragma once
 
-#include <sstream>
+#include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 
 namespace Soap
 {
+    const std::string_view EnvelopeStart =
+        R"(<soap:Envelope xmlns:soap="http://schemas.xmlsoap.org/soap/envelope/" xmlns:soapenc="http://schemas.xmlsoap.org/soap/encoding/" xmlns:tns="urn:xmds" xmlns:types="urn:xmds/encodedTypes" xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance" xmlns:xsd="http://www.w3.org/2001/XMLSchema">)"
+        R"(<soap:Body soap:encodingStyle="http://schemas.xmlsoap.org/soap/encoding/">)";
+    const std::string_view EnvelopeEnd = "</soap:Body></soap:Envelope>";
+    const size_t FieldMarkupSize = 64;
+
     template <typename Request>
     class BaseRequestSerializer
     {
@@ -12,22 +20,14 @@ namespace Soap
         BaseRequestSerializer(const Request& request) : m_request(request) {}
 
     protected:
+        // The envelope is written straight into the body that is handed over to HttpClient, so large
+        // fields like logs or screenshots are copied once
         template <typename... Args>
-        std::string createRequest(std::string_view requestName, Args... fields)
+        std::string createRequest(std::string_view requestName, const Args&... fields)
         {
-            std::stringstream stream;
-            stream
-                << R"(<soap:Envelope xmlns:soap="http://schemas.xmlsoap.org/soap/envelope/" xmlns:soapenc="http://schemas.xmlsoap.org/soap/encoding/" xmlns:tns="urn:xmds" xmlns:types="urn:xmds/encodedTypes" xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance" xmlns:xsd="http://www.w3.org/2001/XMLSchema">)";
-            stream << R"(<soap:Body soap:encodingStyle="http://schemas.xmlsoap.org/soap/encoding/">)";
-            stream << "<tns:" << requestName << ">";
-            ((stream << "<" << fields.name() << " xsi:type=\"xsd:" << fields.type() << "\">" << fields.value() << "</"
-                     << fields.name() << ">"),
-             ...);
-            stream << "</tns:" << requestName << ">";
-            stream << "</soap:Body>";
-            stream << "</soap:Envelope>";
-
-            return stream.str();
+            // value() of some fields serializes them on the fly, so each one is taken only once
+            return writeRequest(requestName,
+                                std::pair<const Args&, decltype(fields.value())>{fields, fields.value()}...);
         }
 
         const Request& request() const
@@ -35,6 +35,49 @@ namespace Soap
             return m_request;
         }
 
+    private:
+        template <typename... FieldValues>
+        static std::string writeRequest(std::string_view requestName, const FieldValues&... fields)
+        {
+            std::string body;
+            body.reserve(EnvelopeStart.size() + EnvelopeEnd.size() + 2 * requestName.size() +
+                         (sizeHint(fields.first, fields.second) + ... + 0));
+
+            body.append(EnvelopeStart).append("<tns:").append(requestName).append(">");
+            (appendField(body, fields.first, fields.second), ...);
+            body.append("</tns:").append(requestName).append(">").append(EnvelopeEnd);
+
+            return body;
+        }
+
+        template <typename Field, typename Value>
+        static size_t sizeHint(const Field& field, const Value& value)
+        {
+            if constexpr (std::is_same_v<std::decay_t<Value>, std::string>)
+                return value.size() + 2 * field.name().size() + FieldMarkupSize;
+            else
+                return 2 * field.name().size() + FieldMarkupSize;
+        }
+
+        template <typename Field, typename Value>
+        static void appendField(std::string& body, const Field& field, const Value& value)
+        {
+            body.append("<").append(field.name()).append(" xsi:type=\"xsd:").append(field.type()).append("\">");
+            appendValue(body, value);
+            body.append("</").append(field.name()).append(">");
+        }
+
+        static void appendValue(std::string& body, std::string_view value)
+        {
+            body.append(value);
+        }
+
+        template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+        static void appendValue(std::string& body, T value)
+        {
+            body.append(std::to_string(value));
+        }
+
     private:
         const Request& m_request;
     };
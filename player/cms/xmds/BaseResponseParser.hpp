@@ -13,7 +13,8 @@ namespace Soap
     public:
         using OptionalXmlNode = boost::optional<XmlNode&>;
 
-        BaseResponseParser(const std::string& response) : response_(response)
+        // response has to outlive the parser, it is only kept to report unparsable responses
+        BaseResponseParser(std::string_view response) : response_(response)
         {
             tryParseResponse(response);
         }
@@ -23,7 +24,7 @@ namespace Soap
         {
             if (responseTree_)
             {
-                auto [name, bodyNode] = responseTree_->front();
+                auto&& [name, bodyNode] = responseTree_->front();
                 boost::ignore_unused(name);
 
                 if (auto node = getFaultNode())
@@ -57,14 +58,17 @@ namespace Soap
             }
         }
 
-        void tryParseResponse(const std::string& response)
+        void tryParseResponse(std::string_view response)
         {
             try
             {
-                responseTree_ = Parsing::xmlFrom(response).get_child("SOAP-ENV:Envelope").get_child("SOAP-ENV:Body");
+                auto tree = Parsing::xmlFrom(response);
+                responseTree_.emplace();
+                responseTree_->swap(tree.get_child("SOAP-ENV:Envelope").get_child("SOAP-ENV:Body"));
             }
             catch (std::exception&)
             {
+                responseTree_.reset();
             }
         }
 
@@ -80,7 +84,7 @@ namespace Soap
         }
 
     private:
-        std::string response_;
+        std::string_view response_;
         boost::optional<XmlNode> responseTree_;
     };
 
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "common/parsing/XmlReader.hpp"
+#include "networking/ResponseResult.hpp"
+
+namespace Soap
+{
+    // Counterpart of BaseResponseParser for large responses: the envelope is read with XmlReader
+    // and parseBody receives the reader positioned at the response element instead of a tree.
+    template <typename Result>
+    class BaseStreamResponseParser
+    {
+    public:
+        // response has to outlive the parser
+        BaseStreamResponseParser(std::string_view response) : response_(response) {}
+        virtual ~BaseStreamResponseParser() = default;
+
+        ResponseResult<Result> get()
+        {
+            using namespace std::string_literals;
+
+            XmlReader reader{response_};
+            try
+            {
+                if (!moveToResponseNode(reader)) return std::pair{PlayerError{"SOAP", response_}, Result{}};
+            }
+            catch (std::exception&)
+            {
+                return std::pair{PlayerError{"SOAP", response_}, Result{}};
+            }
+
+            try
+            {
+                if (reader.localName() == "Fault")
+                {
+                    return std::pair{PlayerError{"SOAP", faultMessage(reader)}, Result{}};
+                }
+
+                return std::pair{PlayerError{}, parseBody(reader)};
+            }
+            catch (std::exception& e)
+            {
+                std::string error = "Error while parsing response. Details: "s + e.what();
+
+                return std::pair{PlayerError{"SOAP", error}, Result{}};
+            }
+        }
+
+    protected:
+        virtual Result parseBody(XmlReader& reader) = 0;
+
+        // Returns decoded text of the first direct child with the given name
+        std::string childText(XmlReader& reader, std::string_view name)
+        {
+            auto depth = reader.depth();
+            while (reader.nextChild(depth))
+            {
+                if (reader.localName() == name) return reader.readText();
+            }
+            throw XmlReader::Error{"SOAP", "Missing node " + std::string{name}};
+        }
+
+    private:
+        bool moveToResponseNode(XmlReader& reader)
+        {
+            if (!reader.nextChild(0) || reader.localName() != "Envelope") return false;
+
+            auto envelopeDepth = reader.depth();
+            while (reader.nextChild(envelopeDepth))
+            {
+                if (reader.localName() == "Body") return reader.nextChild(reader.depth());
+            }
+            return false;
+        }
+
+        std::string faultMessage(XmlReader& reader)
+        {
+            return childText(reader, "faultstring");
+        }
+
+    private:
+        std::string_view response_;
+    };
+
+}
@@ -21,13 +21,14 @@ std::string Soap::RequestSerializer<GetFile::Request>::string()
 }
 
 Soap::ResponseParser<GetFile::Result>::ResponseParser(const std::string& soapResponse) :
-    BaseResponseParser(soapResponse)
+    BaseStreamResponseParser(soapResponse)
 {
 }
 
-GetFile::Result Soap::ResponseParser<GetFile::Result>::parseBody(const XmlNode& node)
+// Chunks are the largest XMDS responses, reading them without a property tree copies the text once
+GetFile::Result Soap::ResponseParser<GetFile::Result>::parseBody(XmlReader& reader)
 {
     GetFile::Result result;
-    result.base64chunk = node.get<std::string>(Resources::FileChunk);
+    result.base64chunk = childText(reader, Resources::FileChunk);
     return result;
 }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "cms/xmds/BaseRequestSerializer.hpp"
-#include "cms/xmds/BaseResponseParser.hpp"
+#include "cms/xmds/BaseStreamResponseParser.hpp"
 #include "cms/xmds/Soap.hpp"
 
 #include "common/SoapField.hpp"
@@ -33,11 +33,11 @@ public:
 };
 
 template <>
-class Soap::ResponseParser<GetFile::Result> : public BaseResponseParser<GetFile::Result>
+class Soap::ResponseParser<GetFile::Result> : public BaseStreamResponseParser<GetFile::Result>
 {
 public:
     ResponseParser(const std::string& soapResponse);
 
 protected:
-    GetFile::Result parseBody(const XmlNode& node) override;
+    GetFile::Result parseBody(XmlReader& reader) override;
 };
@@ -20,13 +20,13 @@ std::string Soap::RequestSerializer<GetResource::Request>::string()
 }
 
 Soap::ResponseParser<GetResource::Result>::ResponseParser(const std::string& soapResponse) :
-    BaseResponseParser(soapResponse)
+    BaseStreamResponseParser(soapResponse)
 {
 }
 
-GetResource::Result Soap::ResponseParser<GetResource::Result>::parseBody(const XmlNode& node)
+GetResource::Result Soap::ResponseParser<GetResource::Result>::parseBody(XmlReader& reader)
 {
     GetResource::Result result;
-    result.resource = node.get<std::string>(Resources::Resource);
+    result.resource = childText(reader, Resources::Resource);
     return result;
 }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "cms/xmds/BaseRequestSerializer.hpp"
-#include "cms/xmds/BaseResponseParser.hpp"
+#include "cms/xmds/BaseStreamResponseParser.hpp"
 #include "cms/xmds/Soap.hpp"
 
 #include "common/SoapField.hpp"
@@ -32,11 +32,11 @@ public:
 };
 
 template <>
-class Soap::ResponseParser<GetResource::Result> : public BaseResponseParser<GetResource::Result>
+class Soap::ResponseParser<GetResource::Result> : public BaseStreamResponseParser<GetResource::Result>
 {
 public:
     ResponseParser(const std::string& soapResponse);
 
 protected:
-    GetResource::Result parseBody(const XmlNode& node) override;
+    GetResource::Result parseBody(XmlReader& reader) override;
 };
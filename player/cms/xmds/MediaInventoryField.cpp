@@ -1,6 +1,8 @@
 #include "MediaInventoryField.hpp"
 
-#include "common/parsing/Parsing.hpp"
+#include "common/parsing/XmlWriter.hpp"
+
+const size_t ApproxItemSize = 128;
 
 std::string_view SoapField<MediaInventoryItems>::type() const
 {
@@ -14,20 +16,20 @@ std::string SoapField<MediaInventoryItems>::value() const
 
 std::string SoapField<MediaInventoryItems>::toXmlString(const MediaInventoryItems& items) const
 {
-    XmlNode root;
-    auto&& filesNode = root.put_child("files", {});
+    XmlWriter writer{ApproxItemSize * (items.size() + 1)};
 
+    writer.raw("<![CDATA[").declaration().startElement("files");
     for (auto&& item : items)
     {
-        auto&& fileNode = filesNode.add_child("file", {});
-        auto&& fileAttrs = fileNode.put_child("<xmlattr>", {});
-
-        fileAttrs.put("type", item.type());
-        fileAttrs.put("id", item.id());
-        fileAttrs.put("complete", static_cast<int>(item.downloadComplete()));
-        fileAttrs.put("md5", item.md5());
-        fileAttrs.put("lastChecked", item.lastChecked());
+        writer.startElement("file")
+            .attribute("type", item.type())
+            .attribute("id", item.id())
+            .attribute("complete", static_cast<int>(item.downloadComplete()))
+            .attribute("md5", static_cast<const std::string&>(item.md5()))
+            .attribute("lastChecked", item.lastChecked())
+            .endElement();
     }
+    writer.endElement().raw("]]>");
 
-    return std::string("<![CDATA[") + Parsing::xmlTreeToString(root) + "]]>";
+    return writer.release();
 }
@@ -53,3 +53,14 @@ const std::string& MediaInventoryItem::lastChecked() const
 {
     return lastChecked_;
 }
+
+bool operator==(const MediaInventoryItem& first, const MediaInventoryItem& second)
+{
+    return first.id() == second.id() && first.type() == second.type() &&
+           first.downloadComplete() == second.downloadComplete() && first.md5() == second.md5();
+}
+
+bool operator!=(const MediaInventoryItem& first, const MediaInventoryItem& second)
+{
+    return !(first == second);
+}
@@ -24,4 +24,8 @@ private:
     std::string lastChecked_;
 };
 
+// lastChecked is not compared as it only reflects when the item was created
+bool operator==(const MediaInventoryItem& first, const MediaInventoryItem& second);
+bool operator!=(const MediaInventoryItem& first, const MediaInventoryItem& second);
+
 using MediaInventoryItems = std::vector<MediaInventoryItem>;
@@ -53,6 +53,8 @@ RegisterDisplay::Result Soap::ResponseParser<RegisterDisplay::Result>::parseBody
     RegisterDisplay::Result result;
     result.status.code = static_cast<RegisterDisplay::Result::Status::Code>(attrs.get<int>(Resources::Status));
     result.status.message = attrs.get<std::string>(Resources::StatusMessage);
+    result.requiredFilesChecksum = attrs.get<std::string>(Resources::RequiredFilesChecksum, {});
+    result.scheduleChecksum = attrs.get<std::string>(Resources::ScheduleChecksum, {});
     if (result.status.code == RegisterDisplay::Result::Status::Code::Ready)
     {
         result.playerSettings.collectInterval().setValue(displayNode.get<int>(Settings::CollectInterval));
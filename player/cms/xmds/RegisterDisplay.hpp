@@ -27,6 +27,9 @@ namespace RegisterDisplay
 
         Status status;
         PlayerSettings playerSettings;
+        // change markers provided by the CMS, empty when not supported
+        std::string requiredFilesChecksum;
+        std::string scheduleChecksum;
     };
 
     struct Request
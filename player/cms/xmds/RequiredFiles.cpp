@@ -14,6 +14,11 @@ const RequiredFilesSet<ResourceFile>& RequiredFiles::Result::requiredResources()
     return m_requiredResources;
 }
 
+const Md5Hash& RequiredFiles::Result::fingerprint() const
+{
+    return m_fingerprint;
+}
+
 void RequiredFiles::Result::addFile(RegularFile&& file)
 {
     m_requiredFiles.emplace_back(std::move(file));
@@ -24,6 +29,11 @@ void RequiredFiles::Result::addResource(ResourceFile&& resource)
     m_requiredResources.emplace_back(std::move(resource));
 }
 
+void RequiredFiles::Result::setFingerprint(Md5Hash&& fingerprint)
+{
+    m_fingerprint = std::move(fingerprint);
+}
+
 Soap::RequestSerializer<RequiredFiles::Request>::RequestSerializer(const RequiredFiles::Request& request) :
     BaseRequestSerializer(request)
 {
@@ -35,55 +45,88 @@ std::string Soap::RequestSerializer<RequiredFiles::Request>::string()
 }
 
 Soap::ResponseParser<RequiredFiles::Result>::ResponseParser(const std::string& soapResponse) :
-    BaseResponseParser(soapResponse)
+    BaseStreamResponseParser(soapResponse)
 {
 }
 
-RequiredFiles::Result Soap::ResponseParser<RequiredFiles::Result>::parseBody(const XmlNode& node)
+// Files are read straight from the embedded document into the result without intermediate trees
+RequiredFiles::Result Soap::ResponseParser<RequiredFiles::Result>::parseBody(XmlReader& reader)
 {
-    auto requiredFilesXml = node.get<std::string>(Resources::RequiredFilesXml);
-    auto filesNode = Parsing::xmlFrom(requiredFilesXml).get_child(Resources::Files);
+    auto requiredFilesXml = childText(reader, Resources::RequiredFilesXml);
+
+    XmlReader filesReader{requiredFilesXml};
+    if (!filesReader.nextChild(0) || filesReader.name() != Resources::Files)
+        throw XmlReader::Error{"RequiredFiles", "Files node is missing"};
 
     RequiredFiles::Result result;
 
-    for (auto [name, fileNode] : filesNode)
+    auto filesDepth = filesReader.depth();
+    while (filesReader.nextChild(filesDepth))
     {
-        if (name != Resources::File) continue;
+        if (filesReader.name() != Resources::File) continue;
 
-        auto fileAttrs = fileNode.get_child(Resources::FileAttrs);
-        auto fileType = fileAttrs.get<std::string>(Resources::FileType);
+        auto fileType = filesReader.requiredAttribute(Resources::FileType);
 
         if (isLayout(fileType) || isMedia(fileType))
         {
-            result.addFile(parseRegularFile(fileAttrs));
+            result.addFile(parseRegularFile(filesReader, fileType));
         }
         else if (isResource(fileType))
         {
-            result.addResource(parseResourceFile(fileAttrs));
+            result.addResource(parseResourceFile(filesReader));
         }
     }
+    result.setFingerprint(fingerprint(result));
 
     return result;
 }
 
-RegularFile Soap::ResponseParser<RequiredFiles::Result>::parseRegularFile(const XmlNode& attrs)
+// The response is stamped with the time it was generated and HTTP links may be signed per request, so only
+// the fields identifying the required content are hashed
+Md5Hash Soap::ResponseParser<RequiredFiles::Result>::fingerprint(const RequiredFiles::Result& result) const
+{
+    fmt::memory_buffer content;
+    for (auto&& file : result.requiredFiles())
+    {
+        fmt::format_to(std::back_inserter(content),
+                       "{} {} {} {} {} {}\n",
+                       file.type(),
+                       file.id(),
+                       file.size(),
+                       static_cast<const std::string&>(file.hash()),
+                       static_cast<int>(file.downloadType()),
+                       file.name());
+    }
+    for (auto&& resource : result.requiredResources())
+    {
+        fmt::format_to(std::back_inserter(content),
+                       "resource {} {} {} {}\n",
+                       resource.layoutId(),
+                       resource.regionId(),
+                       resource.mediaId(),
+                       resource.lastUpdate().timestamp());
+    }
+    return Md5Hash::fromString(std::string_view{content.data(), content.size()});
+}
+
+RegularFile Soap::ResponseParser<RequiredFiles::Result>::parseRegularFile(const XmlReader& file,
+                                                                          const std::string& fileType)
 {
-    auto fileType = attrs.get<std::string>(Resources::FileType);
-    auto id = attrs.get<int>(Resources::RegularFile::Id);
-    auto size = attrs.get<size_t>(Resources::RegularFile::Size);
-    auto md5 = Md5Hash{attrs.get<std::string>(Resources::RegularFile::MD5)};
-    auto downloadType = toDownloadType(attrs.get<std::string>(Resources::RegularFile::DownloadType));
-    auto [path, name] = parseFileNameAndPath(downloadType, fileType, attrs);
+    auto id = file.attribute<int>(Resources::RegularFile::Id);
+    auto size = file.attribute<size_t>(Resources::RegularFile::Size);
+    auto md5 = Md5Hash{file.requiredAttribute(Resources::RegularFile::MD5)};
+    auto downloadType = toDownloadType(file.requiredAttribute(Resources::RegularFile::DownloadType));
+    auto [path, name] = parseFileNameAndPath(downloadType, fileType, file);
 
     return RegularFile{id, size, md5, path, name, fileType, downloadType};
 }
 
-ResourceFile Soap::ResponseParser<RequiredFiles::Result>::parseResourceFile(const XmlNode& attrs)
+ResourceFile Soap::ResponseParser<RequiredFiles::Result>::parseResourceFile(const XmlReader& file)
 {
-    auto layoutId = attrs.get<int>(Resources::ResourceFile::MediaId);
-    auto regionId = attrs.get<int>(Resources::ResourceFile::RegionId);
-    auto mediaId = attrs.get<int>(Resources::ResourceFile::MediaId);
-    auto lastUpdate = DateTime::utcFromTimestamp(attrs.get<int>(Resources::ResourceFile::LastUpdate));
+    auto layoutId = file.attribute<int>(Resources::ResourceFile::MediaId);
+    auto regionId = file.attribute<int>(Resources::ResourceFile::RegionId);
+    auto mediaId = file.attribute<int>(Resources::ResourceFile::MediaId);
+    auto lastUpdate = DateTime::utcFromTimestamp(file.attribute<int>(Resources::ResourceFile::LastUpdate));
 
     return ResourceFile{layoutId, regionId, mediaId, lastUpdate};
 }
@@ -117,18 +160,18 @@ RegularFile::DownloadType Soap::ResponseParser<RequiredFiles::Result>::toDownloa
 std::pair<std::string, std::string> Soap::ResponseParser<RequiredFiles::Result>::parseFileNameAndPath(
     RegularFile::DownloadType dType,
     std::string_view fType,
-    const XmlNode& attrs)
+    const XmlReader& file)
 {
     std::string path, name;
 
     switch (dType)
     {
         case RegularFile::DownloadType::HTTP:
-            path = attrs.get<std::string>(Resources::RegularFile::Path);
-            name = attrs.get<std::string>(Resources::RegularFile::Name);
+            path = file.requiredAttribute(Resources::RegularFile::Path);
+            name = file.requiredAttribute(Resources::RegularFile::Name);
             break;
         case RegularFile::DownloadType::XMDS:
-            name = attrs.get<std::string>(Resources::RegularFile::Path);
+            name = file.requiredAttribute(Resources::RegularFile::Path);
             if (isLayout(fType))
             {
                 name += ".xlf";
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "cms/xmds/BaseRequestSerializer.hpp"
-#include "cms/xmds/BaseResponseParser.hpp"
+#include "cms/xmds/BaseStreamResponseParser.hpp"
 #include "cms/xmds/Soap.hpp"
 
 #include "common/SoapField.hpp"
@@ -13,13 +13,16 @@ namespace RequiredFiles
     {
         const RequiredFilesSet<RegularFile>& requiredFiles() const;
         const RequiredFilesSet<ResourceFile>& requiredResources() const;
+        const Md5Hash& fingerprint() const;
 
         void addFile(RegularFile&& file);
         void addResource(ResourceFile&& resource);
+        void setFingerprint(Md5Hash&& fingerprint);
 
     private:
         RequiredFilesSet<RegularFile> m_requiredFiles;
         RequiredFilesSet<ResourceFile> m_requiredResources;
+        Md5Hash m_fingerprint;
     };
 
     struct Request
@@ -38,23 +41,24 @@ public:
 };
 
 template <>
-class Soap::ResponseParser<RequiredFiles::Result> : public BaseResponseParser<RequiredFiles::Result>
+class Soap::ResponseParser<RequiredFiles::Result> : public BaseStreamResponseParser<RequiredFiles::Result>
 {
 public:
     ResponseParser(const std::string& soapResponse);
 
 protected:
-    RequiredFiles::Result parseBody(const XmlNode& node) override;
+    RequiredFiles::Result parseBody(XmlReader& reader) override;
 
 private:
-    RegularFile parseRegularFile(const XmlNode& attrs);
-    ResourceFile parseResourceFile(const XmlNode& attrs);
+    RegularFile parseRegularFile(const XmlReader& file, const std::string& fileType);
+    ResourceFile parseResourceFile(const XmlReader& file);
     std::pair<std::string, std::string> parseFileNameAndPath(RegularFile::DownloadType dType,
                                                              std::string_view fType,
-                                                             const XmlNode& attrs);
+                                                             const XmlReader& file);
 
     bool isLayout(std::string_view type) const;
     bool isMedia(std::string_view type) const;
     bool isResource(std::string_view type) const;
     RegularFile::DownloadType toDownloadType(std::string_view type);
+    Md5Hash fingerprint(const RequiredFiles::Result& result) const;
 };
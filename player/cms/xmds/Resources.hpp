@@ -34,6 +34,16 @@ namespace XmdsResources
         const std::string EndDT = Parsing::xmlAttr("todt");
         const std::string LocalDependants = "dependents";
         const std::string DependantFile = "file";
+
+        namespace Attrs
+        {
+            const std::string Generated = "generated";
+            const std::string ScheduleId = "scheduleid";
+            const std::string Id = "file";
+            const std::string Priority = "priority";
+            const std::string StartDT = "fromdt";
+            const std::string EndDT = "todt";
+        }
     }
 
     namespace RegisterDisplay
@@ -45,6 +55,8 @@ namespace XmdsResources
         const std::string DisplayAttrs = "<xmlattr>";
         const std::string Status = "status";
         const std::string StatusMessage = "message";
+        const std::string RequiredFilesChecksum = "checkRf";
+        const std::string ScheduleChecksum = "checkSchedule";
 
         namespace Settings
         {
@@ -79,7 +91,6 @@ namespace XmdsResources
         const std::string RequiredFilesXml = "RequiredFilesXml";
         const std::string Files = "files";
         const std::string File = "file";
-        const std::string FileAttrs = "<xmlattr>";
         const std::string FileType = "type";
         const std::string MediaType = "media";
         const std::string LayoutType = "layout";
@@ -15,13 +15,27 @@ std::string Soap::RequestSerializer<Schedule::Request>::string()
 }
 
 Soap::ResponseParser<Schedule::Result>::ResponseParser(const std::string& soapResponse) :
-    BaseResponseParser(soapResponse)
+    BaseStreamResponseParser(soapResponse)
 {
 }
 
-Schedule::Result Soap::ResponseParser<Schedule::Result>::parseBody(const XmlNode& scheduleNode)
+// Schedule is decoded on the collection thread so the UI thread only receives the ready structure
+Schedule::Result Soap::ResponseParser<Schedule::Result>::parseBody(XmlReader& reader)
 {
+    auto scheduleXml = childText(reader, Resources::ScheduleXml);
+
     Schedule::Result result;
-    result.scheduleXml = scheduleNode.get<std::string>(Resources::ScheduleXml);
+    result.schedule = LayoutSchedule::fromString(scheduleXml);
+    result.fingerprint = fingerprint(scheduleXml);
     return result;
 }
+
+// Attributes of the root element (generation time, filter range) change with every response while the
+// entries inside it describe the schedule itself
+Md5Hash Soap::ResponseParser<Schedule::Result>::fingerprint(std::string_view scheduleXml) const
+{
+    XmlReader reader{scheduleXml};
+    if (!reader.nextChild(0)) return Md5Hash::fromString(scheduleXml);
+
+    return Md5Hash::fromString(scheduleXml.substr(reader.offset()));
+}
@@ -1,16 +1,19 @@
 #pragma once
 
 #include "cms/xmds/BaseRequestSerializer.hpp"
-#include "cms/xmds/BaseResponseParser.hpp"
+#include "cms/xmds/BaseStreamResponseParser.hpp"
 #include "cms/xmds/Soap.hpp"
 
 #include "common/SoapField.hpp"
+#include "common/crypto/Md5Hash.hpp"
+#include "schedule/LayoutSchedule.hpp"
 
 namespace Schedule
 {
     struct Result
     {
-        std::string scheduleXml;
+        LayoutSchedule schedule;
+        Md5Hash fingerprint;
     };
 
     struct Request
@@ -29,11 +32,14 @@ public:
 };
 
 template <>
-class Soap::ResponseParser<Schedule::Result> : public BaseResponseParser<Schedule::Result>
+class Soap::ResponseParser<Schedule::Result> : public BaseStreamResponseParser<Schedule::Result>
 {
 public:
     ResponseParser(const std::string& soapResponse);
 
 protected:
-    Schedule::Result parseBody(const XmlNode& scheduleNode) override;
+    Schedule::Result parseBody(XmlReader& reader) override;
+
+private:
+    Md5Hash fingerprint(std::string_view scheduleXml) const;
 };
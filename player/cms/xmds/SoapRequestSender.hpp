@@ -6,25 +6,30 @@
 
 namespace SoapRequestHelper
 {
+    // Parsers work on views of the response body, which stays owned by httpResponse
     template <typename Result>
-    ResponseResult<Result> onResponseReceived(const HttpResponseResult& httpResponse)
+    ResponseResult<Result> onResponseReceived(HttpResponseResult&& httpResponse)
     {
-        auto [httpError, httpResult] = httpResponse;
-        if (httpError) return ResponseResult<Result>{httpError, {}};
+        auto&& [httpError, httpBody] = httpResponse;
+        if (httpError) return ResponseResult<Result>{std::move(httpError), {}};
 
-        Soap::ResponseParser<Result> parser(httpResult);
+        Soap::ResponseParser<Result> parser(httpBody);
         return parser.get();
     }
 
     template <typename Result, typename Request>
-    boost::future<ResponseResult<Result>> sendRequest(const Uri& uri, const Request& soapRequest)
+    boost::future<ResponseResult<Result>> sendRequest(const Uri& uri,
+                                                      const Request& soapRequest,
+                                                      RequestCompression compression = RequestCompression::None,
+                                                      RequestRetry retry = RequestRetry::None,
+                                                      RequestTraffic traffic = RequestTraffic::Control)
     {
         static_assert(std::is_copy_assignable_v<Request> && std::is_copy_constructible_v<Request>);
 
         Soap::RequestSerializer<Request> serializer{soapRequest};
 
-        return HttpClient::instance().post(uri, serializer.string()).then([](boost::future<HttpResponseResult> future) {
-            return onResponseReceived<Result>(future.get());
-        });
+        return HttpClient::instance()
+            .post(uri, serializer.string(), compression, retry, traffic)
+            .then([](boost::future<HttpResponseResult> future) { return onResponseReceived<Result>(future.get()); });
     }
 }
@@ -23,12 +23,13 @@ boost::future<XmdsResponseResult> XmdsFileDownloader::download(int fileId,
         fileOffset += chunkSize;
     }
 
-    return boost::async([=, results = std::move(results)]() mutable { return combineAllChunks(results); });
+    return boost::async([=, results = std::move(results)]() mutable { return combineAllChunks(results, fileSize); });
 }
 
-XmdsResponseResult XmdsFileDownloader::combineAllChunks(DownloadXmdsFilesResult& results)
+XmdsResponseResult XmdsFileDownloader::combineAllChunks(DownloadXmdsFilesResult& results, std::size_t fileSize)
 {
     std::string fileContent;
+    fileContent.reserve(fileSize);
     for (auto&& future : results)
     {
         auto [error, result] = future.get();
@@ -41,5 +42,5 @@ XmdsResponseResult XmdsFileDownloader::combineAllChunks(DownloadXmdsFilesResult&
             return {error, std::string{}};
         }
     }
-    return {PlayerError{}, fileContent};
+    return {PlayerError{}, std::move(fileContent)};
 }
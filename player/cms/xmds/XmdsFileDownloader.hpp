@@ -16,7 +16,7 @@ public:
     boost::future<XmdsResponseResult> download(int fileId, const std::string& fileType, std::size_t fileSize);
 
 private:
-    XmdsResponseResult combineAllChunks(DownloadXmdsFilesResult& results);
+    XmdsResponseResult combineAllChunks(DownloadXmdsFilesResult& results, std::size_t fileSize);
 
 private:
     XmdsRequestSender& xmdsSender_;
@@ -9,6 +9,17 @@
 
 const std::string DefaultClientType = "linux";
 const std::string XmdsTarget = "/xmds.php?v=5";
+const std::string_view CDataStart = "<![CDATA[";
+const std::string_view CDataEnd = "]]>";
+
+// Wraps a payload with a single allocation as logs and stats can be large
+std::string cdata(std::string_view content)
+{
+    std::string result;
+    result.reserve(CDataStart.size() + content.size() + CDataEnd.size());
+    result.append(CDataStart).append(content).append(CDataEnd);
+    return result;
+}
 
 XmdsRequestSender::XmdsRequestSender(const std::string& host,
                                      const std::string& serverKey,
@@ -35,7 +46,8 @@ FutureResponseResult<RegisterDisplay::Result> XmdsRequestSender::registerDisplay
     request.xmrPubKey = CryptoUtils::keyToString(RsaManager::instance().publicKey());
     request.displayName = displayName;
 
-    return SoapRequestHelper::sendRequest<RegisterDisplay::Result>(uri_, request);
+    return SoapRequestHelper::sendRequest<RegisterDisplay::Result>(
+        uri_, request, RequestCompression::None, RequestRetry::Idempotent);
 }
 
 FutureResponseResult<RequiredFiles::Result> XmdsRequestSender::requiredFiles()
@@ -44,7 +56,8 @@ FutureResponseResult<RequiredFiles::Result> XmdsRequestSender::requiredFiles()
     request.serverKey = serverKey_;
     request.hardwareKey = hardwareKey_;
 
-    return SoapRequestHelper::sendRequest<RequiredFiles::Result>(uri_, request);
+    return SoapRequestHelper::sendRequest<RequiredFiles::Result>(
+        uri_, request, RequestCompression::None, RequestRetry::Idempotent);
 }
 
 FutureResponseResult<Schedule::Result> XmdsRequestSender::schedule()
@@ -53,7 +66,8 @@ FutureResponseResult<Schedule::Result> XmdsRequestSender::schedule()
     request.serverKey = serverKey_;
     request.hardwareKey = hardwareKey_;
 
-    return SoapRequestHelper::sendRequest<Schedule::Result>(uri_, request);
+    return SoapRequestHelper::sendRequest<Schedule::Result>(
+        uri_, request, RequestCompression::None, RequestRetry::Idempotent);
 }
 
 FutureResponseResult<GetResource::Result> XmdsRequestSender::getResource(int layoutId, int regionId, int mediaId)
@@ -65,7 +79,8 @@ FutureResponseResult<GetResource::Result> XmdsRequestSender::getResource(int lay
     request.regionId = std::to_string(regionId);
     request.mediaId = std::to_string(mediaId);
 
-    return SoapRequestHelper::sendRequest<GetResource::Result>(uri_, request);
+    return SoapRequestHelper::sendRequest<GetResource::Result>(
+        uri_, request, RequestCompression::None, RequestRetry::Idempotent);
 }
 
 FutureResponseResult<GetFile::Result> XmdsRequestSender::getFile(int fileId,
@@ -81,7 +96,8 @@ FutureResponseResult<GetFile::Result> XmdsRequestSender::getFile(int fileId,
     request.chunkOffset = chunkOffset;
     request.chunkSize = chunkSize;
 
-    return SoapRequestHelper::sendRequest<GetFile::Result>(uri_, request);
+    return SoapRequestHelper::sendRequest<GetFile::Result>(
+        uri_, request, RequestCompression::None, RequestRetry::Hedged, RequestTraffic::Download);
 }
 
 FutureResponseResult<MediaInventory::Result> XmdsRequestSender::mediaInventory(MediaInventoryItems&& inventory)
@@ -91,7 +107,8 @@ FutureResponseResult<MediaInventory::Result> XmdsRequestSender::mediaInventory(M
     request.hardwareKey = hardwareKey_;
     request.inventory = std::move(inventory);
 
-    return SoapRequestHelper::sendRequest<MediaInventory::Result>(uri_, request);
+    return SoapRequestHelper::sendRequest<MediaInventory::Result>(
+        uri_, request, RequestCompression::None, RequestRetry::Idempotent);
 }
 
 FutureResponseResult<SubmitLog::Result> XmdsRequestSender::submitLogs(const std::string& logXml)
@@ -99,9 +116,9 @@ FutureResponseResult<SubmitLog::Result> XmdsRequestSender::submitLogs(const std:
     SubmitLog::Request request;
     request.serverKey = serverKey_;
     request.hardwareKey = hardwareKey_;
-    request.logXml = std::string("<![CDATA[") + logXml + "]]>";
+    request.logXml = cdata(logXml);
 
-    return SoapRequestHelper::sendRequest<SubmitLog::Result>(uri_, request);
+    return SoapRequestHelper::sendRequest<SubmitLog::Result>(uri_, request, uploadCompression_);
 }
 
 FutureResponseResult<SubmitStats::Result> XmdsRequestSender::submitStats(const std::string& statXml)
@@ -109,9 +126,9 @@ FutureResponseResult<SubmitStats::Result> XmdsRequestSender::submitStats(const s
     SubmitStats::Request request;
     request.serverKey = serverKey_;
     request.hardwareKey = hardwareKey_;
-    request.statXml = std::string("<![CDATA[") + statXml + "]]>";
+    request.statXml = cdata(statXml);
 
-    return SoapRequestHelper::sendRequest<SubmitStats::Result>(uri_, request);
+    return SoapRequestHelper::sendRequest<SubmitStats::Result>(uri_, request, uploadCompression_);
 }
 
 FutureResponseResult<SubmitScreenShot::Result> XmdsRequestSender::submitScreenShot(const std::string& screenShot)
@@ -131,5 +148,11 @@ FutureResponseResult<NotifyStatus::Result> XmdsRequestSender::notifyStatus(const
     request.hardwareKey = hardwareKey_;
     request.status = status;
 
-    return SoapRequestHelper::sendRequest<NotifyStatus::Result>(uri_, request);
+    return SoapRequestHelper::sendRequest<NotifyStatus::Result>(
+        uri_, request, RequestCompression::None, RequestRetry::Idempotent);
+}
+
+void XmdsRequestSender::setUploadCompression(bool enabled)
+{
+    uploadCompression_ = enabled ? RequestCompression::Gzip : RequestCompression::None;
 }
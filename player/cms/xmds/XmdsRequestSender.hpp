@@ -12,6 +12,7 @@
 #include "cms/xmds/SubmitLog.hpp"
 #include "cms/xmds/SubmitScreenShot.hpp"
 #include "cms/xmds/SubmitStats.hpp"
+#include "networking/HttpClient.hpp"
 #include "networking/ResponseResult.hpp"
 
 #include "common/types/Uri.hpp"
@@ -40,9 +41,13 @@ public:
     FutureResponseResult<SubmitScreenShot::Result> submitScreenShot(const std::string& screenshot);
     FutureResponseResult<NotifyStatus::Result> notifyStatus(const std::string& status);
 
+    // large SubmitLog and SubmitStats bodies are gzipped when enabled
+    void setUploadCompression(bool enabled);
+
 private:
     Uri uri_;
     std::string host_;
     std::string serverKey_;
     std::string hardwareKey_;
+    RequestCompression uploadCompression_ = RequestCompression::None;
 };
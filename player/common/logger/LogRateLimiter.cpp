@@ -0,0 +1,40 @@
+#include "LogRateLimiter.hpp"
+
+#include <algorithm>
+#include <utility>
+
+LogRateLimiter::LogRateLimiter(double messagesPerSecond, size_t burst) :
+    rate_{messagesPerSecond},
+    burst_{static_cast<double>(burst)},
+    tokens_{static_cast<double>(burst)},
+    lastRefill_{Clock::now()}
+{
+}
+
+bool LogRateLimiter::acquire()
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    refill(Clock::now());
+    if (tokens_ < 1.0)
+    {
+        ++suppressed_;
+        return false;
+    }
+
+    tokens_ -= 1.0;
+    return true;
+}
+
+size_t LogRateLimiter::takeSuppressed()
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    return std::exchange(suppressed_, 0);
+}
+
+void LogRateLimiter::refill(Clock::time_point now)
+{
+    std::chrono::duration<double> elapsed = now - lastRefill_;
+    tokens_ = std::min(burst_, tokens_ + elapsed.count() * rate_);
+    lastRefill_ = now;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+// Token bucket for repetitive messages on hot paths. Messages rejected by the bucket are counted
+// so that the next accepted message can be preceded by a summary of what was suppressed.
+class LogRateLimiter
+{
+    using Clock = std::chrono::steady_clock;
+
+public:
+    LogRateLimiter(double messagesPerSecond, size_t burst);
+
+    bool acquire();
+    size_t takeSuppressed();
+
+private:
+    void refill(Clock::time_point now);
+
+private:
+    const double rate_;
+    const double burst_;
+    double tokens_;
+    size_t suppressed_ = 0;
+    Clock::time_point lastRefill_;
+    std::mutex mutex_;
+};
@@ -5,8 +5,57 @@
 #include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include <atomic>
+#include <map>
+#include <optional>
+
 const std::string SpdLogger = "logger";
 
+using SubsystemLevels = std::map<std::string, spdlog::level::level_enum, std::less<>>;
+
+namespace
+{
+    std::atomic<spdlog::level::level_enum> g_globalLevel{spdlog::level::debug};
+    // lowest level across global and subsystem ones, lets most disabled messages return without a tag lookup
+    std::atomic<spdlog::level::level_enum> g_minLevel{spdlog::level::debug};
+    std::shared_ptr<const SubsystemLevels> g_subsystemLevels;
+
+    std::optional<spdlog::level::level_enum> levelFrom(std::string_view level)
+    {
+        if (level == "trace") return spdlog::level::trace;
+        if (level == "debug") return spdlog::level::debug;
+        if (level == "info") return spdlog::level::info;
+        if (level == "error") return spdlog::level::err;
+        return {};
+    }
+
+    std::string_view trim(std::string_view str)
+    {
+        auto begin = str.find_first_not_of(" \t");
+        if (begin == std::string_view::npos) return {};
+        auto end = str.find_last_not_of(" \t");
+        return str.substr(begin, end - begin + 1);
+    }
+
+    void updateMinLevel()
+    {
+        auto minLevel = g_globalLevel.load();
+        if (auto levels = std::atomic_load(&g_subsystemLevels))
+        {
+            for (auto&& [tag, level] : *levels)
+            {
+                minLevel = std::min(minLevel, level);
+            }
+        }
+        g_minLevel = minLevel;
+
+        if (auto logger = spdlog::get(SpdLogger))
+        {
+            logger->set_level(minLevel);
+        }
+    }
+}
+
 std::shared_ptr<spdlog::logger> Log::logger()
 {
     static auto logger = spdlog::get(SpdLogger);
@@ -31,7 +80,7 @@ std::shared_ptr<spdlog::logger> Log::create()
 std::shared_ptr<spdlog::logger> Log::create(const std::vector<spdlog::sink_ptr>& sinks)
 {
     auto logger = std::make_shared<spdlog::logger>(SpdLogger, sinks.begin(), sinks.end());
-    logger->set_level(spdlog::level::debug);
+    logger->set_level(g_minLevel);
     logger->set_pattern("[%H:%M:%S.%e] [%t] [%l]: %v");
     spdlog::register_logger(logger);
     return logger;
@@ -39,12 +88,74 @@ std::shared_ptr<spdlog::logger> Log::create(const std::vector<spdlog::sink_ptr>&
 
 void Log::setLevel(const std::string& level)
 {
-    if (level == "trace")
-        logger()->set_level(spdlog::level::trace);
-    else if (level == "debug")
-        logger()->set_level(spdlog::level::debug);
-    else if (level == "info")
-        logger()->set_level(spdlog::level::info);
-    else if (level == "error")
-        logger()->set_level(spdlog::level::err);
+    if (auto value = levelFrom(level))
+    {
+        g_globalLevel = *value;
+        updateMinLevel();
+    }
+}
+
+void Log::setSubsystemLevels(const std::string& levels)
+{
+    auto subsystemLevels = std::make_shared<SubsystemLevels>();
+
+    std::string_view remaining{levels};
+    while (!remaining.empty())
+    {
+        auto separator = remaining.find_first_of(";,");
+        auto entry = remaining.substr(0, separator);
+        remaining = separator == std::string_view::npos ? std::string_view{} : remaining.substr(separator + 1);
+
+        auto equals = entry.find('=');
+        if (equals == std::string_view::npos) continue;
+
+        auto subsystem = trim(entry.substr(0, equals));
+        auto level = levelFrom(trim(entry.substr(equals + 1)));
+        if (!subsystem.empty() && level)
+        {
+            subsystemLevels->insert_or_assign(std::string{subsystem}, *level);
+        }
+    }
+
+    std::shared_ptr<const SubsystemLevels> value;
+    if (!subsystemLevels->empty())
+    {
+        value = std::move(subsystemLevels);
+    }
+    std::atomic_store(&g_subsystemLevels, value);
+    updateMinLevel();
+}
+
+std::string_view Log::tag(std::string_view message)
+{
+    if (message.empty() || message.front() != '[') return {};
+
+    auto end = message.find(']');
+    if (end == std::string_view::npos) return {};
+
+    auto tag = message.substr(1, end - 1);
+    return tag.find('{') == std::string_view::npos ? tag : std::string_view{};
+}
+
+bool Log::enabled(spdlog::level::level_enum level, std::string_view message)
+{
+    if (level < g_minLevel.load(std::memory_order_relaxed)) return false;
+
+    auto levels = std::atomic_load(&g_subsystemLevels);
+    if (levels)
+    {
+        auto messageTag = tag(message);
+        auto it = levels->find(messageTag);
+        if (it == levels->end())
+        {
+            auto subsystemEnd = messageTag.find("::");
+            if (subsystemEnd != std::string_view::npos)
+            {
+                it = levels->find(messageTag.substr(0, subsystemEnd));
+            }
+        }
+        if (it != levels->end()) return level >= it->second;
+    }
+
+    return level >= g_globalLevel.load(std::memory_order_relaxed);
 }
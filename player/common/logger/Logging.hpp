@@ -1,60 +1,103 @@
 #pragma once
 
+#include "common/logger/LogRateLimiter.hpp"
+
 #include <spdlog/fmt/ostr.h>
 #include <spdlog/logger.h>
 
+#include <string_view>
+#include <type_traits>
+
 namespace Log
 {
     std::shared_ptr<spdlog::logger> create();
     std::shared_ptr<spdlog::logger> create(const std::vector<spdlog::sink_ptr>& sinks);
     void setLevel(const std::string& level);
+    // Overrides the global level for messages prefixed with [Tag], e.g. "XMDS=trace;GstMediaPlayer=error".
+    // A tag like [XMDS::Schedule] is matched by itself first and then by its "XMDS" subsystem.
+    void setSubsystemLevels(const std::string& levels);
     std::shared_ptr<spdlog::logger> logger();
 
+    bool enabled(spdlog::level::level_enum level, std::string_view message);
+    std::string_view tag(std::string_view message);
+
+    template <typename... Args>
+    void log(spdlog::level::level_enum level, const char* fmt, const Args&... args)
+    {
+        if (enabled(level, fmt))
+        {
+            logger()->log(level, fmt, args...);
+        }
+    }
+
+    template <typename T>
+    void log(spdlog::level::level_enum level, const T& arg)
+    {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+            if (!enabled(level, arg)) return;
+        }
+        logger()->log(level, arg);
+    }
+
+    // Logs through the limiter and reports how many messages were dropped since the last accepted one
+    template <typename... Args>
+    void limited(LogRateLimiter& limiter, spdlog::level::level_enum level, const char* fmt, const Args&... args)
+    {
+        if (!enabled(level, fmt) || !limiter.acquire()) return;
+
+        if (auto suppressed = limiter.takeSuppressed())
+        {
+            logger()->log(level, "[{}] {} similar messages suppressed", tag(fmt), suppressed);
+        }
+        logger()->log(level, fmt, args...);
+    }
+
     template <typename... Args>
     void trace(const char* fmt, const Args&... args)
     {
-        logger()->log(spdlog::level::trace, fmt, args...);
+        log(spdlog::level::trace, fmt, args...);
     }
 
     template <typename T>
     void trace(const T& arg)
     {
-        logger()->log(spdlog::level::trace, arg);
+        log(spdlog::level::trace, arg);
     }
 
     template <typename... Args>
     void debug(const char* fmt, const Args&... args)
     {
-        logger()->log(spdlog::level::debug, fmt, args...);
+        log(spdlog::level::debug, fmt, args...);
     }
 
     template <typename T>
     void debug(const T& arg)
     {
-        logger()->log(spdlog::level::debug, arg);
+        log(spdlog::level::debug, arg);
     }
 
     template <typename... Args>
     void info(const char* fmt, const Args&... args)
     {
-        logger()->log(spdlog::level::info, fmt, args...);
+        log(spdlog::level::info, fmt, args...);
     }
 
     template <typename T>
     void info(const T& arg)
     {
-        logger()->log(spdlog::level::info, arg);
+        log(spdlog::level::info, arg);
     }
 
     template <typename... Args>
     void error(const char* fmt, const Args&... args)
     {
-        logger()->log(spdlog::level::err, fmt, args...);
+        log(spdlog::level::err, fmt, args...);
     }
 
     template <typename T>
     void error(const T& arg)
     {
-        logger()->log(spdlog::level::err, arg);
+        log(spdlog::level::err, arg);
     }
 }
@@ -0,0 +1,193 @@
+#include "XmlLoggerSink.hpp"
+
+#include "common/parsing/XmlWriter.hpp"
+
+#include <ctime>
+
+const size_t ApproxEntrySize = 160;
+const size_t MaxRecordSize = 64 * 1024;
+const size_t MaxUtf8ContinuationBytes = 3;
+
+// Long messages are cut at the start of a code point so that the XML sent to the CMS stays valid UTF-8
+static size_t truncatedSize(std::string_view text, size_t maxSize)
+{
+    if (text.size() <= maxSize) return text.size();
+
+    size_t size = maxSize;
+    for (size_t i = 0; i != MaxUtf8ContinuationBytes && size > 0; ++i)
+    {
+        if ((static_cast<unsigned char>(text[size]) & 0xC0) != 0x80) break;
+        --size;
+    }
+    return size;
+}
+
+XmlLoggerSink::XmlLoggerSink(XmlLogsRepo& registry, size_t capacity, OverflowPolicy policy) :
+    registry_(registry),
+    policy_(policy),
+    ring_(capacity)
+{
+    worker_ = std::make_unique<JoinableThread>([this]() { processQueue(); });
+}
+
+XmlLoggerSink::~XmlLoggerSink()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopped_ = true;
+    }
+    messageAvailable_.notify_one();
+    messagesWritten_.notify_all();
+    worker_.reset();
+}
+
+size_t XmlLoggerSink::droppedCount() const
+{
+    return dropped_;
+}
+
+// Called by spdlog with mutex_ locked
+void XmlLoggerSink::sink_it_(const spdlog::details::log_msg& msg)
+{
+    if (size_ == ring_.size())
+    {
+        ++dropped_;
+        if (policy_ == OverflowPolicy::DropNewest) return;
+
+        head_ = (head_ + 1) % ring_.size();
+        --size_;
+        ++processed_;
+    }
+
+    auto&& entry = ring_[(head_ + size_) % ring_.size()];
+    entry.time = msg.time;
+    entry.level = msg.level;
+    entry.threadId = msg.thread_id;
+    std::string_view payload{msg.payload.data(), msg.payload.size()};
+    entry.payload.assign(payload.data(), truncatedSize(payload, MaxMessageSize));
+    ++size_;
+    ++queued_;
+
+    messageAvailable_.notify_one();
+}
+
+// Called by spdlog with mutex_ locked, which is released while waiting and held again on return
+void XmlLoggerSink::flush_()
+{
+    auto target = queued_;
+    messageAvailable_.notify_one();
+
+    std::unique_lock<std::mutex> lock{mutex_, std::adopt_lock};
+    messagesWritten_.wait(lock, [this, target]() { return processed_ >= target || stopped_; });
+    lock.release();
+}
+
+void XmlLoggerSink::processQueue()
+{
+    std::vector<Entry> entries(ring_.size());
+    std::string chunk;
+
+    while (true)
+    {
+        auto count = takeEntries(entries);
+        if (count == 0) return;
+
+        chunk.clear();
+        chunk.reserve(std::min(count * ApproxEntrySize, MaxRecordSize + MaxMessageSize));
+
+        auto dropped = dropped_.load();
+        if (dropped != droppedReported_)
+        {
+            formatDroppedEntry(chunk, dropped - droppedReported_);
+            droppedReported_ = dropped;
+        }
+
+        // keeps spool records small so uploads can be split at record boundaries
+        for (size_t i = 0; i != count; ++i)
+        {
+            formatEntry(chunk, entries[i]);
+            if (chunk.size() >= MaxRecordSize)
+            {
+                registry_.append(chunk);
+                chunk.clear();
+            }
+        }
+        if (!chunk.empty())
+        {
+            registry_.append(chunk);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            processed_ += count;
+        }
+        messagesWritten_.notify_all();
+    }
+}
+
+// Swaps queued entries out of the ring so that both sides keep reusing their string buffers.
+// Returns 0 only when the sink has been stopped and the queue is drained.
+size_t XmlLoggerSink::takeEntries(std::vector<Entry>& entries)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    messageAvailable_.wait(lock, [this]() { return size_ > 0 || stopped_; });
+
+    size_t count = size_;
+    for (size_t i = 0; i != count; ++i)
+    {
+        std::swap(entries[i], ring_[(head_ + i) % ring_.size()]);
+    }
+    head_ = (head_ + count) % ring_.size();
+    size_ = 0;
+
+    return count;
+}
+
+void XmlLoggerSink::formatEntry(std::string& out, const Entry& entry)
+{
+    out += "<log date=\"";
+    out += timestamps_.format(entry.time);
+    out += "\" category=\"";
+    out += formatLogLevel(entry.level);
+    out += "\"><thread>";
+    out += std::to_string(entry.threadId);
+    out += "</thread><message>";
+    XmlWriter::escape(out, entry.payload);
+    out += "</message></log>";
+}
+
+void XmlLoggerSink::formatDroppedEntry(std::string& out, size_t dropped)
+{
+    Entry entry{std::chrono::system_clock::now(), spdlog::level::err, 0, {}};
+    entry.payload = "[XmlLoggerSink] " + std::to_string(dropped) + " log messages dropped due to queue overflow";
+    formatEntry(out, entry);
+}
+
+std::string_view XmlLoggerSink::formatLogLevel(spdlog::level::level_enum level)
+{
+    switch (level)
+    {
+        case spdlog::level::trace: return "trace";
+        case spdlog::level::debug: return "debug";
+        case spdlog::level::info:
+        case spdlog::level::warn: return "info";
+        case spdlog::level::err:
+        case spdlog::level::critical:
+        case spdlog::level::off: return "error";
+        case spdlog::level::n_levels: return "unknown";
+    }
+    return {};
+}
+
+std::string_view XmlLoggerSink::TimestampCache::format(std::chrono::system_clock::time_point tp)
+{
+    auto second = std::chrono::system_clock::to_time_t(tp);
+    if (second != second_)
+    {
+        std::tm local;
+        localtime_r(&second, &local);
+        size_ = std::strftime(formatted_, sizeof(formatted_), "%Y-%m-%d %H:%M:%S", &local);
+        second_ = second;
+    }
+    return std::string_view{formatted_, size_};
+}
@@ -1,79 +1,83 @@
 #pragma once
 
-#include <mutex>
-#include <spdlog/details/file_helper.h>
-#include <spdlog/details/null_mutex.h>
 #include <spdlog/sinks/base_sink.h>
-#include <spdlog/sinks/basic_file_sink.h>
 
 #include "XmlLogsRepo.hpp"
-#include "common/dt/DateTime.hpp"
+#include "common/JoinableThread.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
 
-template <typename Mutex>
-class XmlLoggerSink : public spdlog::sinks::base_sink<Mutex>
+// Formats log messages into CMS XML on a background thread. Messages are copied into a fixed-size
+// ring buffer on the calling thread; when the ring is full the oldest message is dropped and counted.
+// Flushing waits until the messages queued so far are in the repo.
+class XmlLoggerSink : public spdlog::sinks::base_sink<std::mutex>
 {
-public:
-    XmlLoggerSink(XmlLogsRepo& registry) : registry_(registry) {}
+    static constexpr const size_t DefaultQueueCapacity = 4096;
+    static constexpr const size_t MaxMessageSize = 4096;
 
-protected:
-    void sink_it_(const spdlog::details::log_msg& msg) override
+public:
+    enum class OverflowPolicy
     {
-        writeMessageToFile(formatMessage(msg));
-    }
+        DropOldest,
+        DropNewest
+    };
 
-    void flush_() override
-    {
-        registry_.append(buffer_);
-        buffer_.clear();
-    }
+    XmlLoggerSink(XmlLogsRepo& registry,
+                  size_t capacity = DefaultQueueCapacity,
+                  OverflowPolicy policy = OverflowPolicy::DropOldest);
+    ~XmlLoggerSink();
 
-private:
-    void writeMessageToFile(const std::string& message)
-    {
-        buffer_.append(message);
-    }
-
-    std::string formatMessage(const spdlog::details::log_msg& msg)
-    {
-        std::string message;
+    size_t droppedCount() const;
 
-        message += "<log ";
-        message += "date=\"" + formatDateTime(msg.time) + "\"";
-        message += "category=\"" + formatLogLevel(msg.level) + "\">";
-        message += "<thread>" + std::to_string(msg.thread_id) + "</thread>";
-        message += "<message>" + fmt::to_string(msg.payload) + "</message>";
-        message += "</log>";
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override;
+    void flush_() override;
 
-        return message;
-    }
+private:
+    struct Entry
+    {
+        std::chrono::system_clock::time_point time;
+        spdlog::level::level_enum level;
+        size_t threadId;
+        std::string payload;
+    };
 
-    std::string formatDateTime(std::chrono::system_clock::time_point tp)
+    class TimestampCache
     {
-        auto dt = DateTime::localFromTimestamp(std::chrono::system_clock::to_time_t(tp));
+    public:
+        std::string_view format(std::chrono::system_clock::time_point tp);
 
-        return dt.string("%Y-%m-%d %H:%M:%S");
-    }
+    private:
+        std::time_t second_ = -1;
+        char formatted_[32] = {};
+        size_t size_ = 0;
+    };
 
-    std::string formatLogLevel(spdlog::level::level_enum level)
-    {
-        switch (level)
-        {
-            case spdlog::level::trace: return "trace";
-            case spdlog::level::debug: return "debug";
-            case spdlog::level::info:
-            case spdlog::level::warn: return "info";
-            case spdlog::level::err:
-            case spdlog::level::critical:
-            case spdlog::level::off: return "error";
-            case spdlog::level::n_levels: return "unknown";
-        }
-        return {};
-    }
+    void processQueue();
+    size_t takeEntries(std::vector<Entry>& entries);
+    void formatEntry(std::string& out, const Entry& entry);
+    void formatDroppedEntry(std::string& out, size_t dropped);
+    std::string_view formatLogLevel(spdlog::level::level_enum level);
 
 private:
-    std::string buffer_;
     XmlLogsRepo& registry_;
+    OverflowPolicy policy_;
+    std::vector<Entry> ring_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    std::atomic<size_t> dropped_ = 0;
+    size_t droppedReported_ = 0;
+    // messages which entered the ring and which left it, either written to the repo or overwritten
+    uint64_t queued_ = 0;
+    uint64_t processed_ = 0;
+    bool stopped_ = false;
+    std::condition_variable messageAvailable_;
+    std::condition_variable messagesWritten_;
+    TimestampCache timestamps_;
+    std::unique_ptr<JoinableThread> worker_;
 };
 
-using LoggerXmlSinkMt = XmlLoggerSink<std::mutex>;
-using LoggerXmlSinkSt = XmlLoggerSink<spdlog::details::null_mutex>;
+using LoggerXmlSinkMt = XmlLoggerSink;
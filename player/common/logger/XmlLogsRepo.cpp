@@ -6,19 +6,49 @@ XmlLogsRepo& XmlLogsRepo::get()
     return repo;
 }
 
-std::string XmlLogsRepo::buffer() const
+XmlLogsRepo::XmlLogsRepo() : spool_(std::make_unique<XmlLogsSpool>(DefaultMemoryCapacity)) {}
+
+// Logs are collected in memory until the config directory is known, then they are moved to the on-disk spool
+void XmlLogsRepo::attachSpool(const std::string& path, size_t capacity)
+{
+    auto spool = std::make_unique<XmlLogsSpool>(path, capacity);
+
+    std::unique_lock lock{mutex_};
+    while (!spool_->empty())
+    {
+        auto record = spool_->read(1);
+        spool->append(record.data);
+        spool_->commit(record.end);
+    }
+    spool_ = std::move(spool);
+}
+
+void XmlLogsRepo::append(std::string_view data)
 {
-    return buffer_;
+    std::unique_lock lock{mutex_};
+    spool_->append(data);
+}
+
+XmlLogsSpool::Chunk XmlLogsRepo::read(size_t maxSize) const
+{
+    std::unique_lock lock{mutex_};
+    return spool_->read(maxSize);
+}
+
+void XmlLogsRepo::commit(uint64_t position)
+{
+    std::unique_lock lock{mutex_};
+    spool_->commit(position);
 }
 
-void XmlLogsRepo::append(const std::string& data)
+bool XmlLogsRepo::empty() const
 {
     std::unique_lock lock{mutex_};
-    buffer_.append(data);
+    return spool_->empty();
 }
 
-void XmlLogsRepo::clear()
+uint64_t XmlLogsRepo::droppedBytes() const
 {
     std::unique_lock lock{mutex_};
-    buffer_.clear();
+    return spool_->droppedBytes();
 }
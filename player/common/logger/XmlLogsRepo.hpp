@@ -1,18 +1,31 @@
 #pragma once
 
+#include "common/logger/XmlLogsSpool.hpp"
+
+#include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 
 class XmlLogsRepo
 {
+    static constexpr const size_t DefaultMemoryCapacity = 2 * 1024 * 1024;
+    static constexpr const size_t DefaultSpoolCapacity = 8 * 1024 * 1024;
+
 public:
     static XmlLogsRepo& get();
 
-    std::string buffer() const;
-    void append(const std::string& data);
-    void clear();
+    void attachSpool(const std::string& path, size_t capacity = DefaultSpoolCapacity);
+    void append(std::string_view data);
+    XmlLogsSpool::Chunk read(size_t maxSize) const;
+    void commit(uint64_t position);
+    bool empty() const;
+    uint64_t droppedBytes() const;
+
+private:
+    XmlLogsRepo();
 
 private:
-    std::string buffer_;
-    std::mutex mutex_;
+    std::unique_ptr<XmlLogsSpool> spool_;
+    mutable std::mutex mutex_;
 };
@@ -1,37 +1,40 @@
 #include "XmlLogsRetriever.hpp"
 
-#include "common/parsing/Parsing.hpp"
 #include "common/logger/Logging.hpp"
 #include "common/logger/XmlLogsRepo.hpp"
+#include "common/parsing/XmlWriter.hpp"
 
 // TODO: move to SubmitLogs request where it should format logs according to required CMS format
 
-std::string XmlLogsRetriever::retrieveLogs()
+const size_t LogsWrapperSize = 64;
+
+bool XmlLogsRetriever::Logs::empty() const
+{
+    return xml.empty();
+}
+
+// Logs stay in the spool until the chunk is committed so that failed uploads are retried later
+XmlLogsRetriever::Logs XmlLogsRetriever::retrieveLogs(size_t maxSize)
 {
-    auto&& xmlLogsRepo = XmlLogsRepo::get();
     Log::logger()->flush();
 
-    auto logs = formatLogs(xmlLogsRepo.buffer());
-    xmlLogsRepo.clear();
-    return logs;
+    auto chunk = XmlLogsRepo::get().read(maxSize);
+    if (chunk.data.empty()) return {};
+
+    return Logs{formatLogs(chunk.data), chunk.end};
 }
 
+void XmlLogsRetriever::commit(const Logs& logs)
+{
+    XmlLogsRepo::get().commit(logs.cursor);
+}
+
+// Log entries are escaped by the sink so the buffer can be embedded as is
 std::string XmlLogsRetriever::formatLogs(const std::string& logs)
 {
-    XmlNode formattedLogsNode;
-
-    try
-    {
-        auto logsNode = Parsing::xmlFrom(logs);
-        formattedLogsNode.add_child("logs", logsNode);
-
-        return Parsing::xmlTreeToString(formattedLogsNode);
-    }
-    catch (std::exception& e)
-    {
-        Log::error("[XmlLogsRetriever] Format logs error: {}", e.what());
-        Log::trace("[XmlLogsRetriever] {}", logs);
-    }
-
-    return {};
+    XmlWriter writer{logs.size() + LogsWrapperSize};
+
+    writer.declaration().startElement("logs").raw(logs).endElement();
+
+    return writer.release();
 }
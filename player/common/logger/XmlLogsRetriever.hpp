@@ -1,11 +1,21 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 class XmlLogsRetriever
 {
 public:
-    std::string retrieveLogs();
+    struct Logs
+    {
+        std::string xml;
+        uint64_t cursor = 0;
+
+        bool empty() const;
+    };
+
+    Logs retrieveLogs(size_t maxSize);
+    void commit(const Logs& logs);
 
 private:
     std::string formatLogs(const std::string& logs);
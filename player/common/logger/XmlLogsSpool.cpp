@@ -0,0 +1,193 @@
+#include "XmlLogsSpool.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+const uint32_t SpoolMagic = 0x584c5350;  // "XLSP"
+const uint32_t SpoolVersion = 1;
+using RecordLength = uint32_t;
+
+struct XmlLogsSpool::Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    uint64_t writePos;
+    uint64_t readPos;
+};
+
+XmlLogsSpool::XmlLogsSpool(size_t capacity)
+{
+    map(-1, capacity);
+    reset(capacity);
+}
+
+XmlLogsSpool::XmlLogsSpool(const std::string& path, size_t capacity)
+{
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd == -1) throw std::runtime_error{"failed to open log spool " + path + ": " + std::strerror(errno)};
+
+    if (::ftruncate(fd, static_cast<off_t>(sizeof(Header) + capacity)) == -1)
+    {
+        ::close(fd);
+        throw std::runtime_error{"failed to resize log spool " + path + ": " + std::strerror(errno)};
+    }
+
+    map(fd, capacity);
+    ::close(fd);
+
+    if (!valid(capacity))
+    {
+        reset(capacity);
+    }
+}
+
+XmlLogsSpool::~XmlLogsSpool()
+{
+    if (mapping_)
+    {
+        ::msync(mapping_, mappingSize_, MS_ASYNC);
+        ::munmap(mapping_, mappingSize_);
+    }
+}
+
+void XmlLogsSpool::map(int fd, size_t capacity)
+{
+    mappingSize_ = sizeof(Header) + capacity;
+
+    int flags = fd == -1 ? MAP_PRIVATE | MAP_ANONYMOUS : MAP_SHARED;
+    mapping_ = ::mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE, flags, fd, 0);
+    if (mapping_ == MAP_FAILED)
+    {
+        mapping_ = nullptr;
+        throw std::runtime_error{std::string{"failed to map log spool: "} + std::strerror(errno)};
+    }
+
+    header_ = static_cast<Header*>(mapping_);
+    data_ = static_cast<char*>(mapping_) + sizeof(Header);
+}
+
+void XmlLogsSpool::reset(size_t capacity)
+{
+    header_->magic = SpoolMagic;
+    header_->version = SpoolVersion;
+    header_->capacity = capacity;
+    header_->writePos = 0;
+    header_->readPos = 0;
+}
+
+bool XmlLogsSpool::valid(size_t capacity) const
+{
+    if (header_->magic != SpoolMagic || header_->version != SpoolVersion || header_->capacity != capacity ||
+        header_->readPos > header_->writePos || header_->writePos - header_->readPos > capacity)
+        return false;
+
+    uint64_t position = header_->readPos;
+    while (position < header_->writePos)
+    {
+        position += sizeof(RecordLength) + recordSize(position);
+    }
+    return position == header_->writePos;
+}
+
+void XmlLogsSpool::append(std::string_view record)
+{
+    const size_t required = sizeof(RecordLength) + record.size();
+    if (required > header_->capacity)
+    {
+        droppedBytes_ += record.size();
+        return;
+    }
+
+    while (header_->capacity - size() < required)
+    {
+        dropOldest();
+    }
+
+    RecordLength length = static_cast<RecordLength>(record.size());
+    copyTo(header_->writePos, reinterpret_cast<const char*>(&length), sizeof(length));
+    copyTo(header_->writePos + sizeof(length), record.data(), record.size());
+    header_->writePos += required;
+}
+
+// Returns whole records starting from the upload cursor. The first record is always included
+// even if it exceeds maxSize so that the cursor can make progress.
+XmlLogsSpool::Chunk XmlLogsSpool::read(size_t maxSize) const
+{
+    Chunk chunk;
+    uint64_t position = header_->readPos;
+
+    while (position < header_->writePos)
+    {
+        auto length = recordSize(position);
+        if (!chunk.data.empty() && chunk.data.size() + length > maxSize) break;
+
+        auto offset = chunk.data.size();
+        chunk.data.resize(offset + length);
+        copyFrom(position + sizeof(RecordLength), chunk.data.data() + offset, length);
+        position += sizeof(RecordLength) + length;
+    }
+    chunk.end = position;
+
+    return chunk;
+}
+
+void XmlLogsSpool::commit(uint64_t position)
+{
+    // records could have been overwritten in the meantime and the cursor moved past the position
+    if (position > header_->readPos && position <= header_->writePos)
+    {
+        header_->readPos = position;
+        ::msync(mapping_, sizeof(Header), MS_ASYNC);
+    }
+}
+
+bool XmlLogsSpool::empty() const
+{
+    return header_->readPos == header_->writePos;
+}
+
+size_t XmlLogsSpool::size() const
+{
+    return static_cast<size_t>(header_->writePos - header_->readPos);
+}
+
+uint64_t XmlLogsSpool::droppedBytes() const
+{
+    return droppedBytes_;
+}
+
+void XmlLogsSpool::dropOldest()
+{
+    auto length = recordSize(header_->readPos);
+    header_->readPos += sizeof(RecordLength) + length;
+    droppedBytes_ += length;
+}
+
+uint32_t XmlLogsSpool::recordSize(uint64_t position) const
+{
+    RecordLength length;
+    copyFrom(position, reinterpret_cast<char*>(&length), sizeof(length));
+    return length;
+}
+
+void XmlLogsSpool::copyFrom(uint64_t position, char* out, size_t size) const
+{
+    size_t offset = position % header_->capacity;
+    size_t firstPart = std::min<size_t>(size, header_->capacity - offset);
+
+    std::memcpy(out, data_ + offset, firstPart);
+    std::memcpy(out + firstPart, data_, size - firstPart);
+}
+
+void XmlLogsSpool::copyTo(uint64_t position, const char* in, size_t size)
+{
+    size_t offset = position % header_->capacity;
+    size_t firstPart = std::min<size_t>(size, header_->capacity - offset);
+
+    std::memcpy(data_ + offset, in, firstPart);
+    std::memcpy(data_, in + firstPart, size - firstPart);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Circular storage of formatted log records inside a memory mapping. When backed by a file
+// the records and the upload cursor survive restarts; otherwise an anonymous mapping is used.
+// Positions are monotonic byte counters, the data offset is position % capacity.
+class XmlLogsSpool
+{
+    struct Header;
+
+public:
+    struct Chunk
+    {
+        std::string data;
+        uint64_t end = 0;
+    };
+
+    explicit XmlLogsSpool(size_t capacity);
+    XmlLogsSpool(const std::string& path, size_t capacity);
+    ~XmlLogsSpool();
+
+    XmlLogsSpool(const XmlLogsSpool&) = delete;
+    XmlLogsSpool& operator=(const XmlLogsSpool&) = delete;
+
+    void append(std::string_view record);
+    Chunk read(size_t maxSize) const;
+    void commit(uint64_t position);
+    bool empty() const;
+    size_t size() const;
+    uint64_t droppedBytes() const;
+
+private:
+    void map(int fd, size_t capacity);
+    void reset(size_t capacity);
+    bool valid(size_t capacity) const;
+    void dropOldest();
+    void copyFrom(uint64_t position, char* out, size_t size) const;
+    void copyTo(uint64_t position, const char* in, size_t size);
+    uint32_t recordSize(uint64_t position) const;
+
+private:
+    void* mapping_ = nullptr;
+    size_t mappingSize_ = 0;
+    Header* header_ = nullptr;
+    char* data_ = nullptr;
+    uint64_t droppedBytes_ = 0;
+};
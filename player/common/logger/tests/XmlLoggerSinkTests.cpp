@@ -0,0 +1,118 @@
+#include "common/logger/XmlLoggerSink.hpp"
+
+#include <gtest/gtest.h>
+#include <spdlog/logger.h>
+
+const size_t MaxMessageSize = 4096;
+
+class XmlLoggerSinkTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        takeLogs();
+        sink_ = std::make_shared<XmlLoggerSink>(XmlLogsRepo::get());
+        logger_ = std::make_shared<spdlog::logger>("test", sink_);
+        logger_->set_level(spdlog::level::trace);
+    }
+
+    void TearDown() override
+    {
+        logger_.reset();
+        sink_.reset();
+        takeLogs();
+    }
+
+    static std::string takeLogs()
+    {
+        auto&& repo = XmlLogsRepo::get();
+        auto chunk = repo.read(std::numeric_limits<size_t>::max());
+        repo.commit(chunk.end);
+        return chunk.data;
+    }
+
+    static std::string messageOf(const std::string& logs)
+    {
+        auto start = logs.find("<message>");
+        auto end = logs.find("</message>");
+        if (start == std::string::npos || end == std::string::npos) return {};
+
+        start += std::string_view{"<message>"}.size();
+        return logs.substr(start, end - start);
+    }
+
+    std::shared_ptr<XmlLoggerSink> sink_;
+    std::shared_ptr<spdlog::logger> logger_;
+};
+
+static bool validUtf8(const std::string& text)
+{
+    for (size_t i = 0; i < text.size();)
+    {
+        auto lead = static_cast<unsigned char>(text[i]);
+        size_t length = lead < 0x80 ? 1 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 0;
+        if (length == 0 || i + length > text.size()) return false;
+
+        for (size_t j = 1; j != length; ++j)
+        {
+            if ((static_cast<unsigned char>(text[i + j]) & 0xC0) != 0x80) return false;
+        }
+        i += length;
+    }
+    return true;
+}
+
+TEST_F(XmlLoggerSinkTest, FlushWritesQueuedMessages)
+{
+    for (int i = 0; i != 100; ++i)
+    {
+        logger_->info("Message {}", i);
+    }
+    logger_->error("Last <error>");
+    logger_->flush();
+
+    auto logs = takeLogs();
+    ASSERT_NE(logs.find("<message>Message 0</message>"), std::string::npos);
+    ASSERT_NE(logs.find("<message>Message 99</message>"), std::string::npos);
+    ASSERT_NE(logs.find(R"(category="error"><thread>)"), std::string::npos);
+    ASSERT_NE(logs.find("<message>Last &lt;error&gt;</message>"), std::string::npos);
+}
+
+TEST_F(XmlLoggerSinkTest, FlushWithoutMessages)
+{
+    logger_->flush();
+
+    ASSERT_TRUE(takeLogs().empty());
+}
+
+TEST_F(XmlLoggerSinkTest, LongMessageTruncated)
+{
+    logger_->info(std::string(MaxMessageSize + 100, 'a'));
+    logger_->flush();
+
+    ASSERT_EQ(messageOf(takeLogs()), std::string(MaxMessageSize, 'a'));
+}
+
+TEST_F(XmlLoggerSinkTest, LongMessageTruncatedAtCodePoint)
+{
+    // two-, three- and four-byte sequences, shifted so that the limit falls inside each of their bytes
+    for (auto character : {"\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"})
+    {
+        for (size_t shift = 0; shift != 4; ++shift)
+        {
+            std::string message(shift, 'a');
+            while (message.size() < MaxMessageSize + 8)
+            {
+                message += character;
+            }
+            logger_->info(message);
+            logger_->flush();
+
+            auto logged = messageOf(takeLogs());
+            ASSERT_LE(logged.size(), MaxMessageSize);
+            ASSERT_GT(logged.size(), MaxMessageSize - 4);
+            ASSERT_TRUE(validUtf8(logged)) << character << " " << shift;
+            ASSERT_EQ(message.compare(0, logged.size(), logged), 0);
+        }
+    }
+}
@@ -15,10 +15,24 @@ XmlNode Parsing::xmlFrom(const FilePath& xlfPath)
     return tree;
 }
 
-XmlNode Parsing::xmlFrom(const std::string& xml)
+namespace
 {
-    std::stringstream stream;
-    stream << xml;
+    // Lets the parser read a buffer in place instead of copying it into a stringstream first
+    class ViewStreamBuffer : public std::streambuf
+    {
+    public:
+        explicit ViewStreamBuffer(std::string_view view)
+        {
+            auto begin = const_cast<char*>(view.data());
+            setg(begin, begin, begin + view.size());
+        }
+    };
+}
+
+XmlNode Parsing::xmlFrom(std::string_view xml)
+{
+    ViewStreamBuffer buffer{xml};
+    std::istream stream{&buffer};
     XmlNode tree;
     boost::property_tree::read_xml(stream, tree);
     return tree;
@@ -2,6 +2,8 @@
 
 #include <boost/property_tree/ptree.hpp>
 
+#include <string_view>
+
 class FilePath;
 using XmlNode = boost::property_tree::ptree;
 using JsonNode = boost::property_tree::ptree;
@@ -10,7 +12,7 @@ using NodePath = boost::property_tree::path;
 namespace Parsing
 {
     XmlNode xmlFrom(const FilePath& xlfPath);
-    XmlNode xmlFrom(const std::string& xml);
+    XmlNode xmlFrom(std::string_view xml);
     JsonNode jsonFromString(const std::string& json);
     std::string jsonToString(const JsonNode& tree);
     std::string xmlTreeToString(const XmlNode& node);
@@ -0,0 +1,325 @@
+#include "XmlReader.hpp"
+
+#include <algorithm>
+
+const std::string_view Spaces = " \t\r\n";
+
+XmlReader::XmlReader(std::string_view xml) : xml_(xml) {}
+
+XmlReader::Node XmlReader::next()
+{
+    if (pendingEnd_)
+    {
+        pendingEnd_ = false;
+        openElements_.pop_back();
+        return node_ = Node::EndElement;
+    }
+
+    while (pos_ < xml_.size())
+    {
+        if (xml_[pos_] != '<')
+        {
+            parseText();
+            if (openElements_.empty()) continue;  // whitespace around the root element
+            return node_ = Node::Text;
+        }
+
+        auto markup = xml_.substr(pos_, 9);
+        if (markup.substr(0, 2) == "</")
+        {
+            parseEndElement();
+            return node_ = Node::EndElement;
+        }
+        else if (markup == "<![CDATA[")
+        {
+            parseCData();
+            return node_ = Node::Text;
+        }
+        else if (markup.substr(0, 4) == "<!--")
+        {
+            skipPast("-->");
+        }
+        else if (markup.substr(0, 2) == "<?" || markup.substr(0, 2) == "<!")
+        {
+            skipPast(">");
+        }
+        else
+        {
+            parseStartElement();
+            return node_ = Node::StartElement;
+        }
+    }
+
+    if (!openElements_.empty()) throw Error{"XmlReader", "Unexpected end of document"};
+
+    return node_ = Node::End;
+}
+
+// Moves to the next direct child of the element opened at parentDepth. Returns false once that
+// element is closed; unread descendants of previous children are skipped.
+bool XmlReader::nextChild(size_t parentDepth)
+{
+    while (true)
+    {
+        switch (next())
+        {
+            case Node::StartElement:
+                if (depth() == parentDepth + 1) return true;
+                break;
+            case Node::EndElement:
+                if (depth() < parentDepth) return false;
+                break;
+            case Node::Text: break;
+            case Node::End: return false;
+        }
+    }
+}
+
+void XmlReader::skipElement()
+{
+    auto elementDepth = depth();
+    while (next() != Node::End)
+    {
+        if (node_ == Node::EndElement && depth() < elementDepth) return;
+    }
+}
+
+std::string XmlReader::readText()
+{
+    std::string result;
+
+    auto elementDepth = depth();
+    while (next() != Node::End)
+    {
+        if (node_ == Node::Text)
+        {
+            if (textEscaped_)
+                unescape(result, text_);
+            else
+                result.append(text_);
+        }
+        else if (node_ == Node::EndElement && depth() < elementDepth)
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+std::string_view XmlReader::name() const
+{
+    return name_;
+}
+
+std::string_view XmlReader::localName() const
+{
+    auto prefixEnd = name_.find(':');
+    return prefixEnd == std::string_view::npos ? name_ : name_.substr(prefixEnd + 1);
+}
+
+size_t XmlReader::depth() const
+{
+    return openElements_.size();
+}
+
+size_t XmlReader::offset() const
+{
+    return pos_;
+}
+
+std::string XmlReader::text() const
+{
+    if (!textEscaped_) return std::string{text_};
+
+    std::string result;
+    unescape(result, text_);
+    return result;
+}
+
+std::optional<std::string> XmlReader::attribute(std::string_view name) const
+{
+    auto value = rawAttribute(name);
+    if (!value) return {};
+
+    std::string result;
+    unescape(result, *value);
+    return result;
+}
+
+std::string XmlReader::requiredAttribute(std::string_view name) const
+{
+    auto value = attribute(name);
+    if (!value) throw Error{"XmlReader", "Missing attribute " + std::string{name}};
+
+    return std::move(*value);
+}
+
+std::optional<std::string_view> XmlReader::rawAttribute(std::string_view name) const
+{
+    auto it = std::find_if(attributes_.begin(), attributes_.end(), [name](auto&& attr) { return attr.first == name; });
+    if (it == attributes_.end()) return {};
+
+    return it->second;
+}
+
+void XmlReader::unescape(std::string& out, std::string_view text)
+{
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        auto amp = text.find('&', pos);
+        out.append(text.substr(pos, amp - pos));
+        if (amp == std::string_view::npos) return;
+
+        auto semicolon = text.find(';', amp);
+        if (semicolon == std::string_view::npos) throw Error{"XmlReader", "Unterminated entity"};
+
+        auto entity = text.substr(amp + 1, semicolon - amp - 1);
+        if (entity == "lt")
+            out += '<';
+        else if (entity == "gt")
+            out += '>';
+        else if (entity == "amp")
+            out += '&';
+        else if (entity == "quot")
+            out += '"';
+        else if (entity == "apos")
+            out += '\'';
+        else if (entity.size() > 1 && entity[0] == '#')
+        {
+            bool hex = entity[1] == 'x' || entity[1] == 'X';
+            auto digits = entity.substr(hex ? 2 : 1);
+            unsigned int code = 0;
+            auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), code, hex ? 16 : 10);
+            if (ec != std::errc{} || end != digits.data() + digits.size())
+                throw Error{"XmlReader", "Invalid character reference"};
+
+            // UTF-8 encoding of the code point
+            if (code < 0x80)
+                out += static_cast<char>(code);
+            else if (code < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else if (code < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (code >> 18));
+                out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+        else
+        {
+            throw Error{"XmlReader", "Unknown entity " + std::string{entity}};
+        }
+        pos = semicolon + 1;
+    }
+}
+
+void XmlReader::parseStartElement()
+{
+    ++pos_;  // <
+    name_ = parseName();
+    attributes_.clear();
+
+    while (true)
+    {
+        skipSpaces();
+        if (pos_ >= xml_.size()) throw Error{"XmlReader", "Unterminated start tag"};
+
+        if (xml_[pos_] == '>')
+        {
+            ++pos_;
+            break;
+        }
+        if (xml_.compare(pos_, 2, "/>") == 0)
+        {
+            pos_ += 2;
+            pendingEnd_ = true;
+            break;
+        }
+
+        auto attrName = parseName();
+        skipSpaces();
+        if (pos_ >= xml_.size() || xml_[pos_] != '=') throw Error{"XmlReader", "Expected '=' after attribute name"};
+        ++pos_;
+        skipSpaces();
+        if (pos_ >= xml_.size() || (xml_[pos_] != '"' && xml_[pos_] != '\'')) throw Error{"XmlReader", "Expected quote"};
+
+        auto quote = xml_[pos_++];
+        auto valueEnd = xml_.find(quote, pos_);
+        if (valueEnd == std::string_view::npos) throw Error{"XmlReader", "Unterminated attribute value"};
+
+        attributes_.emplace_back(attrName, xml_.substr(pos_, valueEnd - pos_));
+        pos_ = valueEnd + 1;
+    }
+
+    openElements_.push_back(name_);
+}
+
+void XmlReader::parseEndElement()
+{
+    pos_ += 2;  // </
+    name_ = parseName();
+    skipSpaces();
+    if (pos_ >= xml_.size() || xml_[pos_] != '>') throw Error{"XmlReader", "Unterminated end tag"};
+    ++pos_;
+
+    if (openElements_.empty() || openElements_.back() != name_)
+        throw Error{"XmlReader", "Mismatched end tag " + std::string{name_}};
+    openElements_.pop_back();
+}
+
+void XmlReader::parseText()
+{
+    auto end = std::min(xml_.find('<', pos_), xml_.size());
+    text_ = xml_.substr(pos_, end - pos_);
+    textEscaped_ = true;
+    pos_ = end;
+
+    if (openElements_.empty() && text_.find_first_not_of(Spaces) != std::string_view::npos)
+        throw Error{"XmlReader", "Text outside of root element"};
+}
+
+void XmlReader::parseCData()
+{
+    pos_ += 9;  // <![CDATA[
+    auto end = xml_.find("]]>", pos_);
+    if (end == std::string_view::npos) throw Error{"XmlReader", "Unterminated CDATA section"};
+
+    text_ = xml_.substr(pos_, end - pos_);
+    textEscaped_ = false;
+    pos_ = end + 3;
+}
+
+void XmlReader::skipPast(std::string_view terminator)
+{
+    auto end = xml_.find(terminator, pos_);
+    if (end == std::string_view::npos) throw Error{"XmlReader", "Unterminated markup"};
+
+    pos_ = end + terminator.size();
+}
+
+void XmlReader::skipSpaces()
+{
+    pos_ = std::min(xml_.find_first_not_of(Spaces, pos_), xml_.size());
+}
+
+std::string_view XmlReader::parseName()
+{
+    auto end = std::min(xml_.find_first_of(" \t\r\n/>=", pos_), xml_.size());
+    if (end == pos_) throw Error{"XmlReader", "Expected name"};
+
+    auto name = xml_.substr(pos_, end - pos_);
+    pos_ = end;
+    return name;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "common/PlayerRuntimeError.hpp"
+
+#include <charconv>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Forward-only pull parser over an in-memory document. Element names and attribute values are
+// views into the source so large documents can be decoded straight into domain objects without
+// building a property tree. Only the subset of XML produced by the CMS is supported (no DTDs).
+class XmlReader
+{
+public:
+    struct Error : PlayerRuntimeError
+    {
+        using PlayerRuntimeError::PlayerRuntimeError;
+    };
+
+    enum class Node
+    {
+        StartElement,
+        EndElement,
+        Text,
+        End
+    };
+
+    explicit XmlReader(std::string_view xml);
+
+    Node next();
+    bool nextChild(size_t parentDepth);
+    void skipElement();
+    std::string readText();
+
+    std::string_view name() const;
+    std::string_view localName() const;
+    size_t depth() const;
+    // position in the document right after the current node
+    size_t offset() const;
+    std::string text() const;
+
+    std::optional<std::string> attribute(std::string_view name) const;
+    std::string requiredAttribute(std::string_view name) const;
+
+    template <typename T>
+    T attribute(std::string_view name) const
+    {
+        auto value = rawAttribute(name);
+        if (!value) throw Error{"XmlReader", "Missing attribute " + std::string{name}};
+
+        T result{};
+        auto [end, ec] = std::from_chars(value->data(), value->data() + value->size(), result);
+        if (ec != std::errc{} || end != value->data() + value->size())
+            throw Error{"XmlReader", "Invalid value of attribute " + std::string{name}};
+
+        return result;
+    }
+
+    static void unescape(std::string& out, std::string_view text);
+
+private:
+    std::optional<std::string_view> rawAttribute(std::string_view name) const;
+    void parseStartElement();
+    void parseEndElement();
+    void parseText();
+    void parseCData();
+    void skipPast(std::string_view terminator);
+    void skipSpaces();
+    std::string_view parseName();
+
+private:
+    std::string_view xml_;
+    size_t pos_ = 0;
+    Node node_ = Node::End;
+    std::string_view name_;
+    std::string_view text_;
+    bool textEscaped_ = false;
+    bool pendingEnd_ = false;
+    std::vector<std::pair<std::string_view, std::string_view>> attributes_;
+    std::vector<std::string_view> openElements_;
+};
@@ -0,0 +1,129 @@
+#include "XmlWriter.hpp"
+
+#include <cassert>
+
+XmlWriter::XmlWriter(size_t reserved)
+{
+    buffer_.reserve(reserved);
+}
+
+XmlWriter& XmlWriter::declaration()
+{
+    buffer_.append(R"(<?xml version="1.0" encoding="utf-8"?>)");
+    return *this;
+}
+
+XmlWriter& XmlWriter::startElement(std::string_view name)
+{
+    closeStartTag();
+
+    buffer_.push_back('<');
+    buffer_.append(name);
+    openElements_.emplace_back(name);
+    startTagOpen_ = true;
+
+    return *this;
+}
+
+XmlWriter& XmlWriter::endElement()
+{
+    assert(!openElements_.empty());
+
+    if (startTagOpen_)
+    {
+        buffer_.append("/>");
+        startTagOpen_ = false;
+    }
+    else
+    {
+        buffer_.append("</");
+        buffer_.append(openElements_.back());
+        buffer_.push_back('>');
+    }
+    openElements_.pop_back();
+
+    return *this;
+}
+
+XmlWriter& XmlWriter::attribute(std::string_view name, std::string_view value)
+{
+    assert(startTagOpen_);
+
+    buffer_.push_back(' ');
+    buffer_.append(name);
+    buffer_.append("=\"");
+    escape(buffer_, value);
+    buffer_.push_back('"');
+
+    return *this;
+}
+
+XmlWriter& XmlWriter::text(std::string_view value)
+{
+    closeStartTag();
+    escape(buffer_, value);
+    return *this;
+}
+
+XmlWriter& XmlWriter::raw(std::string_view xml)
+{
+    closeStartTag();
+    buffer_.append(xml);
+    return *this;
+}
+
+void XmlWriter::reserve(size_t size)
+{
+    buffer_.reserve(size);
+}
+
+size_t XmlWriter::size() const
+{
+    return buffer_.size();
+}
+
+const std::string& XmlWriter::string() const
+{
+    return buffer_;
+}
+
+std::string XmlWriter::release()
+{
+    assert(openElements_.empty());
+
+    std::string result = std::move(buffer_);
+    buffer_.clear();
+    startTagOpen_ = false;
+    return result;
+}
+
+void XmlWriter::escape(std::string& out, std::string_view text)
+{
+    size_t chunkBegin = 0;
+    for (size_t i = 0; i != text.size(); ++i)
+    {
+        std::string_view replacement;
+        switch (text[i])
+        {
+            case '&': replacement = "&amp;"; break;
+            case '<': replacement = "&lt;"; break;
+            case '>': replacement = "&gt;"; break;
+            case '"': replacement = "&quot;"; break;
+            case '\'': replacement = "&apos;"; break;
+            default: continue;
+        }
+        out.append(text.substr(chunkBegin, i - chunkBegin));
+        out.append(replacement);
+        chunkBegin = i + 1;
+    }
+    out.append(text.substr(chunkBegin));
+}
+
+void XmlWriter::closeStartTag()
+{
+    if (startTagOpen_)
+    {
+        buffer_.push_back('>');
+        startTagOpen_ = false;
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Forward-only XML writer which appends straight into a single output buffer.
+// Used for large payloads where building a property tree first is too expensive.
+class XmlWriter
+{
+public:
+    explicit XmlWriter(size_t reserved = 0);
+
+    XmlWriter& declaration();
+    XmlWriter& startElement(std::string_view name);
+    XmlWriter& endElement();
+    XmlWriter& attribute(std::string_view name, std::string_view value);
+    XmlWriter& text(std::string_view value);
+    XmlWriter& raw(std::string_view xml);
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    XmlWriter& attribute(std::string_view name, T value)
+    {
+        char digits[24];
+        auto [end, ec] = std::to_chars(std::begin(digits), std::end(digits), static_cast<long long>(value));
+        static_cast<void>(ec);
+        return attribute(name, std::string_view{digits, static_cast<size_t>(end - digits)});
+    }
+
+    void reserve(size_t size);
+    size_t size() const;
+    const std::string& string() const;
+    std::string release();
+
+    static void escape(std::string& out, std::string_view text);
+
+private:
+    void closeStartTag();
+
+private:
+    std::string buffer_;
+    std::vector<std::string> openElements_;
+    bool startTagOpen_ = false;
+};
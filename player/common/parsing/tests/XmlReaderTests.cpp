@@ -0,0 +1,182 @@
+#include "common/parsing/XmlReader.hpp"
+
+#include <gtest/gtest.h>
+
+static std::string unescaped(std::string_view text)
+{
+    std::string result;
+    XmlReader::unescape(result, text);
+    return result;
+}
+
+// Reads the whole document and returns the names of the elements as they are opened and closed
+static std::vector<std::string> events(std::string_view xml)
+{
+    std::vector<std::string> result;
+
+    XmlReader reader{xml};
+    while (true)
+    {
+        switch (reader.next())
+        {
+            case XmlReader::Node::StartElement: result.push_back("<" + std::string{reader.name()}); break;
+            case XmlReader::Node::EndElement: result.push_back("/" + std::string{reader.name()}); break;
+            case XmlReader::Node::Text: result.push_back(reader.text()); break;
+            case XmlReader::Node::End: return result;
+        }
+    }
+}
+
+TEST(XmlReader, Unescape)
+{
+    ASSERT_EQ(unescaped(""), "");
+    ASSERT_EQ(unescaped("plain"), "plain");
+    ASSERT_EQ(unescaped("&lt;a&gt; &amp; &quot;b&quot; &apos;c&apos;"), "<a> & \"b\" 'c'");
+    ASSERT_EQ(unescaped("&#65;&#x42;&#X43;"), "ABC");
+    ASSERT_EQ(unescaped("&#xE9;"), "\xC3\xA9");
+    ASSERT_EQ(unescaped("&#x20AC;"), "\xE2\x82\xAC");
+    ASSERT_EQ(unescaped("&#x1F600;"), "\xF0\x9F\x98\x80");
+}
+
+TEST(XmlReader, UnescapeAppends)
+{
+    std::string result = "a";
+    XmlReader::unescape(result, "&amp;b");
+
+    ASSERT_EQ(result, "a&b");
+}
+
+TEST(XmlReader, UnescapeInvalid)
+{
+    ASSERT_THROW(unescaped("a & b"), XmlReader::Error);
+    ASSERT_THROW(unescaped("&nbsp;"), XmlReader::Error);
+    ASSERT_THROW(unescaped("&#;"), XmlReader::Error);
+    ASSERT_THROW(unescaped("&#x12G;"), XmlReader::Error);
+    ASSERT_THROW(unescaped("&#12a;"), XmlReader::Error);
+}
+
+TEST(XmlReader, Nodes)
+{
+    auto xml = R"(<?xml version="1.0"?>
+<!-- comment --><root><a>text</a><b/><!-- inside --><c><![CDATA[<raw> &amp;]]></c></root>
+)";
+
+    ASSERT_EQ(events(xml),
+              (std::vector<std::string>{"<root", "<a", "text", "/a", "<b", "/b", "<c", "<raw> &amp;", "/c", "/root"}));
+}
+
+TEST(XmlReader, NamesAndDepth)
+{
+    XmlReader reader{"<ns:root><ns:child/></ns:root>"};
+
+    ASSERT_EQ(reader.next(), XmlReader::Node::StartElement);
+    EXPECT_EQ(reader.name(), "ns:root");
+    EXPECT_EQ(reader.localName(), "root");
+    EXPECT_EQ(reader.depth(), 1);
+    ASSERT_EQ(reader.next(), XmlReader::Node::StartElement);
+    EXPECT_EQ(reader.localName(), "child");
+    EXPECT_EQ(reader.depth(), 2);
+    ASSERT_EQ(reader.next(), XmlReader::Node::EndElement);
+    EXPECT_EQ(reader.depth(), 1);
+    ASSERT_EQ(reader.next(), XmlReader::Node::EndElement);
+    EXPECT_EQ(reader.depth(), 0);
+    ASSERT_EQ(reader.next(), XmlReader::Node::End);
+}
+
+TEST(XmlReader, Attributes)
+{
+    XmlReader reader{R"(<file id="42" size = '1000' name="a &amp; b.png" empty="" type="media"/>)"};
+    reader.next();
+
+    EXPECT_EQ(reader.attribute<int>("id"), 42);
+    EXPECT_EQ(reader.attribute<size_t>("size"), 1000);
+    EXPECT_EQ(reader.attribute("name").value_or(""), "a & b.png");
+    EXPECT_EQ(reader.attribute("empty").value_or("-"), "");
+    EXPECT_EQ(reader.requiredAttribute("type"), "media");
+    EXPECT_FALSE(reader.attribute("missing"));
+}
+
+TEST(XmlReader, InvalidAttributes)
+{
+    XmlReader reader{R"(<file id="4x" size="" negative="-1" big="99999999999"/>)"};
+    reader.next();
+
+    EXPECT_THROW(reader.attribute<int>("id"), XmlReader::Error);
+    EXPECT_THROW(reader.attribute<int>("size"), XmlReader::Error);
+    EXPECT_THROW(reader.attribute<int>("missing"), XmlReader::Error);
+    EXPECT_THROW(reader.attribute<size_t>("negative"), XmlReader::Error);
+    EXPECT_THROW(reader.attribute<int>("big"), XmlReader::Error);
+    EXPECT_THROW(reader.requiredAttribute("missing"), XmlReader::Error);
+}
+
+TEST(XmlReader, NextChildSkipsDescendants)
+{
+    XmlReader reader{"<files><file id='1'><deep><deeper/></deep>text</file><file id='2'/>"
+                     "<other><file id='3'/></other><file id='4'></file></files>"};
+
+    ASSERT_TRUE(reader.nextChild(0));
+    auto depth = reader.depth();
+
+    std::vector<std::string> children;
+    while (reader.nextChild(depth))
+    {
+        children.push_back(std::string{reader.name()} + reader.attribute("id").value_or(""));
+    }
+
+    ASSERT_EQ(children, (std::vector<std::string>{"file1", "file2", "other", "file4"}));
+    ASSERT_EQ(reader.next(), XmlReader::Node::End);
+}
+
+TEST(XmlReader, NextChildOfEmptyElement)
+{
+    XmlReader reader{"<root><empty/><next/></root>"};
+
+    ASSERT_TRUE(reader.nextChild(0));
+    ASSERT_TRUE(reader.nextChild(1));
+    ASSERT_EQ(reader.name(), "empty");
+    ASSERT_FALSE(reader.nextChild(reader.depth()));
+    ASSERT_TRUE(reader.nextChild(1));
+    ASSERT_EQ(reader.name(), "next");
+    ASSERT_FALSE(reader.nextChild(reader.depth()));
+    ASSERT_FALSE(reader.nextChild(1));
+}
+
+TEST(XmlReader, ReadText)
+{
+    XmlReader reader{"<root><a>one &lt; <b>two</b><![CDATA[ &three]]></a><c>after</c></root>"};
+    reader.nextChild(0);
+    reader.nextChild(1);
+
+    ASSERT_EQ(reader.readText(), "one < two &three");
+    ASSERT_TRUE(reader.nextChild(1));
+    ASSERT_EQ(reader.name(), "c");
+}
+
+TEST(XmlReader, SkipElement)
+{
+    XmlReader reader{"<root><a><b><c/></b></a><d/></root>"};
+    reader.nextChild(0);
+    reader.nextChild(1);
+
+    reader.skipElement();
+
+    ASSERT_TRUE(reader.nextChild(1));
+    ASSERT_EQ(reader.name(), "d");
+}
+
+TEST(XmlReader, Malformed)
+{
+    ASSERT_THROW(events("<root>"), XmlReader::Error);
+    ASSERT_THROW(events("<root><a></root>"), XmlReader::Error);
+    ASSERT_THROW(events("<root></a>"), XmlReader::Error);
+    ASSERT_THROW(events("<root attr=value/>"), XmlReader::Error);
+    ASSERT_THROW(events("<root attr/>"), XmlReader::Error);
+    ASSERT_THROW(events("<root attr='value/>"), XmlReader::Error);
+    ASSERT_THROW(events("<root"), XmlReader::Error);
+    ASSERT_THROW(events("<root></root"), XmlReader::Error);
+    ASSERT_THROW(events("<>"), XmlReader::Error);
+    ASSERT_THROW(events("text<root/>"), XmlReader::Error);
+    ASSERT_THROW(events("<root><![CDATA[open</root>"), XmlReader::Error);
+    ASSERT_THROW(events("<root><!-- open</root>"), XmlReader::Error);
+    ASSERT_THROW(events("<root>a &bad; b</root>"), XmlReader::Error);
+}
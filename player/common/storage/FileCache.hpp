@@ -3,6 +3,11 @@
 #include "common/fs/FilePath.hpp"
 #include "common/storage/RequiredItems.hpp"
 
+#include <boost/optional/optional.hpp>
+#include <boost/signals2/signal.hpp>
+
+using SignalFileSaved = boost::signals2::signal<void(const std::string&)>;
+
 class FileCache
 {
 public:
@@ -14,8 +19,13 @@ public:
     virtual bool cached(const ResourceFile& file) const = 0;
     virtual bool cached(const std::string& filename, const Md5Hash& hash) const = 0;
     virtual std::vector<std::string> cachedFiles() const = 0;
+    // name of a valid file whose content has the given hash
+    virtual boost::optional<std::string> cachedFile(const Md5Hash& hash) const = 0;
     virtual std::vector<std::string> invalidFiles() const = 0;
     virtual void markAsInvalid(const std::string& filename) = 0;
     virtual void save(const std::string& filename, const std::string& content, const Md5Hash& hash) = 0;
     virtual void save(const std::string& filename, const std::string& content, const DateTime& lastUpdate) = 0;
+
+    // emitted with the file name after a new version has been written, from the downloading thread
+    virtual SignalFileSaved& fileSaved() = 0;
 };
@@ -79,6 +79,24 @@ std::vector<std::string> FileCacheImpl::cachedFiles() const
     return files;
 }
 
+// Called from the LAN sharing server threads while downloads update the cache
+boost::optional<std::string> FileCacheImpl::cachedFile(const Md5Hash& hash) const
+{
+    boost::unique_lock<boost::mutex> lock{fileCacheMutex_};
+
+    if (auto root = fileCache_.get_child_optional(RootNode / FilesNode))
+    {
+        for (auto&& [name, node] : root.value())
+        {
+            if (node.get<bool>(ValidAttr, false) && Md5Hash{node.get<std::string>(Md5Attr, {})} == hash)
+            {
+                return name;
+            }
+        }
+    }
+    return {};
+}
+
 std::vector<std::string> FileCacheImpl::invalidFiles() const
 {
     std::vector<std::string> files;
@@ -102,6 +120,7 @@ void FileCacheImpl::save(const std::string& fileName, const std::string& fileCon
     FileSystem::writeToFile(path, fileContent);
 
     addToCache(fileName, Md5Hash::fromString(fileContent), hash);
+    fileSaved_(fileName);
 }
 
 void FileCacheImpl::save(const std::string& fileName, const std::string& fileContent, const DateTime& lastUpdate)
@@ -111,6 +130,7 @@ void FileCacheImpl::save(const std::string& fileName, const std::string& fileCon
     FileSystem::writeToFile(path, fileContent);
 
     addToCache(fileName, Md5Hash::fromString(fileContent), lastUpdate);
+    fileSaved_(fileName);
 }
 
 void FileCacheImpl::markAsInvalid(const std::string& filename)
@@ -123,6 +143,11 @@ void FileCacheImpl::markAsInvalid(const std::string& filename)
     }
 }
 
+SignalFileSaved& FileCacheImpl::fileSaved()
+{
+    return fileSaved_;
+}
+
 XmlDocVersion FileCacheImpl::currentVersion() const
 {
     return XmlDocVersion{"2"};
@@ -15,10 +15,12 @@ public:
     bool cached(const ResourceFile& file) const override;
     bool cached(const std::string& filename, const Md5Hash& hash) const override;
     std::vector<std::string> cachedFiles() const override;
+    boost::optional<std::string> cachedFile(const Md5Hash& hash) const override;
     std::vector<std::string> invalidFiles() const override;
     void save(const std::string& filename, const std::string& content, const Md5Hash& hash) override;
     void save(const std::string& filename, const std::string& content, const DateTime& lastUpdate) override;
     void markAsInvalid(const std::string& filename) override;
+    SignalFileSaved& fileSaved() override;
 
 protected:
     XmlDocVersion currentVersion() const override;
@@ -32,7 +34,8 @@ private:
     void saveFileHashes(const FilePath& path);
 
 private:
-    boost::mutex fileCacheMutex_;
+    mutable boost::mutex fileCacheMutex_;
     XmlNode fileCache_;
     FilePath cacheFile_;
+    SignalFileSaved fileSaved_;
 };
@@ -0,0 +1,71 @@
+#include "ByteRange.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <charconv>
+
+const std::string_view BytesUnit = "bytes=";
+// a client asking for more is either broken or trying to make the server do a lot of small writes
+const size_t MaxRanges = 16;
+
+static std::string_view trimmed(std::string_view value)
+{
+    auto first = value.find_first_not_of(" \t");
+    if (first == std::string_view::npos) return {};
+
+    return value.substr(first, value.find_last_not_of(" \t") - first + 1);
+}
+
+static boost::optional<uint64_t> parsePosition(std::string_view position)
+{
+    uint64_t value = 0;
+    auto [end, ec] = std::from_chars(position.data(), position.data() + position.size(), value);
+    if (position.empty() || ec != std::errc{} || end != position.data() + position.size()) return {};
+
+    return value;
+}
+
+boost::optional<ByteRanges> parseByteRanges(std::string_view header, uint64_t size)
+{
+    if (header.size() < BytesUnit.size() || !boost::iequals(header.substr(0, BytesUnit.size()), BytesUnit)) return {};
+
+    ByteRanges ranges;
+    size_t specs = 0;
+    for (auto rest = header.substr(BytesUnit.size()); !rest.empty();)
+    {
+        auto comma = rest.find(',');
+        auto spec = trimmed(rest.substr(0, comma));
+        rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+        if (spec.empty()) continue;
+        if (++specs > MaxRanges) return {};
+
+        auto dash = spec.find('-');
+        if (dash == std::string_view::npos) return {};
+
+        auto lastPosition = spec.substr(dash + 1);
+        if (dash == 0)
+        {
+            auto suffix = parsePosition(lastPosition);
+            if (!suffix) return {};
+
+            if (*suffix > 0 && size > 0)
+            {
+                auto length = std::min(*suffix, size);
+                ranges.push_back(ByteRange{size - length, length});
+            }
+            continue;
+        }
+
+        auto first = parsePosition(spec.substr(0, dash));
+        auto last = lastPosition.empty() ? boost::optional<uint64_t>{UINT64_MAX} : parsePosition(lastPosition);
+        if (!first || !last || *last < *first) return {};
+
+        if (*first < size)
+        {
+            ranges.push_back(ByteRange{*first, std::min(*last, size - 1) - *first + 1});
+        }
+    }
+    if (specs == 0) return {};
+
+    return ranges;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <boost/optional/optional.hpp>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+struct ByteRange
+{
+    uint64_t first;
+    uint64_t length;
+
+    bool operator==(const ByteRange& other) const
+    {
+        return first == other.first && length == other.length;
+    }
+};
+
+using ByteRanges = std::vector<ByteRange>;
+
+// Ranges of an HTTP Range header (RFC 7233) resolved against the size of the representation, e.g.
+// "bytes=0-499, -500". Nothing is returned for a header which isn't a valid byte range set or asks
+// for too many ranges, it should be ignored and the whole representation sent. An empty list means
+// that none of the ranges can be satisfied.
+boost::optional<ByteRanges> parseByteRanges(std::string_view header, uint64_t size);
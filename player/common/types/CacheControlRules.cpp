@@ -0,0 +1,49 @@
+#include "CacheControlRules.hpp"
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+const std::string AnyType = "*";
+
+CacheControlRules CacheControlRules::fromString(const std::string& rules)
+{
+    CacheControlRules result;
+
+    std::vector<std::string> entries;
+    boost::split(entries, rules, boost::is_any_of(";"));
+    for (auto&& entry : entries)
+    {
+        boost::trim(entry);
+        if (entry.empty()) continue;
+
+        // only the first '=' separates the type, values like max-age=60 contain their own
+        auto separator = entry.find('=');
+        if (separator == std::string::npos) throw Error{"CacheControlRules", "Invalid rule " + entry};
+
+        auto type = boost::to_lower_copy(boost::trim_copy(entry.substr(0, separator)));
+        auto value = boost::trim_copy(entry.substr(separator + 1));
+        if (type.empty() || value.empty()) throw Error{"CacheControlRules", "Invalid rule " + entry};
+
+        result.values_[type] = value;
+    }
+    return result;
+}
+
+const std::string& CacheControlRules::forType(std::string_view mimeType) const
+{
+    static const std::string None;
+
+    auto type = boost::to_lower_copy(std::string{mimeType.substr(0, mimeType.find(';'))});
+    if (auto it = values_.find(type); it != values_.end()) return it->second;
+
+    auto slash = type.find('/');
+    if (slash != std::string::npos)
+    {
+        if (auto it = values_.find(type.substr(0, slash) + "/*"); it != values_.end()) return it->second;
+    }
+
+    if (auto it = values_.find(AnyType); it != values_.end()) return it->second;
+    return None;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "common/PlayerRuntimeError.hpp"
+
+#include <map>
+#include <string>
+#include <string_view>
+
+// Cache-Control values by MIME type, e.g. "text/html=no-cache;image/*=max-age=86400;*=max-age=300".
+// An exact type wins over its "type/*" entry which wins over "*". Types without a matching entry get
+// no Cache-Control at all.
+class CacheControlRules
+{
+public:
+    struct Error : PlayerRuntimeError
+    {
+        using PlayerRuntimeError::PlayerRuntimeError;
+    };
+
+    CacheControlRules() = default;
+    static CacheControlRules fromString(const std::string& rules);
+
+    const std::string& forType(std::string_view mimeType) const;
+
+private:
+    std::map<std::string, std::string, std::less<>> values_;
+};
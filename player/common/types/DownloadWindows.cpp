@@ -0,0 +1,104 @@
+#include "DownloadWindows.hpp"
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+#include <charconv>
+
+const std::chrono::minutes MinutesPerDay{24 * 60};
+const uint64_t BytesPerKiB = 1024;
+
+DownloadWindows DownloadWindows::fromString(const std::string& schedule)
+{
+    DownloadWindows result;
+    result.string_ = schedule;
+
+    std::vector<std::string> windows;
+    boost::split(windows, schedule, boost::is_any_of(";"));
+    for (auto&& window : windows)
+    {
+        boost::trim(window);
+        if (window.empty()) continue;
+
+        result.windows_.push_back(parseWindow(window));
+    }
+    return result;
+}
+
+DownloadWindows::Tier DownloadWindows::tierAt(std::chrono::minutes timeOfDay) const
+{
+    if (windows_.empty()) return Tier{};
+
+    timeOfDay = timeOfDay % MinutesPerDay;
+    for (auto&& window : windows_)
+    {
+        if (window.contains(timeOfDay)) return Tier{true, window.bytesPerSecond};
+    }
+    return Tier{false, 0};
+}
+
+bool DownloadWindows::empty() const
+{
+    return windows_.empty();
+}
+
+const std::string& DownloadWindows::string() const
+{
+    return string_;
+}
+
+// Equal start and end cover the whole day
+bool DownloadWindows::Window::contains(std::chrono::minutes timeOfDay) const
+{
+    if (start < end) return timeOfDay >= start && timeOfDay < end;
+    if (start > end) return timeOfDay >= start || timeOfDay < end;
+    return true;
+}
+
+DownloadWindows::Window DownloadWindows::parseWindow(const std::string& window)
+{
+    auto rateSeparator = window.find('=');
+    auto range = window.substr(0, rateSeparator);
+
+    auto rangeSeparator = range.find('-');
+    if (rangeSeparator == std::string::npos) throw Error{"DownloadWindows", "Invalid window " + window};
+
+    Window result{parseTime(range.substr(0, rangeSeparator)), parseTime(range.substr(rangeSeparator + 1)), 0};
+    if (rateSeparator != std::string::npos)
+    {
+        auto rate = boost::trim_copy(window.substr(rateSeparator + 1));
+        uint64_t kibPerSecond = 0;
+        auto [end, ec] = std::from_chars(rate.data(), rate.data() + rate.size(), kibPerSecond);
+        if (rate.empty() || ec != std::errc{} || end != rate.data() + rate.size())
+            throw Error{"DownloadWindows", "Invalid rate " + rate};
+
+        result.bytesPerSecond = kibPerSecond * BytesPerKiB;
+    }
+    return result;
+}
+
+std::chrono::minutes DownloadWindows::parseTime(const std::string& time)
+{
+    auto trimmed = boost::trim_copy(time);
+
+    int hours = -1, minutes = -1;
+    auto colon = trimmed.find(':');
+    if (colon != std::string::npos)
+    {
+        auto [hoursEnd, hoursEc] = std::from_chars(trimmed.data(), trimmed.data() + colon, hours);
+        auto [minutesEnd, minutesEc] =
+            std::from_chars(trimmed.data() + colon + 1, trimmed.data() + trimmed.size(), minutes);
+        if (hoursEc != std::errc{} || hoursEnd != trimmed.data() + colon || minutesEc != std::errc{} ||
+            minutesEnd != trimmed.data() + trimmed.size())
+        {
+            hours = -1;
+        }
+    }
+
+    // 24:00 is accepted as the end of the day
+    bool valid = (hours >= 0 && hours < 24 && minutes >= 0 && minutes < 60) || (hours == 24 && minutes == 0);
+    if (!valid) throw Error{"DownloadWindows", "Invalid time " + time};
+
+    return (std::chrono::hours{hours} + std::chrono::minutes{minutes}) % MinutesPerDay;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "common/PlayerRuntimeError.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Times of day when content may be downloaded and how fast, e.g. "22:00-06:00;06:00-22:00=256".
+// Rates are in KiB/s and a window without one is unlimited. Windows may cross midnight and the
+// first matching one wins. Outside of all windows downloads are paused; an empty schedule allows
+// them at any time.
+class DownloadWindows
+{
+public:
+    struct Error : PlayerRuntimeError
+    {
+        using PlayerRuntimeError::PlayerRuntimeError;
+    };
+
+    struct Tier
+    {
+        bool allowed = true;
+        uint64_t bytesPerSecond = 0;  // 0 means unlimited
+
+        bool operator==(const Tier& other) const
+        {
+            return allowed == other.allowed && bytesPerSecond == other.bytesPerSecond;
+        }
+    };
+
+    DownloadWindows() = default;
+    static DownloadWindows fromString(const std::string& schedule);
+
+    Tier tierAt(std::chrono::minutes timeOfDay) const;
+    bool empty() const;
+    const std::string& string() const;
+
+private:
+    struct Window
+    {
+        std::chrono::minutes start;
+        std::chrono::minutes end;
+        uint64_t bytesPerSecond;
+
+        bool contains(std::chrono::minutes timeOfDay) const;
+    };
+
+    static Window parseWindow(const std::string& window);
+    static std::chrono::minutes parseTime(const std::string& time);
+
+private:
+    std::vector<Window> windows_;
+    std::string string_;
+};
@@ -0,0 +1,93 @@
+#include "HttpFreshness.hpp"
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <string>
+#include <vector>
+
+const std::chrono::seconds MaxHeuristicLifetime{24 * 60 * 60};
+const int HeuristicFraction = 10;
+
+static boost::optional<std::chrono::seconds> parseSeconds(std::string value)
+{
+    boost::trim_if(value, boost::is_any_of("\""));
+    if (value.empty() || !std::all_of(value.begin(), value.end(), ::isdigit)) return {};
+
+    try
+    {
+        return std::chrono::seconds{std::stoll(value)};
+    }
+    catch (std::exception&)
+    {
+        // too big to be anything but "forever"
+        return std::chrono::seconds{std::numeric_limits<int32_t>::max()};
+    }
+}
+
+boost::optional<HttpFreshness> httpFreshness(const HttpCachingFields& fields, std::time_t receivedAt)
+{
+    boost::optional<std::chrono::seconds> maxAge;
+    bool noCache = false;
+    bool staleAllowed = true;
+
+    std::vector<std::string> directives;
+    boost::split(directives, fields.cacheControl, boost::is_any_of(","));
+    for (auto&& directive : directives)
+    {
+        auto separator = directive.find('=');
+        auto name = boost::to_lower_copy(boost::trim_copy(directive.substr(0, separator)));
+        auto value = separator == std::string::npos ? std::string{} : boost::trim_copy(directive.substr(separator + 1));
+
+        if (name == "no-store") return {};
+        if (name == "no-cache") noCache = true;
+        if (name == "must-revalidate") staleAllowed = false;
+        // an invalid max-age makes the response stale
+        if (name == "max-age") maxAge = parseSeconds(value).value_or(std::chrono::seconds::zero());
+    }
+
+    if (noCache) return HttpFreshness{std::chrono::seconds::zero(), staleAllowed};
+    if (maxAge) return HttpFreshness{*maxAge, staleAllowed};
+
+    auto date = parseHttpDate(fields.date).value_or(receivedAt);
+    if (!fields.expires.empty())
+    {
+        // invalid values like "0" mean already expired
+        auto expires = parseHttpDate(fields.expires).value_or(date);
+        return HttpFreshness{std::chrono::seconds{std::max<std::time_t>(expires - date, 0)}, staleAllowed};
+    }
+
+    auto lastModified = parseHttpDate(fields.lastModified);
+    if (lastModified && *lastModified < date)
+    {
+        auto lifetime = std::chrono::seconds{(date - *lastModified) / HeuristicFraction};
+        return HttpFreshness{std::min(lifetime, MaxHeuristicLifetime), staleAllowed};
+    }
+    return HttpFreshness{std::chrono::seconds::zero(), staleAllowed};
+}
+
+HttpCachingFields revalidatedFields(const HttpCachingFields& stored, const HttpCachingFields& notModified)
+{
+    auto updated = [](std::string_view storedValue, std::string_view value) {
+        return value.empty() ? storedValue : value;
+    };
+    return HttpCachingFields{updated(stored.cacheControl, notModified.cacheControl),
+                             updated(stored.expires, notModified.expires),
+                             notModified.date,
+                             updated(stored.lastModified, notModified.lastModified)};
+}
+
+boost::optional<std::time_t> parseHttpDate(std::string_view date)
+{
+    std::tm tm{};
+    std::string value{date};
+    auto end = strptime(value.c_str(), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    if (!end || *end != '\0') return {};
+
+    return timegm(&tm);
+}
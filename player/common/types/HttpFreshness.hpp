@@ -0,0 +1,34 @@
+#pragma once
+
+#include <boost/optional/optional.hpp>
+
+#include <chrono>
+#include <ctime>
+#include <string_view>
+
+// Caching fields of a response as they were received
+struct HttpCachingFields
+{
+    std::string_view cacheControl;
+    std::string_view expires;
+    std::string_view date;
+    std::string_view lastModified;
+};
+
+struct HttpFreshness
+{
+    std::chrono::seconds lifetime;
+    bool staleAllowed;  // false with must-revalidate, an expired copy can't stand in for the origin then
+};
+
+// How long a private cache may reuse a response without asking the origin again (RFC 7234). Nothing
+// is returned when it mustn't be stored at all. Without max-age or Expires a tenth of the time since
+// Last-Modified is used, up to a day, and a response without any of them is stale as soon as it's stored.
+boost::optional<HttpFreshness> httpFreshness(const HttpCachingFields& fields, std::time_t receivedAt);
+
+// Fields of a stored response after a 304 Not Modified confirmed it: those sent with the 304 replace the
+// stored ones (RFC 7234 4.3.4). Date always comes from the 304 as the stored copy is renewed when it's received.
+HttpCachingFields revalidatedFields(const HttpCachingFields& stored, const HttpCachingFields& notModified);
+
+// IMF-fixdate, e.g. "Sun, 06 Nov 1994 08:49:37 GMT"
+boost::optional<std::time_t> parseHttpDate(std::string_view date);
@@ -0,0 +1,51 @@
+#include "common/types/ByteRange.hpp"
+
+#include <gtest/gtest.h>
+
+static ByteRanges rangesOf(std::string_view header, uint64_t size)
+{
+    auto ranges = parseByteRanges(header, size);
+    EXPECT_TRUE(ranges.has_value()) << header;
+    return ranges.value_or(ByteRanges{});
+}
+
+TEST(ByteRange, SingleRanges)
+{
+    ASSERT_EQ(rangesOf("bytes=0-499", 1000), (ByteRanges{{0, 500}}));
+    ASSERT_EQ(rangesOf("bytes=500-", 1000), (ByteRanges{{500, 500}}));
+    ASSERT_EQ(rangesOf("bytes=-200", 1000), (ByteRanges{{800, 200}}));
+    ASSERT_EQ(rangesOf("bytes=-2000", 1000), (ByteRanges{{0, 1000}}));
+    ASSERT_EQ(rangesOf("bytes=900-5000", 1000), (ByteRanges{{900, 100}}));
+    ASSERT_EQ(rangesOf("Bytes=7-7", 1000), (ByteRanges{{7, 1}}));
+}
+
+TEST(ByteRange, SeveralRanges)
+{
+    ASSERT_EQ(rangesOf("bytes=0-0, -1", 1000), (ByteRanges{{0, 1}, {999, 1}}));
+    ASSERT_EQ(rangesOf("bytes=0-9,,20-29 ,", 1000), (ByteRanges{{0, 10}, {20, 10}}));
+    ASSERT_EQ(rangesOf("bytes=2000-, 10-19", 1000), (ByteRanges{{10, 10}}));
+}
+
+TEST(ByteRange, Unsatisfiable)
+{
+    ASSERT_EQ(rangesOf("bytes=1000-", 1000), ByteRanges{});
+    ASSERT_EQ(rangesOf("bytes=-0", 1000), ByteRanges{});
+    ASSERT_EQ(rangesOf("bytes=0-", 0), ByteRanges{});
+}
+
+TEST(ByteRange, Ignored)
+{
+    ASSERT_FALSE(parseByteRanges("", 1000));
+    ASSERT_FALSE(parseByteRanges("items=0-1", 1000));
+    ASSERT_FALSE(parseByteRanges("bytes=", 1000));
+    ASSERT_FALSE(parseByteRanges("bytes=5-1", 1000));
+    ASSERT_FALSE(parseByteRanges("bytes=a-b", 1000));
+    ASSERT_FALSE(parseByteRanges("bytes=0-1;1-2", 1000));
+
+    std::string tooMany = "bytes=0-0";
+    for (int i = 1; i != 17; ++i)
+    {
+        tooMany += "," + std::to_string(i) + "-" + std::to_string(i);
+    }
+    ASSERT_FALSE(parseByteRanges(tooMany, 1000));
+}
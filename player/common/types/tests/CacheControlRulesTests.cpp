@@ -0,0 +1,29 @@
+#include "common/types/CacheControlRules.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(CacheControlRules, ExactTypeThenWildcards)
+{
+    auto rules = CacheControlRules::fromString("text/html=no-cache; image/*=max-age=86400; *=max-age=300");
+
+    ASSERT_EQ(rules.forType("text/html"), "no-cache");
+    ASSERT_EQ(rules.forType("Text/HTML; charset=utf-8"), "no-cache");
+    ASSERT_EQ(rules.forType("image/png"), "max-age=86400");
+    ASSERT_EQ(rules.forType("application/javascript"), "max-age=300");
+}
+
+TEST(CacheControlRules, NoMatchingRule)
+{
+    auto rules = CacheControlRules::fromString("text/css=max-age=60, immutable");
+
+    ASSERT_EQ(rules.forType("text/css"), "max-age=60, immutable");
+    ASSERT_EQ(rules.forType("text/html"), "");
+    ASSERT_EQ(CacheControlRules{}.forType("text/html"), "");
+}
+
+TEST(CacheControlRules, FromString_Invalid)
+{
+    ASSERT_THROW(CacheControlRules::fromString("no-cache"), CacheControlRules::Error);
+    ASSERT_THROW(CacheControlRules::fromString("text/html="), CacheControlRules::Error);
+    ASSERT_THROW(CacheControlRules::fromString("=no-cache"), CacheControlRules::Error);
+}
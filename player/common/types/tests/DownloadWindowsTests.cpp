@@ -0,0 +1,59 @@
+#include "DownloadWindowsTests.hpp"
+
+const std::vector<DownloadTierTest> tiers = {{"", 12, 0, true, 0},
+                                             {"  ", 3, 0, true, 0},
+                                             {"08:00-18:00", 8, 0, true, 0},
+                                             {"08:00-18:00", 17, 59, true, 0},
+                                             {"08:00-18:00", 18, 0, false, 0},
+                                             {"08:00-18:00", 7, 59, false, 0},
+                                             {"22:00-06:00", 23, 30, true, 0},
+                                             {"22:00-06:00", 0, 0, true, 0},
+                                             {"22:00-06:00", 5, 59, true, 0},
+                                             {"22:00-06:00", 6, 0, false, 0},
+                                             {"22:00-24:00", 23, 59, true, 0},
+                                             {"22:00-24:00", 0, 0, false, 0},
+                                             {"00:00-00:00=64", 13, 0, true, 64 * 1024},
+                                             {"22:00-06:00; 06:00-22:00=256", 2, 0, true, 0},
+                                             {"22:00-06:00; 06:00-22:00=256", 12, 0, true, 256 * 1024},
+                                             {"09:00-17:00=0;00:00-00:00=128", 10, 0, true, 0},
+                                             {"09:00-17:00=0;00:00-00:00=128", 20, 0, true, 128 * 1024},
+                                             {"9:05-9:10", 9, 7, true, 0}};
+
+const std::vector<std::string> invalidSchedules = {"08:00",
+                                                   "08:00-",
+                                                   "-18:00",
+                                                   "8-18",
+                                                   "25:00-06:00",
+                                                   "08:60-09:00",
+                                                   "24:01-01:00",
+                                                   "08:00-18:00=",
+                                                   "08:00-18:00=fast",
+                                                   "08:00-18:00=-5",
+                                                   "08:00-18:00;aa"};
+
+TEST_P(DownloadWindowsTierTests, TierAt)
+{
+    auto windows = DownloadWindows::fromString(GetParam().schedule);
+    auto tier = windows.tierAt(std::chrono::hours{GetParam().hour} + std::chrono::minutes{GetParam().minute});
+
+    ASSERT_EQ(tier.allowed, GetParam().allowed);
+    ASSERT_EQ(tier.bytesPerSecond, GetParam().bytesPerSecond);
+}
+
+INSTANTIATE_TEST_CASE_P(Suite, DownloadWindowsTierTests, ::testing::ValuesIn(tiers));
+
+TEST_P(DownloadWindowsInvalidTests, FromString_Invalid)
+{
+    ASSERT_THROW(DownloadWindows::fromString(GetParam()), DownloadWindows::Error);
+}
+
+INSTANTIATE_TEST_CASE_P(Suite, DownloadWindowsInvalidTests, ::testing::ValuesIn(invalidSchedules));
+
+TEST(DownloadWindows, KeepsSourceString)
+{
+    auto windows = DownloadWindows::fromString("22:00-06:00;06:00-22:00=256");
+
+    ASSERT_EQ(windows.string(), "22:00-06:00;06:00-22:00=256");
+    ASSERT_FALSE(windows.empty());
+    ASSERT_TRUE(DownloadWindows{}.empty());
+}
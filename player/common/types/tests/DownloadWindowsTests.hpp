@@ -0,0 +1,27 @@
+#pragma once
+
+#include "common/types/DownloadWindows.hpp"
+
+#include <gtest/gtest.h>
+
+struct DownloadTierTest
+{
+    std::string schedule;
+    int hour;
+    int minute;
+    bool allowed;
+    uint64_t bytesPerSecond;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const DownloadTierTest& test)
+{
+    return os << "DownloadTierTest{schedule=\"" << test.schedule << "\", time=" << test.hour << ":" << test.minute
+              << "}";
+}
+
+class DownloadWindowsTierTests : public testing::TestWithParam<DownloadTierTest>
+{
+};
+class DownloadWindowsInvalidTests : public testing::TestWithParam<std::string>
+{
+};
@@ -0,0 +1,84 @@
+#include "common/types/HttpFreshness.hpp"
+
+#include <gtest/gtest.h>
+
+const std::time_t ReceivedAt = 784111777;  // Sun, 06 Nov 1994 08:49:37 GMT
+
+static HttpFreshness freshnessOf(const HttpCachingFields& fields)
+{
+    auto freshness = httpFreshness(fields, ReceivedAt);
+    EXPECT_TRUE(freshness.has_value());
+    return freshness.value_or(HttpFreshness{std::chrono::seconds{-1}, false});
+}
+
+TEST(HttpFreshness, MaxAge)
+{
+    ASSERT_EQ(freshnessOf({"max-age=300", "", "", ""}).lifetime.count(), 300);
+    ASSERT_EQ(freshnessOf({"public, Max-Age=\"60\"", "", "", ""}).lifetime.count(), 60);
+    ASSERT_EQ(freshnessOf({"max-age=ten", "", "", ""}).lifetime.count(), 0);
+    // max-age wins over Expires
+    ASSERT_EQ(freshnessOf({"max-age=5", "Sun, 06 Nov 1994 09:49:37 GMT", "", ""}).lifetime.count(), 5);
+}
+
+TEST(HttpFreshness, Expires)
+{
+    ASSERT_EQ(freshnessOf({"", "Sun, 06 Nov 1994 09:49:37 GMT", "", ""}).lifetime.count(), 3600);
+    ASSERT_EQ(
+        freshnessOf({"", "Sun, 06 Nov 1994 09:49:37 GMT", "Sun, 06 Nov 1994 09:48:37 GMT", ""}).lifetime.count(), 60);
+    ASSERT_EQ(freshnessOf({"", "Sat, 05 Nov 1994 08:49:37 GMT", "", ""}).lifetime.count(), 0);
+    ASSERT_EQ(freshnessOf({"", "0", "", ""}).lifetime.count(), 0);
+}
+
+TEST(HttpFreshness, Heuristic)
+{
+    ASSERT_EQ(freshnessOf({"", "", "", "Sun, 06 Nov 1994 07:49:37 GMT"}).lifetime.count(), 360);
+    ASSERT_EQ(freshnessOf({"", "", "", "Sun, 06 Nov 1984 08:49:37 GMT"}).lifetime.count(), 24 * 60 * 60);
+    ASSERT_EQ(freshnessOf({"", "", "", ""}).lifetime.count(), 0);
+}
+
+TEST(HttpFreshness, Revalidation)
+{
+    ASSERT_EQ(freshnessOf({"no-cache, max-age=300", "", "", ""}).lifetime.count(), 0);
+    ASSERT_TRUE(freshnessOf({"max-age=300", "", "", ""}).staleAllowed);
+    ASSERT_FALSE(freshnessOf({"max-age=300, must-revalidate", "", "", ""}).staleAllowed);
+}
+
+TEST(HttpFreshness, NoStore)
+{
+    ASSERT_FALSE(httpFreshness({"no-store", "", "", ""}, ReceivedAt));
+    ASSERT_FALSE(httpFreshness({"max-age=300, No-Store", "", "", ""}, ReceivedAt));
+}
+
+TEST(HttpFreshness, ParseHttpDate)
+{
+    ASSERT_EQ(parseHttpDate("Sun, 06 Nov 1994 08:49:37 GMT").value_or(0), ReceivedAt);
+    ASSERT_FALSE(parseHttpDate("Sunday, 06-Nov-94 08:49:37 GMT"));
+    ASSERT_FALSE(parseHttpDate(""));
+}
+
+TEST(HttpFreshness, RevalidatedFields)
+{
+    HttpCachingFields stored{"max-age=300", "", "", "Sun, 06 Nov 1994 07:49:37 GMT"};
+
+    auto unchanged = revalidatedFields(stored, {"", "", "Sun, 06 Nov 1994 08:49:37 GMT", ""});
+    ASSERT_EQ(unchanged.cacheControl, "max-age=300");
+    ASSERT_EQ(unchanged.date, "Sun, 06 Nov 1994 08:49:37 GMT");
+    ASSERT_EQ(unchanged.lastModified, "Sun, 06 Nov 1994 07:49:37 GMT");
+    ASSERT_EQ(freshnessOf(unchanged).lifetime.count(), 300);
+
+    auto updated = revalidatedFields(stored, {"max-age=60, must-revalidate", "", "", ""});
+    ASSERT_EQ(freshnessOf(updated).lifetime.count(), 60);
+    ASSERT_FALSE(freshnessOf(updated).staleAllowed);
+}
+
+TEST(HttpFreshness, RevalidatedWithoutLifetime)
+{
+    // the stored Last-Modified gives a heuristic lifetime when the 304 has nothing else
+    HttpCachingFields stored{"", "", "", "Sun, 06 Nov 1994 07:49:37 GMT"};
+    ASSERT_EQ(freshnessOf(revalidatedFields(stored, {"", "", "", ""})).lifetime.count(), 360);
+
+    ASSERT_EQ(freshnessOf(revalidatedFields(stored, {"no-cache", "", "", ""})).lifetime.count(), 0);
+    ASSERT_FALSE(httpFreshness(revalidatedFields(stored, {"no-store", "", "", ""}), ReceivedAt));
+    ASSERT_EQ(freshnessOf(revalidatedFields(stored, {"", "Sun, 06 Nov 1994 09:49:37 GMT", "", ""})).lifetime.count(),
+              3600);
+}
@@ -103,6 +103,21 @@ FilePath AppConfig::statsCache()
     return configDirectory() / "stats.sqlite";
 }
 
+FilePath AppConfig::logsSpoolPath()
+{
+    return configDirectory() / "logs.spool";
+}
+
+FilePath AppConfig::webViewCacheDirectory()
+{
+    return configDirectory() / "webkit";
+}
+
+FilePath AppConfig::webProxyCacheDirectory()
+{
+    return configDirectory() / "proxy";
+}
+
 FilePath AppConfig::additionalResourcesDirectory()
 {
 #if defined(SNAP_ENABLED)
@@ -33,6 +33,9 @@ public:
     static FilePath schedulePath();
     static FilePath cachePath();
     static FilePath statsCache();
+    static FilePath logsSpoolPath();
+    static FilePath webViewCacheDirectory();
+    static FilePath webProxyCacheDirectory();
 
     static std::string playerBinary();
     static std::string optionsBinary();
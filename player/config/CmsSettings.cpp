@@ -91,6 +91,146 @@ const Field<std::string>& CmsSettings::displayId() const
     return displayId_;
 }
 
+Field<bool>& CmsSettings::compressRequests()
+{
+    return compressRequests_;
+}
+
+const Field<bool>& CmsSettings::compressRequests() const
+{
+    return compressRequests_;
+}
+
+const Field<int>& CmsSettings::connectTimeout() const
+{
+    return connectTimeout_;
+}
+
+const Field<int>& CmsSettings::handshakeTimeout() const
+{
+    return handshakeTimeout_;
+}
+
+const Field<int>& CmsSettings::firstByteTimeout() const
+{
+    return firstByteTimeout_;
+}
+
+const Field<int>& CmsSettings::idleTimeout() const
+{
+    return idleTimeout_;
+}
+
+const Field<int>& CmsSettings::requestAttempts() const
+{
+    return requestAttempts_;
+}
+
+const Field<bool>& CmsSettings::hedgeChunkRequests() const
+{
+    return hedgeChunkRequests_;
+}
+
+const Field<std::string>& CmsSettings::httpCaptureFile() const
+{
+    return httpCaptureFile_;
+}
+
+const Field<std::string>& CmsSettings::httpReplayFile() const
+{
+    return httpReplayFile_;
+}
+
+const Field<double>& CmsSettings::httpReplaySpeed() const
+{
+    return httpReplaySpeed_;
+}
+
+const Field<bool>& CmsSettings::lanSharing() const
+{
+    return lanSharing_;
+}
+
+const Field<std::string>& CmsSettings::lanSharingAddress() const
+{
+    return lanSharingAddress_;
+}
+
+const Field<int>& CmsSettings::lanSharingPort() const
+{
+    return lanSharingPort_;
+}
+
+const Field<int>& CmsSettings::lanDiscoveryPort() const
+{
+    return lanDiscoveryPort_;
+}
+
+const Field<std::string>& CmsSettings::lanPeers() const
+{
+    return lanPeers_;
+}
+
+const Field<std::string>& CmsSettings::webServerCacheControl() const
+{
+    return webServerCacheControl_;
+}
+
+const Field<int>& CmsSettings::webServerCacheSize() const
+{
+    return webServerCacheSize_;
+}
+
+const Field<int>& CmsSettings::webServerThreads() const
+{
+    return webServerThreads_;
+}
+
+const Field<int>& CmsSettings::webServerIdleTimeout() const
+{
+    return webServerIdleTimeout_;
+}
+
+const Field<std::string>& CmsSettings::webViewCacheModel() const
+{
+    return webViewCacheModel_;
+}
+
+const Field<int>& CmsSettings::webViewProcesses() const
+{
+    return webViewProcesses_;
+}
+
+const Field<std::string>& CmsSettings::hiddenWebViews() const
+{
+    return hiddenWebViews_;
+}
+
+const Field<int>& CmsSettings::webProxyCacheSize() const
+{
+    return webProxyCacheSize_;
+}
+
+const Field<std::string>& CmsSettings::screenshotFormat() const
+{
+    return screenshotFormat_;
+}
+
+const Field<int>& CmsSettings::screenshotQuality() const
+{
+    return screenshotQuality_;
+}
+
+const Field<int>& CmsSettings::screenshotMaxSize() const
+{
+    return screenshotMaxSize_;
+}
+
+const Field<int>& CmsSettings::screenshotMaxAge() const
+{
+    return screenshotMaxAge_;
+}
+
 const Field<std::string>& CmsSettings::domain() const
 {
     return domain_;
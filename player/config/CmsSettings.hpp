@@ -31,6 +31,57 @@ public:
     Field<std::string>& displayId();
     const Field<std::string>& displayId() const;
 
+    Field<bool>& compressRequests();
+    const Field<bool>& compressRequests() const;
+
+    // HTTP client tuning, timeouts are in seconds
+    const Field<int>& connectTimeout() const;
+    const Field<int>& handshakeTimeout() const;
+    const Field<int>& firstByteTimeout() const;
+    const Field<int>& idleTimeout() const;
+    const Field<int>& requestAttempts() const;
+    const Field<bool>& hedgeChunkRequests() const;
+
+    // Debugging aids: capture all HTTP traffic to a file, or answer requests from such a file
+    // instead of the network. replaySpeed scales recorded durations, 0 answers immediately.
+    const Field<std::string>& httpCaptureFile() const;
+    const Field<std::string>& httpReplayFile() const;
+    const Field<double>& httpReplaySpeed() const;
+
+    // LAN content sharing: downloaded media is served to other players on lanSharingAddress:lanSharingPort
+    // and requested from them before the CMS. Peers are found through multicast on lanDiscoveryPort,
+    // lanPeers lists additional ones as comma separated host:port.
+    const Field<bool>& lanSharing() const;
+    const Field<std::string>& lanSharingAddress() const;
+    const Field<int>& lanSharingPort() const;
+    const Field<int>& lanDiscoveryPort() const;
+    const Field<std::string>& lanPeers() const;
+
+    // Cache-Control sent by the embedded web server per MIME type, see CacheControlRules, and the
+    // memory in KiB it may use to keep small widget files, 0 reads them from disk on every request
+    const Field<std::string>& webServerCacheControl() const;
+    const Field<int>& webServerCacheSize() const;
+    // worker threads of the embedded web server and seconds an idle keep-alive connection is kept open
+    const Field<int>& webServerThreads() const;
+    const Field<int>& webServerIdleTimeout() const;
+    // WebKit cache model (document-viewer, document-browser or web-browser) and the number of web
+    // processes shared by HTML widgets
+    const Field<std::string>& webViewCacheModel() const;
+    const Field<int>& webViewProcesses() const;
+    // keep or unload, what happens to pages of web views while hidden unless a layout says otherwise
+    const Field<std::string>& hiddenWebViews() const;
+    // MiB of disk for remote http:// pages which web views load through the embedded web server, which
+    // shows them from its cache while they're fresh or the origin is unreachable. 0 disables the proxy
+    const Field<int>& webProxyCacheSize() const;
+    // png, jpeg or webp, the quality (1-100) of the lossy ones and the size in pixels of the longer
+    // side which larger screenshots are scaled down to, 0 sends them at the size of the window
+    const Field<std::string>& screenshotFormat() const;
+    const Field<int>& screenshotQuality() const;
+    const Field<int>& screenshotMaxSize() const;
+    // minutes after which a scheduled screenshot is submitted even though the display looks the same
+    // as in the last one, 0 submits all of them
+    const Field<int>& screenshotMaxAge() const;
+
     const Field<std::string>& domain() const;
     const Field<std::string>& username() const;
     const Field<std::string>& password() const;
@@ -43,5 +94,32 @@ private:
     NamedField<std::string> domain_{"domain"};
     NamedField<std::string> username_{"username"};
     NamedField<std::string> password_{"password"};
+    NamedField<bool> compressRequests_{"compressRequests", false};
+    NamedField<int> connectTimeout_{"connectTimeout", 15};
+    NamedField<int> handshakeTimeout_{"handshakeTimeout", 15};
+    NamedField<int> firstByteTimeout_{"firstByteTimeout", 60};
+    NamedField<int> idleTimeout_{"idleTimeout", 30};
+    NamedField<int> requestAttempts_{"requestAttempts", 3};
+    NamedField<bool> hedgeChunkRequests_{"hedgeChunkRequests", false};
+    NamedField<std::string> httpCaptureFile_{"httpCaptureFile"};
+    NamedField<std::string> httpReplayFile_{"httpReplayFile"};
+    NamedField<double> httpReplaySpeed_{"httpReplaySpeed", 1.0};
+    NamedField<bool> lanSharing_{"lanSharing", false};
+    NamedField<std::string> lanSharingAddress_{"lanSharingAddress", "0.0.0.0"};
+    NamedField<int> lanSharingPort_{"lanSharingPort", 9697};
+    NamedField<int> lanDiscoveryPort_{"lanDiscoveryPort", 9698};
+    NamedField<std::string> lanPeers_{"lanPeers"};
+    NamedField<std::string> webServerCacheControl_{"webServerCacheControl", "text/html=no-cache;*=max-age=300"};
+    NamedField<int> webServerCacheSize_{"webServerCacheSize", 32 * 1024};
+    NamedField<int> webServerThreads_{"webServerThreads", 2};
+    NamedField<int> webServerIdleTimeout_{"webServerIdleTimeout", 60};
+    NamedField<std::string> webViewCacheModel_{"webViewCacheModel", "document-browser"};
+    NamedField<int> webViewProcesses_{"webViewProcesses", 2};
+    NamedField<std::string> hiddenWebViews_{"hiddenWebViews", "keep"};
+    NamedField<int> webProxyCacheSize_{"webProxyCacheSize", 0};
+    NamedField<std::string> screenshotFormat_{"screenshotFormat", "jpeg"};
+    NamedField<int> screenshotQuality_{"screenshotQuality", 80};
+    NamedField<int> screenshotMaxSize_{"screenshotMaxSize", 1920};
+    NamedField<int> screenshotMaxAge_{"screenshotMaxAge", 60};
     boost::optional<Uri> proxy_;
 };
@@ -11,7 +11,34 @@ void CmsSettingsSerializer::loadSettingsFrom(const FilePath& file, CmsSettings&
                  settings.username_,
                  settings.password_,
                  settings.domain_,
-                 settings.displayId_);
+                 settings.displayId_,
+                 settings.compressRequests_,
+                 settings.connectTimeout_,
+                 settings.handshakeTimeout_,
+                 settings.firstByteTimeout_,
+                 settings.idleTimeout_,
+                 settings.requestAttempts_,
+                 settings.hedgeChunkRequests_,
+                 settings.httpCaptureFile_,
+                 settings.httpReplayFile_,
+                 settings.httpReplaySpeed_,
+                 settings.lanSharing_,
+                 settings.lanSharingAddress_,
+                 settings.lanSharingPort_,
+                 settings.lanDiscoveryPort_,
+                 settings.lanPeers_,
+                 settings.webServerCacheControl_,
+                 settings.webServerCacheSize_,
+                 settings.webServerThreads_,
+                 settings.webServerIdleTimeout_,
+                 settings.webViewCacheModel_,
+                 settings.webViewProcesses_,
+                 settings.hiddenWebViews_,
+                 settings.webProxyCacheSize_,
+                 settings.screenshotFormat_,
+                 settings.screenshotQuality_,
+                 settings.screenshotMaxSize_,
+                 settings.screenshotMaxAge_);
 
     settings.proxy_ = proxyFrom(settings.domain_, settings.username_, settings.password_);
 }
@@ -24,7 +51,34 @@ void CmsSettingsSerializer::saveSettingsTo(const FilePath& file, const CmsSettin
                            settings.username_,
                            settings.password_,
                            settings.domain_,
-                           settings.displayId_);
+                           settings.displayId_,
+                           settings.compressRequests_,
+                           settings.connectTimeout_,
+                           settings.handshakeTimeout_,
+                           settings.firstByteTimeout_,
+                           settings.idleTimeout_,
+                           settings.requestAttempts_,
+                           settings.hedgeChunkRequests_,
+                           settings.httpCaptureFile_,
+                           settings.httpReplayFile_,
+                           settings.httpReplaySpeed_,
+                           settings.lanSharing_,
+                           settings.lanSharingAddress_,
+                           settings.lanSharingPort_,
+                           settings.lanDiscoveryPort_,
+                           settings.lanPeers_,
+                           settings.webServerCacheControl_,
+                           settings.webServerCacheSize_,
+                           settings.webServerThreads_,
+                           settings.webServerIdleTimeout_,
+                           settings.webViewCacheModel_,
+                           settings.webViewProcesses_,
+                           settings.hiddenWebViews_,
+                           settings.webProxyCacheSize_,
+                           settings.screenshotFormat_,
+                           settings.screenshotQuality_,
+                           settings.screenshotMaxSize_,
+                           settings.screenshotMaxAge_);
     saveXmlTo(file, tree);
 }
 
@@ -91,6 +91,46 @@ const Field<std::string>& PlayerSettings::logLevel() const
     return logLevel_;
 }
 
+Field<std::string>& PlayerSettings::subsystemLogLevels()
+{
+    return subsystemLogLevels_;
+}
+
+const Field<std::string>& PlayerSettings::subsystemLogLevels() const
+{
+    return subsystemLogLevels_;
+}
+
+Field<std::string>& PlayerSettings::downloadWindows()
+{
+    return downloadWindows_;
+}
+
+const Field<std::string>& PlayerSettings::downloadWindows() const
+{
+    return downloadWindows_;
+}
+
+Field<int>& PlayerSettings::maxDownloadRate()
+{
+    return maxDownloadRate_;
+}
+
+const Field<int>& PlayerSettings::maxDownloadRate() const
+{
+    return maxDownloadRate_;
+}
+
+Field<int>& PlayerSettings::maxRequestDownloadRate()
+{
+    return maxRequestDownloadRate_;
+}
+
+const Field<int>& PlayerSettings::maxRequestDownloadRate() const
+{
+    return maxRequestDownloadRate_;
+}
+
 Field<int>& PlayerSettings::screenshotInterval()
 {
     return screenshotInterval_;
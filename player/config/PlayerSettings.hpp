@@ -57,6 +57,18 @@ public:
     Field<std::string>& logLevel();
     const Field<std::string>& logLevel() const;
 
+    Field<std::string>& subsystemLogLevels();
+    const Field<std::string>& subsystemLogLevels() const;
+
+    Field<std::string>& downloadWindows();
+    const Field<std::string>& downloadWindows() const;
+
+    Field<int>& maxDownloadRate();
+    const Field<int>& maxDownloadRate() const;
+
+    Field<int>& maxRequestDownloadRate();
+    const Field<int>& maxRequestDownloadRate() const;
+
     Field<int>& screenshotInterval();
     const Field<int>& screenshotInterval() const;
 
@@ -80,6 +92,11 @@ private:
     NamedField<bool> statsEnabled_{"statsEnabled", false};  // FIXME should listen to value
     NamedField<std::string> xmrNetworkAddress_{"xmrNetworkAddress"};
     NamedField<std::string> logLevel_{"logLevel", "debug"};
+    NamedField<std::string> subsystemLogLevels_{"subsystemLogLevels"};  // local only, e.g. "XMDS=trace;WebServer=error"
+    // local only, see DownloadWindows for the format; rates are in KiB/s and 0 means unlimited
+    NamedField<std::string> downloadWindows_{"downloadWindows"};
+    NamedField<int> maxDownloadRate_{"maxDownloadRate", 0};
+    NamedField<int> maxRequestDownloadRate_{"maxRequestDownloadRate", 0};
     NamedField<int> screenshotInterval_{"screenshotInterval", 0};
     NamedField<unsigned short> embeddedServerPort_{"embeddedServerPort",
                                                    9696};   // FIXME should listen to value changed and do reconfig
@@ -6,6 +6,10 @@ void PlayerSettingsSerializer::loadSettingsFrom(const FilePath& file, PlayerSett
                  settings.size_,
                  settings.position_,
                  settings.logLevel_,
+                 settings.subsystemLogLevels_,
+                 settings.downloadWindows_,
+                 settings.maxDownloadRate_,
+                 settings.maxRequestDownloadRate_,
                  settings.displayName_,
                  settings.preventSleep_,
                  settings.statsEnabled_,
@@ -20,6 +24,10 @@ void PlayerSettingsSerializer::saveSettingsTo(const FilePath& file, const Player
     auto tree = saveToImpl(settings.size_,
                            settings.position_,
                            settings.logLevel_,
+                           settings.subsystemLogLevels_,
+                           settings.downloadWindows_,
+                           settings.maxDownloadRate_,
+                           settings.maxRequestDownloadRate_,
                            settings.displayName_,
                            settings.preventSleep_,
                            settings.statsEnabled_,
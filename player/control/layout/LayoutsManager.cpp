@@ -84,12 +84,17 @@ void LayoutsManager::statsEnabled(bool enable)
     statsEnabled_ = enable;
 }
 
+void LayoutsManager::hiddenWebViews(HiddenWebViews policy)
+{
+    hiddenWebViews_ = policy;
+}
+
 template <typename LayoutParser>
 std::unique_ptr<Xibo::MainLayout> LayoutsManager::createLayout(int layoutId)
 {
     try
     {
-        LayoutParser parser{statsEnabled_};
+        LayoutParser parser{statsEnabled_, hiddenWebViews_};
         auto layout = parser.parseBy(layoutId);
         auto scheduleId = scheduler_.scheduleIdBy(layoutId);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "control/layout/MainLayout.hpp"
+#include "control/media/webview/HiddenWebViews.hpp"
 
 #include <map>
 #include <memory>
@@ -24,6 +25,8 @@ public:
     void fetchMainLayout();
     void fetchOverlays();
     void statsEnabled(bool enable);
+    // applies to layouts which don't set their own policy from the next one fetched
+    void hiddenWebViews(HiddenWebViews policy);
 
     MainLayoutLoaded& mainLayoutFetched();
     OverlaysLoaded& overlaysFetched();
@@ -37,6 +40,7 @@ private:
     Stats::Recorder& statsRecorder_;
     FileCache& fileCache_;
     bool statsEnabled_;
+    HiddenWebViews hiddenWebViews_ = HiddenWebViews::Keep;
 
     std::unique_ptr<Xibo::MainLayout> currentMainLayout_;
     std::map<int, std::unique_ptr<Xibo::MainLayout>> overlayLayouts_;
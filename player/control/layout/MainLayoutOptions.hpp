@@ -2,6 +2,7 @@
 
 #include "common/types/Color.hpp"
 #include "common/types/Uri.hpp"
+#include "control/media/webview/HiddenWebViews.hpp"
 
 struct MainLayoutOptions
 {
@@ -11,4 +12,5 @@ struct MainLayoutOptions
     bool statEnabled;
     boost::optional<Uri> backgroundUri;
     Color backgroundColor;
+    HiddenWebViews hiddenWebViews;
 };
@@ -16,7 +16,11 @@ MainLayoutParser::Error::Error(const std::string& domain, int layoutId, const st
 {
 }
 
-MainLayoutParser::MainLayoutParser(bool globalStatsEnabled) : globalStatsEnabled_{globalStatsEnabled} {}
+MainLayoutParser::MainLayoutParser(bool globalStatsEnabled, HiddenWebViews defaultHiddenWebViews) :
+    globalStatsEnabled_{globalStatsEnabled},
+    defaultHiddenWebViews_{defaultHiddenWebViews}
+{
+}
 
 std::unique_ptr<Xibo::MainLayout> MainLayoutParser::parseBy(int layoutId)
 {
@@ -44,7 +48,7 @@ std::unique_ptr<Xibo::MainLayout> MainLayoutParser::layoutFrom(const XmlNode& no
     auto layout = std::make_unique<MainLayoutImpl>(options);
 
     layout->setBackground(createBackground(options));
-    addRegions(*layout, node);
+    addRegions(*layout, node, options.hiddenWebViews);
 
     return layout;
 }
@@ -58,8 +62,10 @@ MainLayoutOptions MainLayoutParser::optionsFrom(const XmlNode& node)
 
     auto backgroundUri = backgroundUriFrom(node);
     auto backgroundColor = backgroundColorFrom(node);
+    // the player's setting unless the layout asks for its own
+    auto hiddenWebViews = node.get<HiddenWebViews>(XlfResources::MainLayout::HiddenWebViews, defaultHiddenWebViews_);
 
-    return MainLayoutOptions{layoutId_, width, height, statsEnabled, backgroundUri, backgroundColor};
+    return MainLayoutOptions{layoutId_, width, height, statsEnabled, backgroundUri, backgroundColor, hiddenWebViews};
 }
 
 boost::optional<Uri> MainLayoutParser::backgroundUriFrom(const XmlNode& node)
@@ -88,13 +94,13 @@ std::shared_ptr<Xibo::Image> MainLayoutParser::createBackground(const MainLayout
         return ImageWidgetFactory::create(options.backgroundColor, options.width, options.height);
 }
 
-void MainLayoutParser::addRegions(Xibo::MainLayout& layout, const XmlNode& layoutNode)
+void MainLayoutParser::addRegions(Xibo::MainLayout& layout, const XmlNode& layoutNode, HiddenWebViews hiddenWebViews)
 {
     for (auto [nodeName, node] : layoutNode)
     {
         if (nodeName != XlfResources::RegionNode) continue;
 
-        RegionParser parser{globalStatsEnabled_};
+        RegionParser parser{globalStatsEnabled_, hiddenWebViews};
         auto position = parser.positionFrom(node);
         layout.addRegion(parser.regionFrom(node), position.left, position.top, position.zorder);
     }
@@ -10,7 +10,7 @@ class FilePath;
 class MainLayoutParser
 {
 public:
-    MainLayoutParser(bool globalStatsEnabled);
+    MainLayoutParser(bool globalStatsEnabled, HiddenWebViews defaultHiddenWebViews);
     virtual ~MainLayoutParser() = default;
 
     struct Error : PlayerRuntimeError
@@ -27,9 +27,10 @@ protected:
     Color backgroundColorFrom(const XmlNode& node);
 
     virtual std::shared_ptr<Xibo::Image> createBackground(const MainLayoutOptions& options);
-    void addRegions(Xibo::MainLayout& layout, const XmlNode& node);
+    void addRegions(Xibo::MainLayout& layout, const XmlNode& node, HiddenWebViews hiddenWebViews);
 
 private:
     bool globalStatsEnabled_;
+    HiddenWebViews defaultHiddenWebViews_;
     int layoutId_;
 };
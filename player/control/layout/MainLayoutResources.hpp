@@ -11,4 +11,5 @@ namespace XlfResources::MainLayout
     const std::string StatsEnabled = Parsing::xmlAttr("enableStat");
     const std::string BackgroundPath = Parsing::xmlAttr("background");
     const std::string BackgroundColor = Parsing::xmlAttr("bgcolor");
+    const std::string HiddenWebViews = Parsing::xmlAttr("hiddenWebViews");
 }
@@ -98,13 +98,15 @@ std::istream& operator>>(std::istream& in, Transition::Direction& direction)
 std::unique_ptr<Xibo::Media> MediaParser::mediaFrom(const XmlNode& node,
                                                     int parentWidth,
                                                     int parentHeight,
-                                                    bool globalStatEnabled)
+                                                    bool globalStatEnabled,
+                                                    HiddenWebViews hiddenWebViews)
 {
     using namespace std::string_literals;
 
     try
     {
         globalStatEnabled_ = globalStatEnabled;
+        hiddenWebViews_ = hiddenWebViews;
 
         auto baseOptions = baseOptionsFrom(node);
         auto media = createMedia(baseOptions, node, parentWidth, parentHeight);
@@ -126,6 +128,11 @@ std::unique_ptr<Xibo::Media> MediaParser::mediaFrom(const XmlNode& node,
     }
 }
 
+HiddenWebViews MediaParser::hiddenWebViews() const
+{
+    return hiddenWebViews_;
+}
+
 MediaOptions MediaParser::baseOptionsFrom(const XmlNode& node)
 {
     auto type = typeFrom(node);
@@ -189,7 +196,8 @@ void MediaParser::attach(Xibo::Media& media, const XmlNode& node)
 
         if (parser)
         {
-            media.attach(parser->mediaFrom(attachedNode, 0, 0, globalStatEnabled_));  // TODO: remove 0, 0
+            // TODO: remove 0, 0
+            media.attach(parser->mediaFrom(attachedNode, 0, 0, globalStatEnabled_, hiddenWebViews_));
         }
     }
 }
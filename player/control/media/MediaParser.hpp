@@ -3,6 +3,7 @@
 #include "common/parsing/Parsing.hpp"
 #include "common/PlayerRuntimeError.hpp"
 #include "control/media/Media.hpp"
+#include "control/media/webview/HiddenWebViews.hpp"
 #include "control/transitions/Transition.hpp"
 
 std::istream& operator>>(std::istream& in, MediaGeometry::ScaleType& scaleType);
@@ -27,9 +28,11 @@ public:
     std::unique_ptr<Xibo::Media> mediaFrom(const XmlNode& node,
                                            int parentWidth,
                                            int parentHeight,
-                                           bool globalStatEnabled);
+                                           bool globalStatEnabled,
+                                           HiddenWebViews hiddenWebViews);
 
 protected:
+    HiddenWebViews hiddenWebViews() const;
     virtual MediaOptions::Type typeFrom(const XmlNode& node);
     virtual int idFrom(const XmlNode& node);
     virtual Uri uriFrom(const XmlNode& node);
@@ -58,4 +61,5 @@ private:
 
 private:
     bool globalStatEnabled_;
+    HiddenWebViews hiddenWebViews_;
 };
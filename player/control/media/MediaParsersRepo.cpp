@@ -4,6 +4,7 @@
 #include "control/media/player/audio/AudioNodeParser.hpp"
 #include "control/media/player/audio/AudioParser.hpp"
 #include "control/media/player/video/VideoParser.hpp"
+#include "control/media/text/TextParser.hpp"
 #include "control/media/webview/WebViewParser.hpp"
 
 #include <gst/gst.h>
@@ -20,7 +21,7 @@ void MediaParsersRepo::init()
     add({XlfResources::Media::LocalVideoType, XlfResources::Media::NativeRender}, std::make_unique<VideoParser>());
     add({XlfResources::Media::AudioType, XlfResources::Media::NativeRender}, std::make_unique<AudioParser>());
     add({XlfResources::Media::AudioNodeType, XlfResources::Media::NativeRender}, std::make_unique<AudioNodeParser>());
-    add({XlfResources::Media::TextType, XlfResources::Media::NativeRender}, std::make_unique<WebViewParser>());
+    add({XlfResources::Media::TextType, XlfResources::Media::NativeRender}, std::make_unique<TextParser>());
     add({XlfResources::Media::EmbeddedType, XlfResources::Media::NativeRender}, std::make_unique<WebViewParser>());
     add({XlfResources::Media::TickerType, XlfResources::Media::NativeRender}, std::make_unique<WebViewParser>());
     add({XlfResources::Media::WebpageType, XlfResources::Media::NativeRender}, std::make_unique<WebViewParser>());
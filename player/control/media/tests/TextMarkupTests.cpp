@@ -0,0 +1,94 @@
+#include "control/media/text/TextMarkup.hpp"
+
+#include <gtest/gtest.h>
+
+static std::string markupOf(const std::string& html)
+{
+    auto result = TextMarkup::fromHtml(html);
+    EXPECT_TRUE(result.has_value()) << html;
+    return result ? result->markup : std::string{};
+}
+
+TEST(TextMarkup, Paragraphs)
+{
+    ASSERT_EQ(markupOf("<p>First</p><p>Second</p>"), "First\nSecond");
+    ASSERT_EQ(markupOf("<div>One<br>Two<br/></div>"), "One\nTwo");
+    ASSERT_EQ(markupOf("<p></p><p>Text</p><p></p>"), "Text");
+}
+
+TEST(TextMarkup, WhiteSpaceCollapsed)
+{
+    ASSERT_EQ(markupOf("<p>\n  Some \t spaced\n\ntext  </p>"), "Some spaced text");
+}
+
+TEST(TextMarkup, InlineElements)
+{
+    ASSERT_EQ(markupOf("<strong>a</strong><em>b</em><u>c</u><del>d</del><sup>e</sup>"),
+              "<b>a</b><i>b</i><u>c</u><s>d</s><sup>e</sup>");
+    ASSERT_EQ(markupOf("<B>upper</B>"), "<b>upper</b>");
+}
+
+TEST(TextMarkup, Styles)
+{
+    ASSERT_EQ(markupOf(R"(<span style="color: #ff0000; font-weight: bold">a</span>)"),
+              R"(<span foreground="#ff0000" weight="bold">a</span>)");
+    ASSERT_EQ(markupOf(R"html(<span style="background-color: rgb(0, 128, 255)">a</span>)html"),
+              R"(<span background="#0080ff">a</span>)");
+    ASSERT_EQ(markupOf(R"(<span style="font-size: 24px">a</span><span style="font-size: 12pt">b</span>)"),
+              R"(<span font_desc="24px">a</span><span font_desc="12">b</span>)");
+    ASSERT_EQ(markupOf(R"(<b style="text-decoration: underline">a</b>)"),
+              R"(<b><span underline="single">a</span></b>)");
+}
+
+TEST(TextMarkup, Alignment)
+{
+    auto result = TextMarkup::fromHtml(R"(<p style="text-align: center">a</p><p style="text-align: center">b</p>)");
+    ASSERT_TRUE(result);
+    ASSERT_EQ(result->alignment, Xibo::Text::Alignment::Center);
+
+    ASSERT_FALSE(TextMarkup::fromHtml(R"(<p style="text-align: center">a</p><p style="text-align: right">b</p>)"));
+    ASSERT_FALSE(TextMarkup::fromHtml(R"(<span style="text-align: center">a</span>)"));
+}
+
+TEST(TextMarkup, Entities)
+{
+    ASSERT_EQ(markupOf("a &amp; b &lt;c&gt; d&nbsp;e &#169; &#x263A;"),
+              "a &amp; b &lt;c&gt; d\xC2\xA0"
+              "e &#169; &#x263A;");
+    ASSERT_EQ(markupOf("1 > 0"), "1 &gt; 0");
+    ASSERT_FALSE(TextMarkup::fromHtml("&copy;"));
+    ASSERT_FALSE(TextMarkup::fromHtml("&#xZZ;"));
+}
+
+TEST(TextMarkup, CommentsSkipped)
+{
+    ASSERT_EQ(markupOf("<p>a<!-- <img src=x> --></p>"), "a");
+    ASSERT_FALSE(TextMarkup::fromHtml("<p>a<!-- unterminated</p>"));
+}
+
+TEST(TextMarkup, UnsupportedColors)
+{
+    for (auto color : {"inherit", "transparent", "currentColor", "rgb(256, 0, 0)", "rgba(0, 0, 0, 0.5)", "#ff00"})
+    {
+        auto html = std::string{R"(<span style="color: )"} + color + R"(">a</span>)";
+        ASSERT_FALSE(TextMarkup::fromHtml(html)) << color;
+    }
+}
+
+TEST(TextMarkup, LeftToWebKit)
+{
+    ASSERT_FALSE(TextMarkup::fromHtml(R"(<img src="a.png">)"));
+    ASSERT_FALSE(TextMarkup::fromHtml("<table><tr><td>a</td></tr></table>"));
+    ASSERT_FALSE(TextMarkup::fromHtml(R"(<span class="a">a</span>)"));
+    ASSERT_FALSE(TextMarkup::fromHtml(R"(<span style="font-size: 2em">a</span>)"));
+    ASSERT_FALSE(TextMarkup::fromHtml(R"(<span style="font-family: Arial">a</span>)"));
+    ASSERT_FALSE(TextMarkup::fromHtml("<p>[Clock]</p>"));
+}
+
+TEST(TextMarkup, Malformed)
+{
+    ASSERT_FALSE(TextMarkup::fromHtml("<b>a</i>"));
+    ASSERT_FALSE(TextMarkup::fromHtml("<b>a"));
+    ASSERT_FALSE(TextMarkup::fromHtml("<p>a</p"));
+    ASSERT_FALSE(TextMarkup::fromHtml("a &amp b"));
+}
@@ -0,0 +1,25 @@
+#include "TextFactory.hpp"
+
+#include "control/media/MediaImpl.hpp"
+#include "control/widgets/Text.hpp"
+
+std::unique_ptr<Xibo::Media> TextFactory::create(const MediaOptions& baseOptions,
+                                                 const TextMarkup& markup,
+                                                 Xibo::Text::Scroll scroll,
+                                                 double pixelsPerSecond,
+                                                 const Color& background,
+                                                 int width,
+                                                 int height)
+{
+    std::shared_ptr<Xibo::Text> text = TextWidgetFactory::create(width, height);
+    if (text)
+    {
+        text->setMarkup(markup.markup, markup.alignment);
+        text->setBackground(background);
+        text->setScroll(scroll, pixelsPerSecond);
+    }
+
+    auto media = std::make_unique<MediaImpl>(baseOptions);
+    media->setWidget(text);
+    return media;
+}
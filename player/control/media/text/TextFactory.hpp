@@ -0,0 +1,19 @@
+#pragma once
+
+#include "control/media/Media.hpp"
+#include "control/media/MediaOptions.hpp"
+#include "control/media/text/TextMarkup.hpp"
+
+#include <memory>
+
+class TextFactory
+{
+public:
+    std::unique_ptr<Xibo::Media> create(const MediaOptions& baseOptions,
+                                        const TextMarkup& markup,
+                                        Xibo::Text::Scroll scroll,
+                                        double pixelsPerSecond,
+                                        const Color& background,
+                                        int width,
+                                        int height);
+};
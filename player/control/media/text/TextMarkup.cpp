@@ -0,0 +1,313 @@
+#include "TextMarkup.hpp"
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <fmt/format.h>
+
+#include <map>
+#include <regex>
+#include <set>
+#include <sstream>
+
+const std::map<std::string, std::string> InlineElements{{"b", "b"},
+                                                        {"strong", "b"},
+                                                        {"i", "i"},
+                                                        {"em", "i"},
+                                                        {"u", "u"},
+                                                        {"s", "s"},
+                                                        {"strike", "s"},
+                                                        {"del", "s"},
+                                                        {"sub", "sub"},
+                                                        {"sup", "sup"},
+                                                        {"span", "span"}};
+const std::map<std::string, std::string> Entities{
+    {"amp", "&amp;"}, {"lt", "&lt;"}, {"gt", "&gt;"}, {"quot", "\""}, {"apos", "'"}, {"nbsp", "\xC2\xA0"}};
+const std::map<std::string, Xibo::Text::Alignment> Alignments{{"left", Xibo::Text::Alignment::Left},
+                                                              {"center", Xibo::Text::Alignment::Center},
+                                                              {"right", Xibo::Text::Alignment::Right}};
+// keywords which are valid in CSS but aren't colors Pango could parse
+const std::set<std::string> CssColorKeywords{"inherit", "initial", "unset", "transparent", "currentcolor"};
+const std::regex StyleAttribute{R"re(^\s*style\s*=\s*"([^"]*)"\s*/?$)re"};
+const std::regex FontSize{R"(^(\d+(\.\d+)?)(px|pt)$)"};
+const std::regex CssColor{R"(^(#[0-9a-fA-F]{3}|#[0-9a-fA-F]{6}|[a-zA-Z]+)$)"};
+const std::regex RgbColor{R"(^rgb\(\s*(\d{1,3})\s*,\s*(\d{1,3})\s*,\s*(\d{1,3})\s*\)$)"};
+
+class MarkupBuilder
+{
+public:
+    bool element(const std::string& tag);
+    bool entity(const std::string& name);
+    void text(char c);
+    boost::optional<TextMarkup> finish();
+
+private:
+    bool openElement(const std::string& name, const std::string& attributes);
+    bool closeElement(const std::string& name);
+    bool spanAttributes(const std::string& style, bool block, std::string& attributes);
+    bool setAlignment(const std::string& value);
+    static boost::optional<std::string> color(const std::string& value);
+    void append(const std::string& text);
+    void newLine();
+
+private:
+    TextMarkup result_;
+    bool alignmentSet_ = false;
+    bool lineStart_ = true;
+    bool pendingSpace_ = false;
+    std::vector<std::pair<std::string, std::string>> openElements_;  // HTML name and markup closing it
+};
+
+bool MarkupBuilder::element(const std::string& tag)
+{
+    if (tag.empty()) return false;
+    if (tag[0] == '/') return closeElement(boost::to_lower_copy(boost::trim_copy(tag.substr(1))));
+
+    auto nameEnd = tag.find_first_of(" \t\r\n/");
+    auto name = boost::to_lower_copy(tag.substr(0, nameEnd));
+    auto attributes = nameEnd == std::string::npos ? std::string{} : tag.substr(nameEnd);
+    return openElement(name, attributes);
+}
+
+bool MarkupBuilder::openElement(const std::string& name, const std::string& attributes)
+{
+    std::string style;
+    if (!boost::trim_copy(attributes).empty() && boost::trim_copy(attributes) != "/")
+    {
+        std::smatch match;
+        if (!std::regex_match(attributes, match, StyleAttribute)) return false;
+        style = match[1].str();
+    }
+
+    if (name == "br")
+    {
+        newLine();
+        return style.empty();
+    }
+
+    bool block = name == "p" || name == "div";
+    auto inlineElement = InlineElements.find(name);
+    if (!block && inlineElement == InlineElements.end()) return false;
+
+    // paragraphs are separated by a line break, empty ones are ignored
+    if (block && !lineStart_)
+    {
+        newLine();
+    }
+
+    std::string spanAttributesMarkup;
+    if (!spanAttributes(style, block, spanAttributesMarkup)) return false;
+
+    std::string opening, closing;
+    if (!spanAttributesMarkup.empty())
+    {
+        opening = "<span" + spanAttributesMarkup + ">";
+        closing = "</span>";
+    }
+    if (!block && inlineElement->second != "span")
+    {
+        opening = "<" + inlineElement->second + ">" + opening;
+        closing += "</" + inlineElement->second + ">";
+    }
+
+    result_.markup += opening;
+    openElements_.emplace_back(name, closing);
+    return true;
+}
+
+bool MarkupBuilder::closeElement(const std::string& name)
+{
+    if (openElements_.empty() || openElements_.back().first != name) return false;
+
+    result_.markup += openElements_.back().second;
+    openElements_.pop_back();
+    return true;
+}
+
+bool MarkupBuilder::spanAttributes(const std::string& style, bool block, std::string& attributes)
+{
+    std::istringstream declarations{style};
+    std::string declaration;
+    while (std::getline(declarations, declaration, ';'))
+    {
+        if (boost::trim_copy(declaration).empty()) continue;
+
+        auto colon = declaration.find(':');
+        if (colon == std::string::npos) return false;
+
+        auto property = boost::to_lower_copy(boost::trim_copy(declaration.substr(0, colon)));
+        auto value = boost::trim_copy(declaration.substr(colon + 1));
+        std::smatch match;
+
+        if (property == "text-align" && block)
+        {
+            if (!setAlignment(boost::to_lower_copy(value))) return false;
+        }
+        else if (property == "color" || property == "background-color")
+        {
+            auto markupColor = color(value);
+            if (!markupColor) return false;
+            attributes += (property == "color" ? " foreground=\"" : " background=\"") + *markupColor + "\"";
+        }
+        else if (property == "font-size" && std::regex_match(value, match, FontSize))
+        {
+            // Pango takes sizes in points unless they're marked as pixels
+            auto size = match[3].str() == "px" ? value : match[1].str();
+            attributes += " font_desc=\"" + size + "\"";
+        }
+        else if (property == "font-weight" && (value == "bold" || value == "normal"))
+        {
+            attributes += " weight=\"" + value + "\"";
+        }
+        else if (property == "font-style" && (value == "italic" || value == "normal"))
+        {
+            attributes += " style=\"" + value + "\"";
+        }
+        else if (property == "text-decoration" && value == "underline")
+        {
+            attributes += " underline=\"single\"";
+        }
+        else if (property == "text-decoration" && value == "line-through")
+        {
+            attributes += " strikethrough=\"true\"";
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Pango aligns the whole layout, so paragraphs have to agree
+bool MarkupBuilder::setAlignment(const std::string& value)
+{
+    auto alignment = Alignments.find(value);
+    if (alignment == Alignments.end()) return false;
+    if (alignmentSet_ && result_.alignment != alignment->second) return false;
+
+    result_.alignment = alignment->second;
+    alignmentSet_ = true;
+    return true;
+}
+
+boost::optional<std::string> MarkupBuilder::color(const std::string& value)
+{
+    std::smatch match;
+    if (std::regex_match(value, match, CssColor))
+    {
+        if (CssColorKeywords.count(boost::to_lower_copy(value)) != 0) return {};
+        return value;
+    }
+    if (!std::regex_match(value, match, RgbColor)) return {};
+
+    std::string hex = "#";
+    for (size_t i = 1; i <= 3; ++i)
+    {
+        auto component = std::stoi(match[i].str());
+        if (component > 255) return {};
+        hex += fmt::format("{:02x}", component);
+    }
+    return hex;
+}
+
+bool MarkupBuilder::entity(const std::string& name)
+{
+    std::string text;
+    if (auto known = Entities.find(name); known != Entities.end())
+    {
+        text = known->second;
+    }
+    else if (name.size() > 1 && name[0] == '#')
+    {
+        // numeric references are kept for Pango, its parser understands them
+        auto digits = name.substr(name[1] == 'x' ? 2 : 1);
+        if (digits.empty() || digits.find_first_not_of(name[1] == 'x' ? "0123456789abcdefABCDEF" : "0123456789") !=
+                                  std::string::npos)
+            return false;
+        text = "&" + name + ";";
+    }
+    else
+    {
+        return false;
+    }
+
+    append(text);
+    return true;
+}
+
+// Runs of white space collapse into one space as in HTML
+void MarkupBuilder::text(char c)
+{
+    if (std::isspace(static_cast<unsigned char>(c)))
+    {
+        pendingSpace_ = !lineStart_;
+        return;
+    }
+    append(c == '>' ? "&gt;" : std::string(1, c));
+}
+
+void MarkupBuilder::append(const std::string& text)
+{
+    if (pendingSpace_)
+    {
+        result_.markup += " ";
+        pendingSpace_ = false;
+    }
+    result_.markup += text;
+    lineStart_ = false;
+}
+
+void MarkupBuilder::newLine()
+{
+    result_.markup += "\n";
+    lineStart_ = true;
+    pendingSpace_ = false;
+}
+
+boost::optional<TextMarkup> MarkupBuilder::finish()
+{
+    if (!openElements_.empty()) return {};
+
+    auto lastLine = result_.markup.find_last_not_of('\n');
+    result_.markup.erase(lastLine == std::string::npos ? 0 : lastLine + 1);
+    return result_;
+}
+
+boost::optional<TextMarkup> TextMarkup::fromHtml(const std::string& html)
+{
+    MarkupBuilder builder;
+    for (size_t pos = 0; pos < html.size(); ++pos)
+    {
+        auto c = html[pos];
+        if (c == '<')
+        {
+            if (html.compare(pos, 4, "<!--") == 0)
+            {
+                pos = html.find("-->", pos);
+                if (pos == std::string::npos) return {};
+                pos += 2;
+                continue;
+            }
+
+            auto end = html.find('>', pos);
+            if (end == std::string::npos || !builder.element(html.substr(pos + 1, end - pos - 1))) return {};
+            pos = end;
+        }
+        else if (c == '&')
+        {
+            auto end = html.find(';', pos);
+            if (end == std::string::npos || !builder.entity(html.substr(pos + 1, end - pos - 1))) return {};
+            pos = end;
+        }
+        else if (c == '[')
+        {
+            // [Clock], [Date] and other placeholders are replaced by the widget's JavaScript
+            return {};
+        }
+        else
+        {
+            builder.text(c);
+        }
+    }
+    return builder.finish();
+}
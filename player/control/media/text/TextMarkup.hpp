@@ -0,0 +1,18 @@
+#pragma once
+
+#include "control/widgets/Text.hpp"
+
+#include <boost/optional/optional.hpp>
+#include <string>
+
+// Formatted text from the CMS text editor converted to Pango markup. Only paragraphs, line breaks
+// and inline styles which Pango can render the same way are supported. Anything else (images,
+// tables, web fonts, relative sizes or placeholders filled in by the widget's JavaScript) is left
+// to WebKit.
+struct TextMarkup
+{
+    static boost::optional<TextMarkup> fromHtml(const std::string& html);
+
+    std::string markup;
+    Xibo::Text::Alignment alignment = Xibo::Text::Alignment::Left;
+};
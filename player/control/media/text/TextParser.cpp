@@ -0,0 +1,89 @@
+#include "TextParser.hpp"
+
+#include "control/media/text/TextFactory.hpp"
+#include "control/media/text/TextResources.hpp"
+
+#include "common/logger/Logging.hpp"
+
+#include <algorithm>
+#include <map>
+#include <pango/pango.h>
+
+namespace TextResources = XlfResources::Text;
+
+// the CMS speed is relative with 1 as normal
+const double DefaultSpeed = 1.0;
+const double PixelsPerSecondPerSpeed = 50.0;
+const std::map<std::string, Xibo::Text::Scroll> Scrolls{{TextResources::NoEffect, Xibo::Text::Scroll::None},
+                                                        {TextResources::MarqueeLeft, Xibo::Text::Scroll::Left},
+                                                        {TextResources::MarqueeRight, Xibo::Text::Scroll::Right},
+                                                        {TextResources::MarqueeUp, Xibo::Text::Scroll::Up},
+                                                        {TextResources::MarqueeDown, Xibo::Text::Scroll::Down}};
+
+std::unique_ptr<Xibo::Media> TextParser::createMedia(const MediaOptions& options,
+                                                     const XmlNode& node,
+                                                     int width,
+                                                     int height)
+{
+    auto html = node.get_optional<std::string>(TextResources::Html);
+    auto javaScript = node.get<std::string>(TextResources::JavaScript, {});
+    auto fitText = node.get<bool>(TextResources::FitText, false);
+    auto scroll = scrollFrom(node);
+    auto background = backgroundFrom(node);
+
+    if (html && javaScript.empty() && !fitText && scroll && background)
+    {
+        auto markup = TextMarkup::fromHtml(*html);
+        if (markup && acceptedByPango(markup->markup))
+        {
+            // a horizontal marquee runs all paragraphs together on one line
+            if (*scroll == Xibo::Text::Scroll::Left || *scroll == Xibo::Text::Scroll::Right)
+            {
+                std::replace(markup->markup.begin(), markup->markup.end(), '\n', ' ');
+            }
+
+            Log::debug("[TextParser] Media {} drawn natively", options.id);
+            auto speed = node.get<double>(TextResources::Speed, DefaultSpeed);
+
+            TextFactory factory;
+            return factory.create(
+                options, *markup, *scroll, speed * PixelsPerSecondPerSpeed, *background, width, height);
+        }
+    }
+
+    return WebViewParser::createMedia(options, node, width, height);
+}
+
+boost::optional<Xibo::Text::Scroll> TextParser::scrollFrom(const XmlNode& node)
+{
+    auto effect = node.get<std::string>(TextResources::Effect, TextResources::NoEffect);
+    auto scroll = Scrolls.find(effect.empty() ? TextResources::NoEffect : effect);
+    if (scroll == Scrolls.end()) return {};
+
+    return scroll->second;
+}
+
+// none when the color can't be drawn natively, an unset color is transparent
+boost::optional<Color> TextParser::backgroundFrom(const XmlNode& node)
+{
+    auto color = node.get<std::string>(TextResources::BackgroundColor, {});
+    try
+    {
+        return Color::fromString(color.empty() ? "#00000000" : color);
+    }
+    catch (std::exception&)
+    {
+        return {};
+    }
+}
+
+// The conversion only checks the form of attribute values, Pango may still not know a color name
+bool TextParser::acceptedByPango(const std::string& markup)
+{
+    GError* error = nullptr;
+    if (pango_parse_markup(markup.c_str(), -1, 0, nullptr, nullptr, nullptr, &error)) return true;
+
+    Log::debug("[TextParser] Markup rejected by Pango: {}", error->message);
+    g_error_free(error);
+    return false;
+}
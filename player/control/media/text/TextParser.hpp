@@ -0,0 +1,20 @@
+#pragma once
+
+#include "control/media/text/TextMarkup.hpp"
+#include "control/media/webview/WebViewParser.hpp"
+
+// Text media is drawn natively when its HTML is simple enough for TextMarkup and its effect is a
+// plain marquee, otherwise it's rendered by WebKit as before
+class TextParser : public WebViewParser
+{
+protected:
+    std::unique_ptr<Xibo::Media> createMedia(const MediaOptions& options,
+                                             const XmlNode& node,
+                                             int width,
+                                             int height) override;
+
+private:
+    boost::optional<Xibo::Text::Scroll> scrollFrom(const XmlNode& node);
+    boost::optional<Color> backgroundFrom(const XmlNode& node);
+    bool acceptedByPango(const std::string& markup);
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "common/parsing/Parsing.hpp"
+#include "control/XlfResources.hpp"
+
+namespace XlfResources::Text
+{
+    const std::string Effect = Parsing::xmlOption("effect");
+    const std::string Speed = Parsing::xmlOption("speed");
+    const std::string BackgroundColor = Parsing::xmlOption("backgroundColor");
+    const std::string FitText = Parsing::xmlOption("fitText");
+    const std::string Html = "raw.text";
+    const std::string JavaScript = "raw.javaScript";
+
+    const std::string NoEffect = "none";
+    const std::string MarqueeLeft = "marqueeLeft";
+    const std::string MarqueeRight = "marqueeRight";
+    const std::string MarqueeUp = "marqueeUp";
+    const std::string MarqueeDown = "marqueeDown";
+}
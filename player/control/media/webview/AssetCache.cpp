@@ -0,0 +1,115 @@
+#include "AssetCache.hpp"
+
+#include "networking/ContentCoding.hpp"
+
+#include <array>
+
+// Only stored when it saves at least a tenth, small or already compressed files are sent as is
+const size_t MinGzipSavingRatio = 10;
+const std::string_view HtmlType = "text/html";
+const std::array<std::string_view, 6> CompressibleTypes{
+    "application/javascript", "application/json", "application/xml", "image/svg+xml", "font/ttf", "font/otf"};
+
+static bool compressible(std::string_view contentType)
+{
+    if (contentType.substr(0, 5) == "text/") return true;
+
+    for (auto&& type : CompressibleTypes)
+    {
+        if (contentType == type) return true;
+    }
+    return false;
+}
+
+AssetCache::AssetCache(size_t budget) : budget_{budget} {}
+
+std::shared_ptr<const AssetCache::Asset> AssetCache::find(const std::string& key)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    auto it = index_.find(key);
+    if (it == index_.end()) return nullptr;
+
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+}
+
+uint64_t AssetCache::generation() const
+{
+    return generation_;
+}
+
+void AssetCache::insert(const std::string& key, std::shared_ptr<const Asset> asset, uint64_t generation)
+{
+    auto size = memoryUsage(*asset);
+    if (size > budget_) return;
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    if (generation != generation_) return;
+
+    if (auto it = index_.find(key); it != index_.end())
+    {
+        used_ -= memoryUsage(*it->second->second);
+        entries_.erase(it->second);
+        index_.erase(it);
+    }
+
+    entries_.emplace_front(key, std::move(asset));
+    index_[key] = entries_.begin();
+    used_ += size;
+    evict();
+}
+
+void AssetCache::invalidate(const std::string& key)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    ++generation_;
+
+    auto it = index_.find(key);
+    if (it == index_.end()) return;
+
+    used_ -= memoryUsage(*it->second->second);
+    entries_.erase(it->second);
+    index_.erase(it);
+}
+
+std::shared_ptr<const AssetCache::Asset> AssetCache::makeAsset(std::string content,
+                                                               std::string etag,
+                                                               std::time_t lastModified,
+                                                               std::string_view contentType)
+{
+    auto asset = std::make_shared<Asset>();
+    if (compressible(contentType))
+    {
+        auto gzipped = ContentEncoder::gzip(content);
+        if (gzipped.size() + content.size() / MinGzipSavingRatio <= content.size())
+        {
+            asset->gzipped = std::move(gzipped);
+        }
+    }
+    if (contentType == HtmlType)
+    {
+        asset->viewPort = ViewPortTemplate::compile(content);
+    }
+    asset->content = std::move(content);
+    asset->etag = std::move(etag);
+    asset->lastModified = lastModified;
+    asset->contentType = std::string{contentType};
+    return asset;
+}
+
+size_t AssetCache::memoryUsage(const Asset& asset)
+{
+    return asset.content.size() + asset.gzipped.size();
+}
+
+void AssetCache::evict()
+{
+    while (used_ > budget_ && !entries_.empty())
+    {
+        auto&& [key, asset] = entries_.back();
+        used_ -= memoryUsage(*asset);
+        index_.erase(key);
+        entries_.pop_back();
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "control/media/webview/ViewPortTemplate.hpp"
+
+#include <atomic>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Small, frequently requested widget files (HTML, JS, CSS, fonts) kept in memory so that repeated
+// loads don't touch the disk. Text types also keep a gzip variant for clients which accept it.
+// The least recently used entries are evicted once the budget is exceeded and an entry is dropped
+// as soon as FileCache saves a new version of its file.
+class AssetCache
+{
+public:
+    static constexpr const size_t MaxAssetSize = 512 * 1024;
+
+    struct Asset
+    {
+        std::string content;
+        std::string gzipped;  // empty when compression doesn't pay off
+        std::string etag;
+        std::time_t lastModified;
+        std::string contentType;
+        ViewPortTemplate viewPort;  // HTML only
+    };
+
+    explicit AssetCache(size_t budget);
+
+    std::shared_ptr<const Asset> find(const std::string& key);
+
+    // generation() taken before the file was read, an asset read while the file was replaced is
+    // not stored
+    uint64_t generation() const;
+    void insert(const std::string& key, std::shared_ptr<const Asset> asset, uint64_t generation);
+    void invalidate(const std::string& key);
+
+    static std::shared_ptr<const Asset> makeAsset(std::string content,
+                                                  std::string etag,
+                                                  std::time_t lastModified,
+                                                  std::string_view contentType);
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const Asset>>;
+
+    static size_t memoryUsage(const Asset& asset);
+    void evict();
+
+private:
+    std::mutex mutex_;
+    std::atomic<uint64_t> generation_ = 0;
+    size_t budget_;
+    size_t used_ = 0;
+    std::list<Entry> entries_;  // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
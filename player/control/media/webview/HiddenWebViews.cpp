@@ -0,0 +1,18 @@
+#include "HiddenWebViews.hpp"
+
+#include <string>
+
+std::istream& operator>>(std::istream& in, HiddenWebViews& policy)
+{
+    std::string temp;
+    in >> temp;
+
+    if (temp == "keep")
+        policy = HiddenWebViews::Keep;
+    else if (temp == "unload")
+        policy = HiddenWebViews::Unload;
+    else
+        in.setstate(std::ios_base::failbit);
+
+    return in;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <istream>
+
+// What happens to the page of a web view while its media isn't playing. A hidden page already stops
+// animations and gets its timers throttled by WebKit, unloading it also stops scripts and network
+// polling at the cost of loading the page again when the media starts. Pages are kept unless a layout
+// or the player settings ask for unloading.
+enum class HiddenWebViews
+{
+    Keep,
+    Unload
+};
+
+// "keep" or "unload"
+std::istream& operator>>(std::istream& in, HiddenWebViews& policy);
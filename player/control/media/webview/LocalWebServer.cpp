@@ -1,34 +1,390 @@
 #include "LocalWebServer.hpp"
 
 #include "common/logger/Logging.hpp"
+#include "common/types/ByteRange.hpp"
+#include "common/types/HttpFreshness.hpp"
+#include "networking/HttpClient.hpp"
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <regex>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unordered_map>
 
 const std::string XiboLocalWebServer = "Xibo Local WebSerbver";
 const std::string DefaultLocalAddress = "127.0.0.1";
 const int DefaultThreadsCount = 2;
+const std::chrono::seconds DefaultIdleTimeout{60};
+const std::string SharedFilesPrefix = "/files/";
+const size_t Md5HexSize = 32;
+const std::string ProxiedScheme = "http://";
+const std::string ViewPortWidthParameter = "viewPortWidth=";
+const int MaxViewPortWidth = 100000;
+const std::regex OpenByteRange{R"(^\s*bytes\s*=\s*(\d{1,18})\s*-\s*$)", std::regex::icase};
+
+static LogRateLimiter g_sessionErrorsLimiter{1, 10};
+
+const std::unordered_map<std::string, beast::string_view> MimeTypes{{".htm", "text/html"},
+                                                                   {".html", "text/html"},
+                                                                   {".php", "text/html"},
+                                                                   {".css", "text/css"},
+                                                                   {".txt", "text/plain"},
+                                                                   {".js", "application/javascript"},
+                                                                   {".json", "application/json"},
+                                                                   {".xml", "application/xml"},
+                                                                   {".svg", "image/svg+xml"},
+                                                                   {".png", "image/png"},
+                                                                   {".jpg", "image/jpeg"},
+                                                                   {".jpeg", "image/jpeg"},
+                                                                   {".gif", "image/gif"},
+                                                                   {".webp", "image/webp"},
+                                                                   {".woff", "font/woff"},
+                                                                   {".woff2", "font/woff2"},
+                                                                   {".ttf", "font/ttf"},
+                                                                   {".otf", "font/otf"},
+                                                                   {".mp4", "video/mp4"},
+                                                                   {".webm", "video/webm"}};
 
 beast::string_view mimeType(const FilePath& path)
 {
-    using beast::iequals;
-    auto const extension = [path = path.string()] {
-        auto const pos = path.rfind(".");
-        if (pos == beast::string_view::npos) return std::string{};
-        return path.substr(pos);
+    auto type = MimeTypes.find(path.extension().string());
+    if (type == MimeTypes.end()) return "application/text";
+
+    return type->second;
+}
+
+std::string httpDate(std::time_t time)
+{
+    std::tm tm{};
+    gmtime_r(&time, &tm);
+
+    char date[64];
+    auto size = std::strftime(date, sizeof(date), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    return std::string(date, size);
+}
+
+// Files the player writes are replaced as a whole, so modification time and size identify a version
+// as well as a content hash without reading the file
+std::string entityTag(const struct stat& info)
+{
+    return fmt::format("\"{:x}-{:x}\"", info.st_mtime, info.st_size);
+}
+
+template <class Request>
+bool notModified(const Request& req, const std::string& etag, std::time_t lastModified)
+{
+    auto ifNoneMatch = req[http::field::if_none_match];
+    if (!ifNoneMatch.empty())
+    {
+        return ifNoneMatch == "*" || ifNoneMatch.find(etag) != beast::string_view::npos;
+    }
+
+    auto date = req[http::field::if_modified_since];
+    auto ifModifiedSince = parseHttpDate(std::string_view{date.data(), date.size()});
+    return ifModifiedSince && lastModified <= *ifModifiedSince;
+}
+
+boost::optional<std::string> sharedFileHash(beast::string_view target)
+{
+    if (!target.starts_with(SharedFilesPrefix)) return {};
+
+    auto hash = target.substr(SharedFilesPrefix.size());
+    if (hash.size() != Md5HexSize || !std::all_of(hash.begin(), hash.end(), ::isxdigit)) return {};
+
+    return std::string{hash};
+}
+
+// each representation needs its own tag so that caches don't mix them up
+std::string gzipEntityTag(const std::string& etag)
+{
+    return etag.substr(0, etag.size() - 1) + "-gz\"";
+}
+
+std::string viewPortEntityTag(const std::string& etag, int width)
+{
+    return etag.substr(0, etag.size() - 1) + "-w" + std::to_string(width) + "\"";
+}
+
+// WebViewFactory asks for widget HTML rendered for the width of its region with ?viewPortWidth=<width>
+boost::optional<int> viewPortWidth(beast::string_view query)
+{
+    std::vector<std::string> parameters;
+    boost::split(parameters, query, boost::is_any_of("&"));
+    for (auto&& parameter : parameters)
+    {
+        if (parameter.compare(0, ViewPortWidthParameter.size(), ViewPortWidthParameter) != 0) continue;
+
+        auto value = parameter.substr(ViewPortWidthParameter.size());
+        if (value.empty() || value.size() > 6 || !std::all_of(value.begin(), value.end(), ::isdigit)) return {};
+
+        auto width = std::stoi(value);
+        if (width <= 0 || width > MaxViewPortWidth) return {};
+        return width;
+    }
+    return {};
+}
+
+bool acceptsGzip(beast::string_view acceptEncoding)
+{
+    std::vector<std::string> codings;
+    boost::split(codings, acceptEncoding, boost::is_any_of(","));
+    for (auto&& coding : codings)
+    {
+        auto parameters = coding.find(';');
+        if (boost::trim_copy(coding.substr(0, parameters)) != "gzip") continue;
+
+        // "gzip;q=0" refuses it
+        auto quality = parameters == std::string::npos ? std::string{} : coding.substr(parameters);
+        return quality.find("q=0") == std::string::npos || quality.find("q=0.") != std::string::npos;
+    }
+    return false;
+}
+
+template <class Body>
+void setCacheHeaders(http::response<Body>& response,
+                     const std::string& etag,
+                     std::time_t lastModified,
+                     const std::string& cacheControl,
+                     bool keepAlive)
+{
+    response.set(http::field::server, XiboLocalWebServer);
+    response.set(http::field::etag, etag);
+    response.set(http::field::last_modified, httpDate(lastModified));
+    if (!cacheControl.empty())
+    {
+        response.set(http::field::cache_control, cacheControl);
+    }
+    response.keep_alive(keepAlive);
+}
+
+// Range is only honoured while the If-Range validator, if any, still matches the representation
+template <class Request>
+boost::optional<ByteRanges> requestedRanges(const Request& req,
+                                            const std::string& etag,
+                                            std::time_t lastModified,
+                                            uint64_t size)
+{
+    auto range = req[http::field::range];
+    if (range.empty()) return {};
+
+    auto ifRange = req[http::field::if_range];
+    if (!ifRange.empty() && ifRange != etag && ifRange != httpDate(lastModified)) return {};
+
+    return parseByteRanges(std::string_view{range.data(), range.size()}, size);
+}
+
+const std::string& multipartBoundary()
+{
+    static const std::string boundary = [] {
+        std::random_device random;
+        return fmt::format("xibo-byteranges-{:08x}{:08x}", random(), random());
     }();
+    return boundary;
+}
 
-    if (extension == ".htm") return "text/html";
-    if (extension == ".html") return "text/html";
-    if (extension == ".php") return "text/html";
-    if (extension == ".css") return "text/css";
-    if (extension == ".txt") return "text/plain";
-    if (extension == ".js") return "application/javascript";
-    if (extension == ".json") return "application/json";
-    if (extension == ".xml") return "application/xml";
+std::string contentRange(const ByteRange& range, uint64_t size)
+{
+    return fmt::format("bytes {}-{}/{}", range.first, range.first + range.length - 1, size);
+}
 
-    return "application/text";
+// Part headers of a multipart/byteranges body, each followed by its range of the content
+std::vector<FileResponse::Segment> multipartSegments(const ByteRanges& ranges,
+                                                     beast::string_view contentType,
+                                                     uint64_t size)
+{
+    std::vector<FileResponse::Segment> segments;
+    for (auto&& range : ranges)
+    {
+        auto prefix = fmt::format("\r\n--{}\r\nContent-Type: {}\r\nContent-Range: {}\r\n\r\n",
+                                  multipartBoundary(),
+                                  std::string_view{contentType.data(), contentType.size()},
+                                  contentRange(range, size));
+        segments.push_back(FileResponse::Segment{std::move(prefix), range.first, range.length});
+    }
+    return segments;
+}
+
+std::string multipartTrailer()
+{
+    return "\r\n--" + multipartBoundary() + "--\r\n";
+}
+
+template <class Request>
+http::response<http::empty_body> rangeNotSatisfiable(const Request& req, uint64_t size)
+{
+    http::response<http::empty_body> response{http::status::range_not_satisfiable, req.version()};
+    response.set(http::field::server, XiboLocalWebServer);
+    response.set(http::field::content_range, fmt::format("bytes */{}", size));
+    response.keep_alive(req.keep_alive());
+    response.content_length(0);
+    return response;
+}
+
+// Rendered for every request as the splice is cheaper than keeping a copy per width. The HTML is
+// small and only goes to the local web views, so it's sent as is without compression or ranges.
+template <class Request, class Send>
+void sendViewPort(const Request& req,
+                  const std::shared_ptr<const AssetCache::Asset>& asset,
+                  int width,
+                  const CacheControlRules& cacheControl,
+                  Send&& send)
+{
+    auto etag = viewPortEntityTag(asset->etag, width);
+    auto&& cacheControlValue = cacheControl.forType(asset->contentType);
+
+    if (notModified(req, etag, asset->lastModified))
+    {
+        http::response<http::empty_body> response{http::status::not_modified, req.version()};
+        setCacheHeaders(response, etag, asset->lastModified, cacheControlValue, req.keep_alive());
+        return send(std::move(response));
+    }
+
+    http::response<http::string_body> response{http::status::ok, req.version()};
+    setCacheHeaders(response, etag, asset->lastModified, cacheControlValue, req.keep_alive());
+    response.set(http::field::content_type, asset->contentType);
+    response.body() = asset->viewPort.render(asset->content, width);
+    response.prepare_payload();
+    return send(std::move(response));
+}
+
+template <class Request, class Send>
+void sendAsset(const Request& req,
+               const std::shared_ptr<const AssetCache::Asset>& asset,
+               boost::optional<int> viewPortWidth,
+               const CacheControlRules& cacheControl,
+               Send&& send)
+{
+    if (viewPortWidth && !asset->viewPort.empty()) return sendViewPort(req, asset, *viewPortWidth, cacheControl, send);
+
+    bool gzip = !asset->gzipped.empty() && acceptsGzip(req[http::field::accept_encoding]);
+    auto etag = gzip ? gzipEntityTag(asset->etag) : asset->etag;
+    auto&& cacheControlValue = cacheControl.forType(asset->contentType);
+
+    if (notModified(req, etag, asset->lastModified))
+    {
+        http::response<http::empty_body> response{http::status::not_modified, req.version()};
+        setCacheHeaders(response, etag, asset->lastModified, cacheControlValue, req.keep_alive());
+        return send(std::move(response));
+    }
+
+    // ranges refer to the identity representation whatever the client accepts
+    auto size = static_cast<uint64_t>(asset->content.size());
+    auto ranges = requestedRanges(req, asset->etag, asset->lastModified, size);
+    if (ranges && ranges->empty()) return send(rangeNotSatisfiable(req, size));
+    if (ranges && ranges->size() > 1)
+    {
+        http::response<http::string_body> response{http::status::partial_content, req.version()};
+        setCacheHeaders(response, asset->etag, asset->lastModified, cacheControlValue, req.keep_alive());
+        response.set(http::field::accept_ranges, "bytes");
+        response.set(http::field::content_type, "multipart/byteranges; boundary=" + multipartBoundary());
+        for (auto&& segment : multipartSegments(*ranges, asset->contentType, size))
+        {
+            response.body().append(segment.prefix).append(asset->content, segment.offset, segment.length);
+        }
+        response.body().append(multipartTrailer());
+        response.prepare_payload();
+        return send(std::move(response));
+    }
+    if (ranges)
+    {
+        auto&& range = ranges->front();
+        http::response<http::span_body<const char>> response{http::status::partial_content, req.version()};
+        setCacheHeaders(response, asset->etag, asset->lastModified, cacheControlValue, req.keep_alive());
+        response.set(http::field::accept_ranges, "bytes");
+        response.set(http::field::content_type, asset->contentType);
+        response.set(http::field::content_range, contentRange(range, size));
+        response.body() = {asset->content.data() + range.first, static_cast<size_t>(range.length)};
+        response.prepare_payload();
+        return send(AssetResponse{std::move(response), asset});
+    }
+
+    http::response<http::span_body<const char>> response{http::status::ok, req.version()};
+    setCacheHeaders(response, etag, asset->lastModified, cacheControlValue, req.keep_alive());
+    response.set(http::field::accept_ranges, "bytes");
+    response.set(http::field::content_type, asset->contentType);
+    if (!asset->gzipped.empty())
+    {
+        response.set(http::field::vary, "Accept-Encoding");
+    }
+    if (gzip)
+    {
+        response.set(http::field::content_encoding, "gzip");
+    }
+    auto&& body = gzip ? asset->gzipped : asset->content;
+    response.body() = {body.data(), body.size()};
+    response.prepare_payload();
+    return send(AssetResponse{std::move(response), asset});
+}
+
+// Sends a regular file with conditional and range requests honoured
+template <class Request, class Send>
+void sendFileContent(const Request& req,
+                     beast::file file,
+                     uint64_t size,
+                     beast::string_view contentType,
+                     const std::string& etag,
+                     std::time_t lastModified,
+                     const std::string& cacheControlValue,
+                     Send&& send)
+{
+    if (notModified(req, etag, lastModified))
+    {
+        http::response<http::empty_body> response{http::status::not_modified, req.version()};
+        setCacheHeaders(response, etag, lastModified, cacheControlValue, req.keep_alive());
+        return send(std::move(response));
+    }
+
+    auto ranges = requestedRanges(req, etag, lastModified, size);
+    if (ranges && ranges->empty()) return send(rangeNotSatisfiable(req, size));
+
+    // sendfile is given its own offsets so the file position moved by a failed read doesn't matter
+    FileResponse response{{http::status::ok, req.version()}, std::move(file), {}, {}};
+    auto&& header = response.header;
+    setCacheHeaders(header, etag, lastModified, cacheControlValue, req.keep_alive());
+    header.set(http::field::accept_ranges, "bytes");
+    if (!ranges)
+    {
+        header.set(http::field::content_type, contentType);
+        response.segments.push_back(FileResponse::Segment{{}, 0, size});
+    }
+    else if (ranges->size() == 1)
+    {
+        header.result(http::status::partial_content);
+        header.set(http::field::content_type, contentType);
+        header.set(http::field::content_range, contentRange(ranges->front(), size));
+        response.segments.push_back(FileResponse::Segment{{}, ranges->front().first, ranges->front().length});
+    }
+    else
+    {
+        header.result(http::status::partial_content);
+        header.set(http::field::content_type, "multipart/byteranges; boundary=" + multipartBoundary());
+        response.segments = multipartSegments(*ranges, contentType, size);
+        response.trailer = multipartTrailer();
+    }
+
+    uint64_t contentLength = response.trailer.size();
+    for (auto&& segment : response.segments)
+    {
+        contentLength += segment.prefix.size() + segment.length;
+    }
+    header.content_length(contentLength);
+    return send(std::move(response));
 }
 
 template <class Body, class Allocator, class Send>
-void handleRequest(const FilePath& rootDir, http::request<Body, http::basic_fields<Allocator>>&& req, Send&& send)
+void handleRequest(const FilePath& rootDir,
+                   const SharedFileResolver& sharedFiles,
+                   const CacheControlRules& cacheControl,
+                   AssetCache* assets,
+                   http::request<Body, http::basic_fields<Allocator>>&& req,
+                   Send&& send)
 {
     auto const badRequest = [&req](beast::string_view why) {
         http::response<http::string_body> response{http::status::bad_request, req.version()};
@@ -65,30 +421,289 @@ void handleRequest(const FilePath& rootDir, http::request<Body, http::basic_fiel
     if (req.target().empty() || req.target()[0] != '/' || req.target().find("..") != beast::string_view::npos)
         return send(badRequest("Illegal request-target"));
 
-    FilePath path{rootDir.string() + std::string{req.target()}};
+    auto target = req.target();
+    auto queryStart = target.find('?');
+    auto query = queryStart == beast::string_view::npos ? beast::string_view{} : target.substr(queryStart + 1);
+    target = target.substr(0, queryStart);
+    auto width = sharedFiles ? boost::none : viewPortWidth(query);
+
+    // taken before the file is read so that a version replaced meanwhile isn't cached
+    auto assetKey = std::string{target};
+    auto assetGeneration = assets ? assets->generation() : 0;
+    if (assets)
+    {
+        if (auto asset = assets->find(assetKey)) return sendAsset(req, asset, width, cacheControl, send);
+    }
+
+    FilePath path;
+    boost::optional<std::string> hash;
+    if (sharedFiles)
+    {
+        hash = sharedFileHash(target);
+        auto sharedFile = hash ? sharedFiles(*hash) : boost::none;
+        if (!sharedFile) return send(notFound(req.target()));
+
+        path = *sharedFile;
+    }
+    else
+    {
+        path = FilePath{rootDir.string() + std::string{target}};
+    }
 
     beast::error_code ec;
-    http::file_body::value_type body;
-    body.open(path.c_str(), beast::file_mode::scan, ec);
+    beast::file file;
+    file.open(path.c_str(), beast::file_mode::scan, ec);
 
     if (ec == beast::errc::no_such_file_or_directory) return send(notFound(req.target()));
 
     if (ec) return send(serverError(ec.message()));
 
-    const auto size = body.size();
+    struct stat info;
+    if (::fstat(file.native_handle(), &info) != 0) return send(serverError(std::strerror(errno)));
+    if (!S_ISREG(info.st_mode)) return send(notFound(req.target()));
+
+    // shared files are requested by their MD5 which makes the best entity tag
+    auto etag = hash ? "\"" + *hash + "\"" : entityTag(info);
+    auto contentType = sharedFiles ? beast::string_view{"application/octet-stream"} : mimeType(path);
+    auto&& cacheControlValue = cacheControl.forType(std::string_view{contentType.data(), contentType.size()});
+
+    // HTML rendered for a viewport has to be read even when it's too big to be cached
+    bool cacheable = assets && static_cast<uint64_t>(info.st_size) <= AssetCache::MaxAssetSize;
+    if (cacheable || (width && contentType == "text/html"))
+    {
+        std::string content(static_cast<size_t>(info.st_size), '\0');
+        auto read = file.read(content.data(), content.size(), ec);
+        if (!ec && read == content.size())
+        {
+            auto asset = AssetCache::makeAsset(
+                std::move(content), etag, info.st_mtime, std::string_view{contentType.data(), contentType.size()});
+            if (cacheable)
+            {
+                assets->insert(assetKey, asset, assetGeneration);
+            }
+            return sendAsset(req, asset, width, cacheControl, send);
+        }
+    }
 
-    http::response<http::file_body> response{
-        std::piecewise_construct, std::make_tuple(std::move(body)), std::make_tuple(http::status::ok, req.version())};
+    auto size = static_cast<uint64_t>(info.st_size);
+    return sendFileContent(req, std::move(file), size, contentType, etag, info.st_mtime, cacheControlValue, send);
+}
+
+template <class Request>
+http::response<http::string_body> proxyError(const Request& req, http::status status, const std::string& what)
+{
+    http::response<http::string_body> response{status, req.version()};
     response.set(http::field::server, XiboLocalWebServer);
-    response.set(http::field::content_type, mimeType(path));
-    response.content_length(size);
+    response.set(http::field::content_type, "text/plain");
+    response.set(http::field::cache_control, "no-store");
     response.keep_alive(req.keep_alive());
-    return send(std::move(response));
+    response.body() = what;
+    response.prepare_payload();
+    return response;
+}
+
+// Media elements ask for everything from an offset on. The origin is asked for no more than the proxy
+// keeps in memory and the element requests the rest after the partial response.
+static std::string boundedRange(const std::string& range, uint64_t maxLength)
+{
+    std::smatch match;
+    if (maxLength == 0 || !std::regex_match(range, match, OpenByteRange)) return range;
+
+    auto first = std::stoull(match[1].str());
+    return fmt::format("bytes={}-{}", first, first + maxLength - 1);
 }
 
-Session::Session(tcp::socket&& socket, const FilePath& doc_root) :
-    m_socket(std::move(socket)),
+// The browser may reuse a fresh copy for the rest of its lifetime, a stale one is asked for every time
+template <class Request, class Send>
+void sendCached(const Request& req, const ProxyCache::Entry& entry, std::time_t now, Send&& send)
+{
+    beast::error_code ec;
+    beast::file file;
+    file.open(entry.body.c_str(), beast::file_mode::scan, ec);
+
+    struct stat info;
+    if (ec || ::fstat(file.native_handle(), &info) != 0)
+        return send(proxyError(req, http::status::bad_gateway, "Cached copy is unavailable"));
+
+    auto cacheControlValue = entry.fresh(now) ? "max-age=" + std::to_string(entry.expires - now) : "no-cache";
+    auto size = static_cast<uint64_t>(info.st_size);
+    auto etag = entityTag(info);
+    sendFileContent(req, std::move(file), size, entry.contentType, etag, info.st_mtime, cacheControlValue, send);
+}
+
+static std::string_view headerField(const http::response_header<>& header, http::field name)
+{
+    auto value = header[name];
+    return std::string_view{value.data(), value.size()};
+}
+
+// The origin confirmed a stale copy, which is renewed with the caching fields of the 304 and served
+// without downloading or rewriting its body
+template <class Request, class Send>
+void sendRevalidated(const Request& req,
+                     ProxyCache& cache,
+                     const std::string& url,
+                     const ProxyCache::Entry& cached,
+                     const http::response_header<>& header,
+                     std::time_t now,
+                     Send&& send)
+{
+    HttpCachingFields stored{cached.cacheControl, {}, {}, cached.lastModified};
+    HttpCachingFields received{headerField(header, http::field::cache_control),
+                               headerField(header, http::field::expires),
+                               headerField(header, http::field::date),
+                               headerField(header, http::field::last_modified)};
+    auto fields = revalidatedFields(stored, received);
+
+    ProxyCache::Metadata metadata = cached;
+    metadata.cacheControl = std::string{fields.cacheControl};
+    metadata.lastModified = std::string{fields.lastModified};
+    if (auto etag = headerField(header, http::field::etag); !etag.empty())
+    {
+        metadata.etag = std::string{etag};
+    }
+    // a copy which mustn't be stored any more is revalidated on every request
+    auto freshness = httpFreshness(fields, now);
+    metadata.expires = now + (freshness ? freshness->lifetime.count() : 0);
+    metadata.staleAllowed = freshness ? freshness->staleAllowed : false;
+
+    auto entry = cache.refresh(url, metadata);
+    sendCached(req, entry ? *entry : cached, now, send);
+}
+
+template <class Request, class Send>
+void onProxyFetched(const Request& req,
+                    ProxyCache& cache,
+                    const std::string& url,
+                    const boost::optional<ProxyCache::Entry>& cached,
+                    bool ranged,
+                    HttpFetchResult result,
+                    Send&& send)
+{
+    auto now = std::time(nullptr);
+    auto&& [error, fetched] = result;
+    auto&& header = fetched.header ? *fetched.header : http::response_header<>{};
+    auto field = [&header](http::field name) { return headerField(header, name); };
+
+    if (cached && fetched.header && header.result() == http::status::not_modified)
+        return sendRevalidated(req, cache, url, *cached, header, now, send);
+
+    if (!error)
+    {
+        auto contentType = std::string{field(http::field::content_type)};
+        HttpCachingFields caching{field(http::field::cache_control),
+                                  field(http::field::expires),
+                                  field(http::field::date),
+                                  field(http::field::last_modified)};
+        auto freshness = ranged ? boost::none : httpFreshness(caching, now);
+        if (freshness)
+        {
+            ProxyCache::Metadata metadata{contentType,
+                                          now + freshness->lifetime.count(),
+                                          freshness->staleAllowed,
+                                          std::string{caching.cacheControl},
+                                          std::string{field(http::field::etag)},
+                                          std::string{caching.lastModified}};
+            auto entry = cache.store(url, metadata, fetched.body);
+            if (entry) return sendCached(req, *entry, now, send);
+        }
+
+        http::response<http::string_body> response{header.result(), req.version()};
+        response.set(http::field::server, XiboLocalWebServer);
+        response.set(http::field::content_type, contentType);
+        if (auto contentRange = header[http::field::content_range]; !contentRange.empty())
+        {
+            response.set(http::field::content_range, contentRange);
+        }
+        response.set(http::field::cache_control, "no-store");
+        response.keep_alive(req.keep_alive());
+        response.body() = std::move(fetched.body);
+        response.prepare_payload();
+        return send(std::move(response));
+    }
+
+    // redirects and client errors are the origin's answer, only an unreachable origin is replaced
+    if (fetched.header && http::to_status_class(header.result()) != http::status_class::server_error)
+    {
+        http::response<http::string_body> response{header.result(), req.version()};
+        response.set(http::field::server, XiboLocalWebServer);
+        if (auto location = header[http::field::location]; !location.empty())
+        {
+            response.set(http::field::location, location);
+        }
+        response.set(http::field::cache_control, "no-store");
+        response.keep_alive(req.keep_alive());
+        response.prepare_payload();
+        return send(std::move(response));
+    }
+
+    if (cached && cached->staleAllowed)
+    {
+        Log::debug("[WebServer] Stale {} is served: {}", url, error.message());
+        return sendCached(req, *cached, now, send);
+    }
+    return send(proxyError(req, http::status::bad_gateway, error.message()));
+}
+
+// Remote pages are requested in absolute form. Only GET is supported as cached responses are shared
+// by all web views and the request is sent without the browser's own fields like cookies. Bodies are
+// held in memory until they're complete, so they're limited to what the cache would store. Range
+// requests are passed on to the origin and their responses aren't cached. A stale copy is revalidated
+// with its validators, so an unchanged one isn't downloaded again.
+template <class Body, class Allocator, class Send>
+void handleProxyRequest(const std::shared_ptr<ProxyCache>& cache,
+                        http::request<Body, http::basic_fields<Allocator>>&& req,
+                        Send&& send)
+{
+    if (req.method() != http::verb::get)
+        return send(proxyError(req, http::status::method_not_allowed, "Proxy supports only GET requests"));
+
+    auto url = std::string{req.target()};
+    auto now = std::time(nullptr);
+    auto cached = cache->find(url);
+    if (cached && cached->fresh(now)) return sendCached(req, *cached, now, send);
+
+    boost::optional<Uri> uri;
+    try
+    {
+        uri = Uri::fromString(url);
+    }
+    catch (std::exception& e)
+    {
+        return send(proxyError(req, http::status::bad_request, e.what()));
+    }
+
+    // a stale copy is better than waiting for retries while the origin is unreachable
+    auto retry = cached && cached->staleAllowed ? RequestRetry::None : RequestRetry::Idempotent;
+    auto range = std::string{req[http::field::range]};
+    HttpFetchOptions options{boundedRange(range, cache->maxEntrySize()), cache->maxEntrySize()};
+    if (cached)
+    {
+        options.ifNoneMatch = cached->etag;
+        options.ifModifiedSince = cached->lastModified;
+    }
+    HttpClient::instance().fetch(*uri, retry, options).then(
+        [req = std::move(req), cache, url, cached, ranged = !range.empty(), send](
+            boost::future<HttpFetchResult> future) {
+            onProxyFetched(req, *cache, url, cached, ranged, future.get(), send);
+        });
+}
+
+Session::Session(tcp::socket&& socket,
+                 const FilePath& doc_root,
+                 const SharedFileResolver& sharedFiles,
+                 const CacheControlRules& cacheControl,
+                 const std::shared_ptr<AssetCache>& assets,
+                 const std::shared_ptr<ProxyCache>& proxy,
+                 std::chrono::seconds idleTimeout) :
+    m_stream(std::move(socket)),
+    m_sendTimer(m_stream.get_executor()),
     m_rootDirectory(doc_root),
+    m_sharedFiles(sharedFiles),
+    m_cacheControl(cacheControl),
+    m_assets(assets),
+    m_proxy(proxy),
+    m_idleTimeout(idleTimeout),
     m_lambda(*this)
 {
 }
@@ -102,28 +717,43 @@ void Session::doRead()
 {
     m_request = {};
 
-    //    socket_.expires_after(std::chrono::seconds(30));
+    // idle keep-alive connections and stalled clients don't hold a worker forever
+    m_stream.expires_after(m_idleTimeout);
 
-    http::async_read(m_socket, m_buffer, m_request, std::bind(&Session::onRead, shared_from_this(), ph::_1, ph::_2));
+    http::async_read(m_stream, m_buffer, m_request, std::bind(&Session::onRead, shared_from_this(), ph::_1, ph::_2));
 }
 
 void Session::onRead(beast::error_code ec, std::size_t /*bytesTransferred*/)
 {
-    if (ec == http::error::end_of_stream) return close();
+    if (ec == http::error::end_of_stream || ec == beast::error::timeout) return close();
 
     if (!ec)
     {
-        handleRequest(m_rootDirectory, std::move(m_request), m_lambda);
+        if (m_proxy && m_request.target().starts_with(ProxiedScheme)) return proxyRequest();
+
+        handleRequest(m_rootDirectory, m_sharedFiles, m_cacheControl, m_assets.get(), std::move(m_request), m_lambda);
     }
     else
     {
         /* WebKitGTK sometimes resets connection but it's not a fatal error and we will reconnect */
         if (ec == net::error::connection_reset) return;
 
-        Log::error("[WebServer] Read Error: {}", ec.message());
+        Log::limited(g_sessionErrorsLimiter, spdlog::level::err, "[WebServer] Read Error: {}", ec.message());
     }
 }
 
+// The response to a request which isn't cached is sent from an HttpClient thread once the origin answers
+void Session::proxyRequest()
+{
+    auto send = [self = shared_from_this()](auto&& response) {
+        net::dispatch(self->m_stream.get_executor(), [self, response = std::move(response)]() mutable {
+            self->m_stream.expires_after(self->m_idleTimeout);
+            self->m_lambda(std::move(response));
+        });
+    };
+    handleProxyRequest(m_proxy, std::move(m_request), send);
+}
+
 void Session::onWrite(bool shouldBeClosed, beast::error_code ec, std::size_t /*bytesTransferred*/)
 {
     if (!ec)
@@ -141,26 +771,112 @@ void Session::onWrite(bool shouldBeClosed, beast::error_code ec, std::size_t /*b
         /* WebKitGTK sometimes resets connection but it's not a fatal error and we will reconnect */
         if (ec == net::error::connection_reset || ec == net::error::broken_pipe) return;
 
-        Log::error("[WebServer] Write Error: {}", ec.message());
+        Log::limited(g_sessionErrorsLimiter, spdlog::level::err, "[WebServer] Write Error: {}", ec.message());
     }
 }
 
-void Session::close()
+void Session::sendFile(FileResponse&& response)
 {
-    beast::error_code ec;
-    m_socket.shutdown(tcp::socket::shutdown_send, ec);
+    auto file = std::make_shared<FileResponse>(std::move(response));
+    auto serializer = std::make_shared<http::response_serializer<http::empty_body>>(file->header);
+    m_response = file;
+
+    m_stream.expires_after(m_idleTimeout);
+    http::async_write_header(
+        m_stream, *serializer, [self = shared_from_this(), file, serializer](beast::error_code ec, std::size_t) {
+            if (ec) return self->onWrite(false, ec, 0);
+
+            self->sendSegment(file, 0);
+        });
 }
 
-LocalWebServer::LocalWebServer() : work_(ioc_), acceptor_(ioc_)
+// Each segment is a multipart header, if any, followed by its part of the file
+void Session::sendSegment(std::shared_ptr<FileResponse> response, size_t index)
 {
-    for (int i = 0; i != DefaultThreadsCount; ++i)
+    if (index == response->segments.size())
     {
-        workerThreads_.push_back(std::make_unique<JoinableThread>([=]() {
-            Log::trace("[WebServer] Thread started");
+        if (response->trailer.empty()) return onWrite(response->header.need_eof(), {}, 0);
+
+        net::async_write(m_stream,
+                         net::buffer(response->trailer),
+                         [self = shared_from_this(), response](beast::error_code ec, std::size_t) {
+                             self->onWrite(response->header.need_eof(), ec, 0);
+                         });
+        return;
+    }
 
-            ioc_.run();
-        }));
+    auto&& segment = response->segments[index];
+    m_fileOffset = static_cast<off_t>(segment.offset);
+    if (segment.prefix.empty()) return doSendFile(response, index);
+
+    net::async_write(m_stream,
+                     net::buffer(segment.prefix),
+                     [self = shared_from_this(), response, index](beast::error_code ec, std::size_t) {
+                         if (ec) return self->onWrite(false, ec, 0);
+
+                         self->doSendFile(response, index);
+                     });
+}
+
+// The socket is non-blocking so a full send buffer ends the loop and writing resumes once it drains
+void Session::doSendFile(std::shared_ptr<FileResponse> response, size_t index)
+{
+    auto&& socket = m_stream.socket();
+    socket.native_non_blocking(true);
+
+    auto&& segment = response->segments[index];
+    auto end = static_cast<off_t>(segment.offset + segment.length);
+    while (m_fileOffset < end)
+    {
+        auto sent = ::sendfile(socket.native_handle(), response->file.native_handle(), &m_fileOffset,
+                               static_cast<size_t>(end - m_fileOffset));
+        if (sent > 0 || (sent < 0 && errno == EINTR)) continue;
+
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            auto onWritable = [self = shared_from_this(), response, index](beast::error_code ec) {
+                self->m_sendTimer.cancel();
+                if (ec == net::error::operation_aborted) return;
+                if (ec) return self->onWrite(false, ec, 0);
+
+                self->doSendFile(response, index);
+            };
+            m_sendTimer.expires_after(m_idleTimeout);
+            m_sendTimer.async_wait(std::bind(&Session::onSendStalled, shared_from_this(), ph::_1));
+            socket.async_wait(tcp::socket::wait_write, onWritable);
+            return;
+        }
+
+        // the file got shorter than the announced length
+        auto ec = sent == 0 ? beast::error_code{net::error::eof} : beast::error_code{errno, beast::system_category()};
+        return onWrite(false, ec, 0);
     }
+
+    sendSegment(response, index + 1);
+}
+
+// A reader which stops taking data would otherwise keep the session and its file open for good
+void Session::onSendStalled(beast::error_code ec)
+{
+    if (ec) return;
+
+    Log::limited(g_sessionErrorsLimiter, spdlog::level::err, "[WebServer] Closing stalled connection");
+    m_stream.socket().close(ec);
+}
+
+void Session::close()
+{
+    beast::error_code ec;
+    m_stream.socket().shutdown(tcp::socket::shutdown_send, ec);
+}
+
+LocalWebServer::LocalWebServer() :
+    work_(ioc_),
+    threadsCount_(DefaultThreadsCount),
+    idleTimeout_(DefaultIdleTimeout),
+    acceptor_(ioc_),
+    lanAcceptor_(ioc_)
+{
 }
 
 LocalWebServer::~LocalWebServer()
@@ -170,6 +886,15 @@ LocalWebServer::~LocalWebServer()
 
 void LocalWebServer::run(unsigned short port)
 {
+    for (int i = 0; i != threadsCount_; ++i)
+    {
+        workerThreads_.push_back(std::make_unique<JoinableThread>([=]() {
+            Log::trace("[WebServer] Thread started");
+
+            ioc_.run();
+        }));
+    }
+
     try
     {
         tcp::endpoint endpoint(net::ip::address::from_string(DefaultLocalAddress), port);
@@ -179,7 +904,7 @@ void LocalWebServer::run(unsigned short port)
         acceptor_.listen(net::socket_base::max_listen_connections);
         port_ = port;
 
-        doAccept();
+        doAccept(acceptor_, false);
     }
     catch (std::exception& e)
     {
@@ -197,21 +922,90 @@ void LocalWebServer::setRootDirectory(const FilePath& rootDirectory)
     rootDirectory_ = rootDirectory;
 }
 
-void LocalWebServer::doAccept()
+void LocalWebServer::setCacheControl(const CacheControlRules& cacheControl)
+{
+    cacheControl_ = cacheControl;
+}
+
+void LocalWebServer::setThreadsCount(int threadsCount)
+{
+    threadsCount_ = std::max(threadsCount, 1);
+}
+
+void LocalWebServer::setIdleTimeout(std::chrono::seconds idleTimeout)
+{
+    idleTimeout_ = idleTimeout;
+}
+
+void LocalWebServer::setAssetCacheSize(size_t bytes)
+{
+    assets_ = bytes != 0 ? std::make_shared<AssetCache>(bytes) : nullptr;
+}
+
+void LocalWebServer::setProxyCache(const FilePath& directory, uint64_t bytes)
+{
+    proxy_ = bytes != 0 ? std::make_shared<ProxyCache>(directory, bytes) : nullptr;
+}
+
+boost::optional<Uri> LocalWebServer::proxyAddress() const
+{
+    if (!proxy_) return {};
+
+    return Uri::fromString("http://" + DefaultLocalAddress + ":" + std::to_string(port_));
+}
+
+void LocalWebServer::invalidate(const std::string& fileName)
+{
+    if (assets_)
+    {
+        assets_->invalidate("/" + fileName);
+    }
+}
+
+void LocalWebServer::shareOnLan(const std::string& address, unsigned short port, SharedFileResolver sharedFiles)
+{
+    try
+    {
+        sharedFiles_ = std::move(sharedFiles);
+
+        tcp::endpoint endpoint(net::ip::address::from_string(address), port);
+        lanAcceptor_.open(endpoint.protocol());
+        lanAcceptor_.set_option(net::socket_base::reuse_address(true));
+        lanAcceptor_.bind(endpoint);
+        lanAcceptor_.listen(net::socket_base::max_listen_connections);
+
+        Log::info("[WebServer] Sharing files on {}:{}", address, port);
+        doAccept(lanAcceptor_, true);
+    }
+    catch (std::exception& e)
+    {
+        Log::error("[WebServer] LAN Establish Error: {}", e.what());
+    }
+}
+
+void LocalWebServer::doAccept(tcp::acceptor& acceptor, bool lan)
 {
-    acceptor_.async_accept(ioc_, std::bind(&LocalWebServer::onAccept, shared_from_this(), ph::_1, ph::_2));
+    // every connection gets its own strand as several threads run the handlers
+    auto onAccept = std::bind(&LocalWebServer::onAccept, shared_from_this(), std::ref(acceptor), lan, ph::_1, ph::_2);
+    acceptor.async_accept(net::make_strand(ioc_), onAccept);
 }
 
-void LocalWebServer::onAccept(beast::error_code ec, tcp::socket socket)
+void LocalWebServer::onAccept(tcp::acceptor& acceptor, bool lan, beast::error_code ec, tcp::socket socket)
 {
     if (!ec)
     {
-        std::make_shared<Session>(std::move(socket), rootDirectory_)->run();
+        // shared media is large and requested once by each peer, so it isn't worth memory
+        auto sharedFiles = lan ? sharedFiles_ : SharedFileResolver{};
+        auto assets = lan ? nullptr : assets_;
+        auto proxy = lan ? nullptr : proxy_;
+        auto session = std::make_shared<Session>(
+            std::move(socket), rootDirectory_, sharedFiles, cacheControl_, assets, proxy, idleTimeout_);
+        session->run();
     }
     else
     {
         Log::error("[WebSerber] Accept Connection Error: {}", ec.message());
     }
 
-    doAccept();
+    doAccept(acceptor, lan);
 }
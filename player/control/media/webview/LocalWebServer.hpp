@@ -1,12 +1,20 @@
+#pragma once
+
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/beast/version.hpp>
 #include <boost/config.hpp>
+#include <boost/optional/optional.hpp>
+
+#include "control/media/webview/AssetCache.hpp"
+#include "control/media/webview/ProxyCache.hpp"
 
 #include "common/JoinableThread.hpp"
 #include "common/fs/FilePath.hpp"
+#include "common/types/CacheControlRules.hpp"
 #include "common/types/Uri.hpp"
 
 namespace beast = boost::beast;
@@ -15,6 +23,33 @@ namespace net = boost::asio;
 using tcp = boost::asio::ip::tcp;
 namespace ph = std::placeholders;
 
+// Maps an MD5 from a LAN peer's request to a validated file which may be sent to it
+using SharedFileResolver = std::function<boost::optional<FilePath>(const std::string& md5)>;
+
+// File contents go from the page cache to the socket with sendfile(2) once the header is written.
+// A multipart/byteranges body interleaves part headers with ranges of the file.
+struct FileResponse
+{
+    struct Segment
+    {
+        std::string prefix;  // written before the range
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    http::response<http::empty_body> header;
+    beast::file file;
+    std::vector<Segment> segments;
+    std::string trailer;
+};
+
+// Body served from an AssetCache entry which is kept alive until the response is written
+struct AssetResponse
+{
+    http::response<http::span_body<const char>> message;
+    std::shared_ptr<const AssetCache::Asset> asset;
+};
+
 class Session : public std::enable_shared_from_this<Session>
 {
     struct SendLambda
@@ -28,14 +63,35 @@ class Session : public std::enable_shared_from_this<Session>
         {
             auto sp = std::make_shared<http::message<isRequest, Body, Fields>>(std::move(msg));
             self.m_response = sp;
-            http::async_write(self.m_socket,
+            http::async_write(self.m_stream,
                               *sp,
                               std::bind(&Session::onWrite, self.shared_from_this(), sp->need_eof(), ph::_1, ph::_2));
         }
+
+        void operator()(FileResponse&& response) const
+        {
+            self.sendFile(std::move(response));
+        }
+
+        void operator()(AssetResponse&& response) const
+        {
+            auto sp = std::make_shared<AssetResponse>(std::move(response));
+            self.m_response = sp;
+            http::async_write(
+                self.m_stream,
+                sp->message,
+                std::bind(&Session::onWrite, self.shared_from_this(), sp->message.need_eof(), ph::_1, ph::_2));
+        }
     };
 
 public:
-    Session(tcp::socket&& socket, const FilePath& rootDirectory);
+    Session(tcp::socket&& socket,
+            const FilePath& rootDirectory,
+            const SharedFileResolver& sharedFiles,
+            const CacheControlRules& cacheControl,
+            const std::shared_ptr<AssetCache>& assets,
+            const std::shared_ptr<ProxyCache>& proxy,
+            std::chrono::seconds idleTimeout);
 
     void run();
     void close();
@@ -43,14 +99,27 @@ public:
 private:
     void doRead();
     void onRead(beast::error_code ec, std::size_t /*bytesTransferred*/);
+    void proxyRequest();
     void onWrite(bool shouldBeClosed, beast::error_code ec, std::size_t /*bytesTransferred*/);
+    void sendFile(FileResponse&& response);
+    void sendSegment(std::shared_ptr<FileResponse> response, size_t index);
+    void doSendFile(std::shared_ptr<FileResponse> response, size_t index);
+    void onSendStalled(beast::error_code ec);
 
 private:
-    net::ip::tcp::socket m_socket;
+    beast::tcp_stream m_stream;
+    // sendfile waits on the raw socket, which the stream's own expiry doesn't cover
+    net::steady_timer m_sendTimer;
     beast::flat_buffer m_buffer;
     const FilePath m_rootDirectory;
+    const SharedFileResolver m_sharedFiles;
+    const CacheControlRules m_cacheControl;
+    const std::shared_ptr<AssetCache> m_assets;
+    const std::shared_ptr<ProxyCache> m_proxy;
+    const std::chrono::seconds m_idleTimeout;
     http::request<http::string_body> m_request;
     std::shared_ptr<void> m_response;
+    off_t m_fileOffset = 0;
     SendLambda m_lambda;
 };
 
@@ -60,19 +129,42 @@ public:
     LocalWebServer();
     ~LocalWebServer();
 
+    // threads and the idle timeout of keep-alive connections are set before run
+    void setThreadsCount(int threadsCount);
+    void setIdleTimeout(std::chrono::seconds idleTimeout);
     void run(unsigned short port);
     Uri address() const;
     void setRootDirectory(const FilePath& rootDirectory);
+    void setCacheControl(const CacheControlRules& cacheControl);
+    // 0 disables the in-memory cache of small files
+    void setAssetCacheSize(size_t bytes);
+    // Web views send requests for remote http:// pages here when the proxy is enabled, its responses
+    // are cached on disk up to the given size. 0 disables the proxy.
+    void setProxyCache(const FilePath& directory, uint64_t bytes);
+    boost::optional<Uri> proxyAddress() const;
+    // drops the cached copy of a file from the root directory after it has been replaced
+    void invalidate(const std::string& fileName);
+
+    // Lets other players on the LAN fetch downloaded media by its MD5 at /files/<md5>. Nothing else is
+    // served on this address so widgets and layouts stay local.
+    void shareOnLan(const std::string& address, unsigned short port, SharedFileResolver sharedFiles);
 
 private:
-    void doAccept();
-    void onAccept(beast::error_code ec, tcp::socket socket);
+    void doAccept(tcp::acceptor& acceptor, bool lan);
+    void onAccept(tcp::acceptor& acceptor, bool lan, beast::error_code ec, tcp::socket socket);
 
 private:
     net::io_context ioc_;
     net::io_context::work work_;
     std::vector<std::unique_ptr<JoinableThread>> workerThreads_;
+    int threadsCount_;
+    std::chrono::seconds idleTimeout_;
     unsigned short port_ = 0;
     tcp::acceptor acceptor_;
+    tcp::acceptor lanAcceptor_;
     FilePath rootDirectory_;
+    SharedFileResolver sharedFiles_;
+    CacheControlRules cacheControl_;
+    std::shared_ptr<AssetCache> assets_;
+    std::shared_ptr<ProxyCache> proxy_;
 };
@@ -0,0 +1,210 @@
+#include "ProxyCache.hpp"
+
+#include "common/crypto/Md5Hash.hpp"
+#include "common/fs/FileSystem.hpp"
+#include "common/logger/Logging.hpp"
+
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace fs = boost::filesystem;
+
+const std::string BodyExtension = ".body";
+const std::string MetaExtension = ".meta";
+const uint64_t MaxEntryShare = 4;
+
+bool ProxyCache::Metadata::fresh(std::time_t now) const
+{
+    return now < expires;
+}
+
+ProxyCache::ProxyCache(const FilePath& directory, uint64_t budget) : directory_{directory}, budget_{budget}
+{
+    load();
+}
+
+boost::optional<ProxyCache::Entry> ProxyCache::find(const std::string& url)
+{
+    auto name = static_cast<std::string>(Md5Hash::fromString(url));
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    auto it = entries_.find(name);
+    if (it == entries_.end()) return {};
+
+    it->second.lastUsed = std::time(nullptr);
+    lock.unlock();
+
+    std::ifstream meta{metaPath(name).string()};
+    std::string storedUrl;
+    Entry entry{};
+    entry.body = bodyPath(name);
+    if (!std::getline(meta, storedUrl) || !std::getline(meta, entry.contentType) ||
+        !(meta >> entry.expires >> entry.staleAllowed) || storedUrl != url)
+        return {};
+
+    // entries stored without validators are simply refetched in full
+    meta.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    std::getline(meta, entry.cacheControl);
+    std::getline(meta, entry.etag);
+    std::getline(meta, entry.lastModified);
+    return entry;
+}
+
+uint64_t ProxyCache::maxEntrySize() const
+{
+    return budget_ / MaxEntryShare;
+}
+
+boost::optional<ProxyCache::Entry> ProxyCache::store(const std::string& url,
+                                                     const Metadata& metadata,
+                                                     const std::string& body)
+{
+    if (body.size() > maxEntrySize()) return {};
+
+    auto name = static_cast<std::string>(Md5Hash::fromString(url));
+    auto meta = metaContent(url, metadata);
+
+    try
+    {
+        writeFile(bodyPath(name), body);
+        writeFile(metaPath(name), meta);
+    }
+    catch (std::exception& e)
+    {
+        Log::error("[ProxyCache] Store error {}: {}", url, e.what());
+        return {};
+    }
+
+    updateUsage(name, body.size() + meta.size());
+    return Entry{metadata, bodyPath(name)};
+}
+
+// Nothing is done for an entry which has been evicted in the meantime
+boost::optional<ProxyCache::Entry> ProxyCache::refresh(const std::string& url, const Metadata& metadata)
+{
+    auto name = static_cast<std::string>(Md5Hash::fromString(url));
+    auto meta = metaContent(url, metadata);
+
+    try
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            if (entries_.count(name) == 0) return {};
+        }
+        auto bodySize = fs::file_size(bodyPath(name));
+        writeFile(metaPath(name), meta);
+        updateUsage(name, bodySize + meta.size());
+    }
+    catch (std::exception& e)
+    {
+        Log::error("[ProxyCache] Refresh error {}: {}", url, e.what());
+        return {};
+    }
+
+    return Entry{metadata, bodyPath(name)};
+}
+
+// one field per line, header values can't contain line breaks
+std::string ProxyCache::metaContent(const std::string& url, const Metadata& metadata)
+{
+    std::ostringstream meta;
+    meta << url << "\n" << metadata.contentType << "\n" << metadata.expires << " " << metadata.staleAllowed << "\n"
+         << metadata.cacheControl << "\n" << metadata.etag << "\n" << metadata.lastModified << "\n";
+    return meta.str();
+}
+
+void ProxyCache::updateUsage(const std::string& name, uint64_t size)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    if (auto it = entries_.find(name); it != entries_.end())
+    {
+        used_ -= it->second.size;
+    }
+    entries_[name] = Usage{size, std::time(nullptr)};
+    used_ += size;
+    evict();
+}
+
+void ProxyCache::load()
+{
+    try
+    {
+        fs::create_directories(directory_);
+        for (auto&& file : fs::directory_iterator{directory_})
+        {
+            auto&& path = file.path();
+            if (path.extension() != MetaExtension) continue;
+
+            auto name = path.stem().string();
+            auto body = bodyPath(name);
+            if (!FileSystem::isRegularFile(body))
+            {
+                FileSystem::remove(path);
+                continue;
+            }
+
+            auto size = fs::file_size(body) + fs::file_size(path);
+            entries_[name] = Usage{size, fs::last_write_time(path)};
+            used_ += size;
+        }
+        evict();
+        Log::debug("[ProxyCache] {} entries, {} bytes in {}", entries_.size(), used_, directory_.string());
+    }
+    catch (std::exception& e)
+    {
+        Log::error("[ProxyCache] Load error: {}", e.what());
+    }
+}
+
+FilePath ProxyCache::bodyPath(const std::string& name) const
+{
+    return directory_ / (name + BodyExtension);
+}
+
+FilePath ProxyCache::metaPath(const std::string& name) const
+{
+    return directory_ / (name + MetaExtension);
+}
+
+void ProxyCache::writeFile(const FilePath& path, const std::string& content)
+{
+    FilePath temporary{path.string() + ".tmp" + std::to_string(temporaryFiles_++)};
+    {
+        std::ofstream out{temporary.string(), std::ios::binary};
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        if (!out)
+        {
+            boost::system::error_code ignored;
+            fs::remove(temporary, ignored);
+            throw std::runtime_error{"Can't write " + temporary.string()};
+        }
+    }
+    fs::rename(temporary, path);
+}
+
+// Files which are being sent stay readable until they are closed
+void ProxyCache::remove(const std::string& name)
+{
+    boost::system::error_code ignored;
+    fs::remove(metaPath(name), ignored);
+    fs::remove(bodyPath(name), ignored);
+}
+
+void ProxyCache::evict()
+{
+    while (used_ > budget_ && !entries_.empty())
+    {
+        auto oldest = entries_.begin();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->second.lastUsed < oldest->second.lastUsed) oldest = it;
+        }
+
+        used_ -= oldest->second.size;
+        remove(oldest->first);
+        entries_.erase(oldest);
+    }
+}
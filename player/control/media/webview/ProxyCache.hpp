@@ -0,0 +1,72 @@
+#pragma once
+
+#include "common/fs/FilePath.hpp"
+
+#include <boost/optional/optional.hpp>
+
+#include <atomic>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Remote pages and their resources fetched for web views through the local proxy. They are kept on
+// disk, so they survive restarts and can be shown while the player is offline. Each entry is a body
+// file and a file with its URL, type, expiry and validators, both named by the URL's MD5. The least
+// recently used entries are removed once the budget is exceeded.
+class ProxyCache
+{
+public:
+    struct Metadata
+    {
+        std::string contentType;
+        std::time_t expires;
+        bool staleAllowed;
+        // origin's fields kept to revalidate the entry once it's stale
+        std::string cacheControl;
+        std::string etag;
+        std::string lastModified;
+
+        bool fresh(std::time_t now) const;
+    };
+
+    struct Entry : Metadata
+    {
+        FilePath body;
+    };
+
+    ProxyCache(const FilePath& directory, uint64_t budget);
+
+    boost::optional<Entry> find(const std::string& url);
+    // a quarter of the budget
+    uint64_t maxEntrySize() const;
+    // Nothing is stored for bodies larger than maxEntrySize
+    boost::optional<Entry> store(const std::string& url, const Metadata& metadata, const std::string& body);
+    // Replaces the metadata of an entry which the origin confirmed is unchanged, its body stays as it is
+    boost::optional<Entry> refresh(const std::string& url, const Metadata& metadata);
+
+private:
+    struct Usage
+    {
+        uint64_t size;
+        std::time_t lastUsed;
+    };
+
+    void load();
+    FilePath bodyPath(const std::string& name) const;
+    FilePath metaPath(const std::string& name) const;
+    static std::string metaContent(const std::string& url, const Metadata& metadata);
+    void updateUsage(const std::string& name, uint64_t size);
+    // written to a temporary file and renamed so that readers never see a partial one
+    void writeFile(const FilePath& path, const std::string& content);
+    void remove(const std::string& name);
+    void evict();
+
+private:
+    FilePath directory_;
+    uint64_t budget_;
+    std::atomic<uint64_t> temporaryFiles_ = 0;
+    std::mutex mutex_;
+    uint64_t used_ = 0;
+    std::map<std::string, Usage> entries_;
+};
@@ -0,0 +1,42 @@
+#include "ViewPortTemplate.hpp"
+
+const std::string_view ViewPortWidth = "content=\"width=";
+const std::string_view ViewPortWidthEnd = "\", ;";
+
+ViewPortTemplate ViewPortTemplate::compile(std::string_view html)
+{
+    ViewPortTemplate result;
+    for (auto start = html.find(ViewPortWidth); start != std::string_view::npos;
+         start = html.find(ViewPortWidth, start))
+    {
+        start += ViewPortWidth.size();
+        auto end = html.find_first_of(ViewPortWidthEnd, start);
+        if (end == std::string_view::npos) break;
+
+        result.placeholders_.push_back(Placeholder{start, end - start});
+        start = end;
+    }
+    return result;
+}
+
+bool ViewPortTemplate::empty() const
+{
+    return placeholders_.empty();
+}
+
+std::string ViewPortTemplate::render(std::string_view html, int width) const
+{
+    auto value = std::to_string(width);
+
+    std::string result;
+    result.reserve(html.size() + placeholders_.size() * value.size());
+
+    size_t copied = 0;
+    for (auto&& placeholder : placeholders_)
+    {
+        result.append(html, copied, placeholder.offset - copied).append(value);
+        copied = placeholder.offset + placeholder.length;
+    }
+    result.append(html, copied, std::string_view::npos);
+    return result;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Positions of the viewport width in a widget HTML file, found once so that rendering it for the
+// size of a region is a splice instead of a pass over the whole file
+class ViewPortTemplate
+{
+public:
+    static ViewPortTemplate compile(std::string_view html);
+
+    bool empty() const;
+    std::string render(std::string_view html, int width) const;
+
+private:
+    struct Placeholder
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    std::vector<Placeholder> placeholders_;
+};
@@ -0,0 +1,70 @@
+#include "WebKitContextGtk.hpp"
+
+#include "common/logger/Logging.hpp"
+
+#include <webkit2/webkit2.h>
+
+#include <algorithm>
+#include <map>
+
+const std::string DefaultCacheModel = "document-browser";
+const std::map<std::string, WebKitCacheModel> CacheModels{{"document-viewer", WEBKIT_CACHE_MODEL_DOCUMENT_VIEWER},
+                                                          {"document-browser", WEBKIT_CACHE_MODEL_DOCUMENT_BROWSER},
+                                                          {"web-browser", WEBKIT_CACHE_MODEL_WEB_BROWSER}};
+const char* const PrewarmUri = "about:blank";
+// widgets of the embedded web server are requested directly
+const char* const LocalHosts[] = {"localhost", "127.0.0.1", nullptr};
+
+WebKitContextGtk& WebKitContextGtk::instance()
+{
+    static WebKitContextGtk context;
+    return context;
+}
+
+void WebKitContextGtk::configure(const FilePath& cacheDirectory,
+                                 const std::string& cacheModel,
+                                 int processesCount,
+                                 const boost::optional<Uri>& proxy)
+{
+    if (context_) return;
+
+    auto model = CacheModels.find(cacheModel);
+    if (model == CacheModels.end())
+    {
+        Log::error("[WebKitContext] Unknown cache model {}, {} is used", cacheModel, DefaultCacheModel);
+        model = CacheModels.find(DefaultCacheModel);
+    }
+
+    auto dataManager = webkit_website_data_manager_new("base-cache-directory", cacheDirectory.c_str(), nullptr);
+    if (proxy)
+    {
+        auto proxySettings = webkit_network_proxy_settings_new(nullptr, LocalHosts);
+        webkit_network_proxy_settings_add_proxy_for_scheme(proxySettings, "http", proxy->string().c_str());
+        webkit_website_data_manager_set_network_proxy_settings(
+            dataManager, WEBKIT_NETWORK_PROXY_MODE_CUSTOM, proxySettings);
+        webkit_network_proxy_settings_free(proxySettings);
+        Log::debug("[WebKitContext] Remote http pages go through {}", proxy->string());
+    }
+    context_ = webkit_web_context_new_with_website_data_manager(dataManager);
+    g_object_unref(dataManager);
+    webkit_web_context_set_cache_model(context_, model->second);
+
+    // the views are never shown and only keep their web processes running for the widgets
+    for (int i = 0; i < std::max(processesCount, 1); ++i)
+    {
+        auto view = WEBKIT_WEB_VIEW(webkit_web_view_new_with_context(context_));
+        g_object_ref_sink(view);
+        webkit_web_view_load_uri(view, PrewarmUri);
+        processViews_.push_back(view);
+    }
+
+    Log::debug("[WebKitContext] {} web processes started, cache in {}", processViews_.size(), cacheDirectory.string());
+}
+
+WebKitWebView* WebKitContextGtk::createView()
+{
+    if (processViews_.empty()) return WEBKIT_WEB_VIEW(webkit_web_view_new());
+
+    auto relatedView = processViews_[nextProcess_++ % processViews_.size()];
+    return WEBKIT_WEB_VIEW(webkit_web_view_new_with_related_view(relatedView));
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "common/fs/FilePath.hpp"
+#include "common/types/Uri.hpp"
+
+#include <boost/optional/optional.hpp>
+
+#include <string>
+#include <vector>
+
+struct _WebKitWebContext;
+using WebKitWebContext = _WebKitWebContext;
+struct _WebKitWebView;
+using WebKitWebView = _WebKitWebView;
+
+// Context shared by all web views. Each view is related to one of a few hidden views, so it runs
+// in that view's web process instead of a new one. These processes are started when the player
+// starts, so the first widget of a layout doesn't wait for one and RSS doesn't grow with every
+// HTML region. Views fall back to the default context until configure() is called.
+class WebKitContextGtk
+{
+public:
+    static WebKitContextGtk& instance();
+
+    // cacheModel is one of document-viewer, document-browser or web-browser. Remote http:// pages go
+    // through the proxy when there is one, https:// ones can't be cached by it and are loaded directly.
+    void configure(const FilePath& cacheDirectory,
+                   const std::string& cacheModel,
+                   int processesCount,
+                   const boost::optional<Uri>& proxy);
+
+    WebKitWebView* createView();
+
+private:
+    WebKitContextGtk() = default;
+
+private:
+    WebKitWebContext* context_ = nullptr;
+    std::vector<WebKitWebView*> processViews_;
+    size_t nextProcess_ = 0;
+};
@@ -17,6 +17,8 @@ namespace Xibo
 
         virtual void reload() = 0;
         virtual void load(const Uri& uri) = 0;
+        // replaces the page with a blank one so that nothing keeps running in it
+        virtual void unload() = 0;
         virtual void enableTransparency() = 0;
     };
 }
@@ -1,28 +1,22 @@
 #include "WebViewFactory.hpp"
 
+#include "XiboApp.hpp"
 #include "control/media/webview/WebView.hpp"
+#include "control/media/webview/WebViewMedia.hpp"
 #include "control/media/webview/WebViewWidgetFactory.hpp"
 
-#include "control/media/MediaImpl.hpp"
 #include "control/media/MediaResources.hpp"
 
-#include "common/fs/FileSystem.hpp"
-#include "common/fs/Resource.hpp"
-
-#include <regex>
-
-const std::regex ViewPortWidth{"(content=\"width=)(.*)(\".*)"};
-
 std::unique_ptr<Xibo::Media> WebViewFactory::create(const MediaOptions& options,
                                                     int width,
                                                     int height,
-                                                    bool transparency)
+                                                    bool transparency,
+                                                    HiddenWebViews hiddenWebViews)
 {
-    updateViewPortWidth(options.uri, width);
+    auto uri = viewPortUri(options.uri, width);
+    auto view = createView(uri, width, height, static_cast<Xibo::WebView::Transparency>(transparency));
 
-    auto media = std::make_unique<MediaImpl>(options);
-    media->setWidget(createView(options.uri, width, height, static_cast<Xibo::WebView::Transparency>(transparency)));
-    return media;
+    return std::make_unique<WebViewMedia>(options, uri, view, hiddenWebViews);
 }
 
 std::shared_ptr<Xibo::WebView> WebViewFactory::createView(const Uri& uri,
@@ -41,13 +35,11 @@ std::shared_ptr<Xibo::WebView> WebViewFactory::createView(const Uri& uri,
     return webview;
 }
 
-void WebViewFactory::updateViewPortWidth(const Uri& uri, int width)
+// Widget HTML is served by LocalWebServer with the viewport set to the width of the region, the
+// file itself is left as downloaded
+Uri WebViewFactory::viewPortUri(const Uri& uri, int width)
 {
-    auto filename = uri.path().substr(1);
-    Resource path{filename};
-
-    auto originalContent = FileSystem::readFromFile(path);
-    auto updatedContent = std::regex_replace(originalContent, ViewPortWidth, "$1 " + std::to_string(width) + "$3");
+    if (uri.string().rfind(XiboApp::localAddress().string(), 0) != 0) return uri;
 
-    FileSystem::writeToFile(path, updatedContent);
+    return Uri::fromString(uri.string() + "?viewPortWidth=" + std::to_string(width));
 }
@@ -2,6 +2,7 @@
 
 #include "control/media/Media.hpp"
 #include "control/media/MediaOptions.hpp"
+#include "control/media/webview/HiddenWebViews.hpp"
 #include "control/media/webview/WebView.hpp"
 
 #include <memory>
@@ -9,12 +10,13 @@
 class WebViewFactory
 {
 public:
-    std::unique_ptr<Xibo::Media> create(const MediaOptions& baseOptions, int width, int height, bool transparency);
+    std::unique_ptr<Xibo::Media> create(
+        const MediaOptions& baseOptions, int width, int height, bool transparency, HiddenWebViews hiddenWebViews);
 
 private:
     std::shared_ptr<Xibo::WebView> createView(const Uri& uri,
                                               int width,
                                               int height,
                                               Xibo::WebView::Transparency transparency);
-    void updateViewPortWidth(const Uri& uri, int width);
+    Uri viewPortUri(const Uri& uri, int width);
 };
@@ -1,16 +1,20 @@
 #include "WebViewGtk.hpp"
 
+#include "control/media/webview/WebKitContextGtk.hpp"
+
 #include "common/types/Uri.hpp"
 
 #include <webkit2/webkit2.h>
 
 namespace ph = std::placeholders;
 
+const char* const BlankUri = "about:blank";
+
 WebViewGtk::WebViewGtk(int width, int height) : WidgetGtk{handler_}
 {
     WidgetGtk::setSize(width, height);
 
-    webView_ = reinterpret_cast<WebKitWebView*>(webkit_web_view_new());
+    webView_ = WebKitContextGtk::instance().createView();
     auto widget = Gtk::manage(Glib::wrap(reinterpret_cast<GtkWidget*>(webView_)));
     handler_.add(*widget);
 
@@ -45,6 +49,11 @@ void WebViewGtk::load(const Uri& uri)
     webkit_web_view_load_uri(webView_, uri.string().c_str());
 }
 
+void WebViewGtk::unload()
+{
+    webkit_web_view_load_uri(webView_, BlankUri);
+}
+
 void WebViewGtk::enableTransparency()
 {
     handler_.signal_screen_changed().connect(std::bind(&WebViewGtk::screenChanged, this, ph::_1));
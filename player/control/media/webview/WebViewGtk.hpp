@@ -20,6 +20,7 @@ public:
 
     void reload() override;
     void load(const Uri& uri) override;
+    void unload() override;
     void enableTransparency() override;
 
     Gtk::ScrolledWindow& handler() override;
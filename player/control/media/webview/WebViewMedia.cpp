@@ -0,0 +1,43 @@
+#include "WebViewMedia.hpp"
+
+WebViewMedia::WebViewMedia(const MediaOptions& options,
+                           const Uri& uri,
+                           const std::shared_ptr<Xibo::WebView>& webView,
+                           HiddenWebViews hiddenWebViews) :
+    MediaImpl(options),
+    uri_(uri),
+    webView_(webView),
+    hiddenWebViews_(hiddenWebViews),
+    unloadTimer_(std::make_unique<Timer>())
+{
+    assert(webView_);
+
+    MediaImpl::setWidget(webView_);
+}
+
+void WebViewMedia::onStarted()
+{
+    unloadTimer_->stop();
+    if (unloaded_)
+    {
+        webView_->load(uri_);
+        unloaded_ = false;
+    }
+
+    MediaImpl::onStarted();
+}
+
+void WebViewMedia::onStopped()
+{
+    MediaImpl::onStopped();
+
+    // A region with a single looping media stops and starts it again right away, so the page is unloaded
+    // only if the media is still stopped once the main loop gets back to it
+    if (hiddenWebViews_ == HiddenWebViews::Unload)
+    {
+        unloadTimer_->startOnce(std::chrono::milliseconds{0}, [this]() {
+            webView_->unload();
+            unloaded_ = true;
+        });
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "control/media/MediaImpl.hpp"
+#include "control/media/webview/HiddenWebViews.hpp"
+#include "control/media/webview/WebView.hpp"
+
+#include "common/dt/Timer.hpp"
+
+// Web view media whose page is unloaded while it's hidden, if the layout asks for it, and loaded
+// again before it's shown
+class WebViewMedia : public MediaImpl
+{
+public:
+    WebViewMedia(const MediaOptions& options,
+                 const Uri& uri,
+                 const std::shared_ptr<Xibo::WebView>& webView,
+                 HiddenWebViews hiddenWebViews);
+
+protected:
+    void onStarted() override;
+    void onStopped() override;
+
+private:
+    Uri uri_;
+    std::shared_ptr<Xibo::WebView> webView_;
+    HiddenWebViews hiddenWebViews_;
+    std::unique_ptr<Timer> unloadTimer_;
+    bool unloaded_ = false;
+};
@@ -17,7 +17,6 @@ const int DefaultWebviewMode = 0;
 const int NativeModeid = 1;
 
 const std::regex DurationRegex("DURATION=([0-9]+)");
-const std::regex ViewPortWidth{"(content=\"width=)(.*)(\".*)"};
 const std::string DefaultWebviewExtension = ".html";
 
 int WebViewParser::durationFrom(const XmlNode& node)
@@ -87,5 +86,5 @@ std::unique_ptr<Xibo::Media> WebViewParser::createMedia(const MediaOptions& opti
     auto transparency = node.get<bool>(XlfResources::WebView::Transparency, DefaultTransparency);
 
     WebViewFactory factory;
-    return factory.create(options, width, height, transparency);
+    return factory.create(options, width, height, transparency, hiddenWebViews());
 }
@@ -1,12 +1,29 @@
 #pragma once
 
 #ifdef USE_GTK
+#include "control/media/webview/WebKitContextGtk.hpp"
 #include "control/media/webview/WebViewGtk.hpp"
 #endif
 #include "control/media/webview/WebView.hpp"
 
+#include "common/fs/FilePath.hpp"
+#include "common/types/Uri.hpp"
+
+#include <boost/optional/optional.hpp>
+
 namespace WebViewWidgetFactory
 {
+    // shared browser engine state, expected to be set up once before the first view is created
+    inline void configure(const FilePath& cacheDirectory,
+                          const std::string& cacheModel,
+                          int processesCount,
+                          const boost::optional<Uri>& proxy)
+    {
+#ifdef USE_GTK
+        WebKitContextGtk::instance().configure(cacheDirectory, cacheModel, processesCount, proxy);
+#endif
+    }
+
     inline std::unique_ptr<Xibo::WebView> create(int width, int height)
     {
 #ifdef USE_GTK
@@ -10,7 +10,11 @@ const bool DefaultRegionLoop = false;
 
 using namespace std::string_literals;
 
-RegionParser::RegionParser(bool globalStatEnabled) : globalStatEnabled_{globalStatEnabled} {}
+RegionParser::RegionParser(bool globalStatEnabled, HiddenWebViews hiddenWebViews) :
+    globalStatEnabled_{globalStatEnabled},
+    hiddenWebViews_{hiddenWebViews}
+{
+}
 
 std::unique_ptr<Xibo::Region> RegionParser::regionFrom(const XmlNode& node)
 {
@@ -72,7 +76,7 @@ void RegionParser::addMedia(Xibo::Region& region, const XmlNode& regionNode)
             int width = region.view()->width();
             int height = region.view()->height();
 
-            region.addMedia(parser->mediaFrom(node, width, height, globalStatEnabled_));
+            region.addMedia(parser->mediaFrom(node, width, height, globalStatEnabled_, hiddenWebViews_));
         }
     }
 }
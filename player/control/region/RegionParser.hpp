@@ -3,6 +3,7 @@
 #include "common/parsing/Parsing.hpp"
 #include "common/PlayerRuntimeError.hpp"
 #include "control/media/MediaOptions.hpp"
+#include "control/media/webview/HiddenWebViews.hpp"
 #include "control/region/Region.hpp"
 #include "control/region/RegionOptions.hpp"
 
@@ -21,7 +22,7 @@ public:
         using PlayerRuntimeError::PlayerRuntimeError;
     };
 
-    RegionParser(bool globalStatEnabled);
+    RegionParser(bool globalStatEnabled, HiddenWebViews hiddenWebViews);
 
     std::unique_ptr<Xibo::Region> regionFrom(const XmlNode& node);
     RegionPosition positionFrom(const XmlNode& node);
@@ -33,4 +34,5 @@ private:
 
 private:
     bool globalStatEnabled_;
+    HiddenWebViews hiddenWebViews_;
 };
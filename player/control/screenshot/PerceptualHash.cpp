@@ -0,0 +1,72 @@
+#include "PerceptualHash.hpp"
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+const int HashColumns = 9;
+const int HashRows = 8;
+const int RgbChannels = 3;
+
+// Source pixels [bounds[i], bounds[i + 1]) fall into cell i
+template <int Cells>
+static std::array<int, Cells + 1> cellBounds(int size)
+{
+    std::array<int, Cells + 1> bounds;
+    for (int i = 0; i <= Cells; ++i)
+    {
+        bounds[i] = i * size / Cells;
+    }
+    return bounds;
+}
+
+// Rows are converted to luminance in one pass and then summed per cell, both plain loops over
+// contiguous memory which the compiler vectorizes
+uint64_t differenceHash(const RgbImage& image)
+{
+    // too small to have a pixel in every cell
+    if (image.width < HashColumns || image.height < HashRows) return 0;
+
+    auto columns = cellBounds<HashColumns>(image.width);
+    auto rows = cellBounds<HashRows>(image.height);
+    std::array<uint64_t, HashColumns * HashRows> sums{};
+    std::vector<uint32_t> luma(static_cast<size_t>(image.width));
+
+    for (int cellY = 0; cellY < HashRows; ++cellY)
+    {
+        for (int y = rows[cellY]; y < rows[cellY + 1]; ++y)
+        {
+            auto pixel = image.pixels.data() + static_cast<size_t>(y) * image.width * RgbChannels;
+            for (size_t x = 0; x < luma.size(); ++x, pixel += RgbChannels)
+            {
+                luma[x] = (77u * pixel[0] + 150u * pixel[1] + 29u * pixel[2]) >> 8;
+            }
+
+            auto cellSums = sums.data() + cellY * HashColumns;
+            for (int cellX = 0; cellX < HashColumns; ++cellX)
+            {
+                cellSums[cellX] += std::accumulate(
+                    luma.begin() + columns[cellX], luma.begin() + columns[cellX + 1], uint64_t{0});
+            }
+        }
+    }
+
+    // cells of a row have the same height, so their averages compare like sums over their widths
+    uint64_t hash = 0;
+    for (int cellY = 0; cellY < HashRows; ++cellY)
+    {
+        for (int cellX = 0; cellX + 1 < HashColumns; ++cellX)
+        {
+            auto left = cellY * HashColumns + cellX;
+            auto leftWidth = static_cast<uint64_t>(columns[cellX + 1] - columns[cellX]);
+            auto rightWidth = static_cast<uint64_t>(columns[cellX + 2] - columns[cellX + 1]);
+            hash = (hash << 1) | (sums[left] * rightWidth > sums[left + 1] * leftWidth ? 1 : 0);
+        }
+    }
+    return hash;
+}
+
+int hashDistance(uint64_t first, uint64_t second)
+{
+    return __builtin_popcountll(first ^ second);
+}
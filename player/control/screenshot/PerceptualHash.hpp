@@ -0,0 +1,11 @@
+#pragma once
+
+#include "control/screenshot/ScreenShotImage.hpp"
+
+#include <cstdint>
+
+// Difference hash of the luminance: the image is reduced to 9x8 cells and every bit tells whether a
+// cell is brighter than its right neighbour. Captures which look the same differ in a few bits at
+// most whatever their size, while a new layout or media item changes a large part of them.
+uint64_t differenceHash(const RgbImage& image);
+int hashDistance(uint64_t first, uint64_t second);
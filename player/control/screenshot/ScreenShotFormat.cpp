@@ -0,0 +1,20 @@
+#include "ScreenShotFormat.hpp"
+
+#include <string>
+
+std::istream& operator>>(std::istream& in, ScreenShotFormat& format)
+{
+    std::string temp;
+    in >> temp;
+
+    if (temp == "png")
+        format = ScreenShotFormat::Png;
+    else if (temp == "jpeg")
+        format = ScreenShotFormat::Jpeg;
+    else if (temp == "webp")
+        format = ScreenShotFormat::Webp;
+    else
+        in.setstate(std::ios_base::failbit);
+
+    return in;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <istream>
+
+// Encoding of screenshots sent to the CMS. JPEG and WebP are a fraction of the size of PNG for the
+// photos and video frames which are usually on screen.
+enum class ScreenShotFormat
+{
+    Png,
+    Jpeg,
+    Webp
+};
+
+// "png", "jpeg" or "webp"
+std::istream& operator>>(std::istream& in, ScreenShotFormat& format);
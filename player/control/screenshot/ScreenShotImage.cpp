@@ -0,0 +1,65 @@
+#include "ScreenShotImage.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+const int RgbChannels = 3;
+const int CapturedPixelSize = 4;
+
+// Source pixels [bounds[i], bounds[i + 1]) fall into destination pixel i
+static std::vector<int> boundsOf(int sourceSize, int size)
+{
+    std::vector<int> bounds(static_cast<size_t>(size) + 1);
+    for (int i = 0; i <= size; ++i)
+    {
+        bounds[i] = static_cast<int>(static_cast<int64_t>(i) * sourceSize / size);
+    }
+    return bounds;
+}
+
+RgbImage downscale(const CapturedPixels& captured, int maxSize)
+{
+    auto longerSide = std::max(captured.width, captured.height);
+    auto scale = maxSize > 0 && longerSide > maxSize ? static_cast<double>(maxSize) / longerSide : 1.0;
+    auto width = std::max(1, static_cast<int>(std::lround(captured.width * scale)));
+    auto height = std::max(1, static_cast<int>(std::lround(captured.height * scale)));
+
+    RgbImage image{width, height, std::vector<unsigned char>(static_cast<size_t>(width) * height * RgbChannels)};
+    auto columns = boundsOf(captured.width, width);
+    auto rows = boundsOf(captured.height, height);
+    std::vector<uint32_t> sums(static_cast<size_t>(width) * RgbChannels);
+
+    auto out = image.pixels.data();
+    for (int y = 0; y < height; ++y)
+    {
+        std::fill(sums.begin(), sums.end(), 0);
+        for (int sourceY = rows[y]; sourceY < rows[y + 1]; ++sourceY)
+        {
+            auto row = captured.data.get() + static_cast<size_t>(sourceY) * captured.stride;
+            auto sum = sums.data();
+            for (int x = 0; x < width; ++x, sum += RgbChannels)
+            {
+                for (int sourceX = columns[x]; sourceX < columns[x + 1]; ++sourceX)
+                {
+                    auto pixel = row + static_cast<size_t>(sourceX) * CapturedPixelSize;
+                    sum[0] += pixel[2];
+                    sum[1] += pixel[1];
+                    sum[2] += pixel[0];
+                }
+            }
+        }
+
+        auto rowsCount = static_cast<uint32_t>(rows[y + 1] - rows[y]);
+        auto sum = sums.data();
+        for (int x = 0; x < width; ++x, sum += RgbChannels)
+        {
+            auto count = rowsCount * static_cast<uint32_t>(columns[x + 1] - columns[x]);
+            for (int channel = 0; channel < RgbChannels; ++channel)
+            {
+                *out++ = static_cast<unsigned char>((sum[channel] + count / 2) / count);
+            }
+        }
+    }
+    return image;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// Window pixels as they were copied from the display, 32 bits per pixel with blue in the lowest
+// byte. The data is owned by whatever it was copied into.
+struct CapturedPixels
+{
+    int width;
+    int height;
+    int stride;
+    std::shared_ptr<const unsigned char> data;
+    std::chrono::milliseconds copyTime{0};  // spent on the UI thread
+};
+
+// Packed 8-bit RGB rows
+struct RgbImage
+{
+    int width;
+    int height;
+    std::vector<unsigned char> pixels;
+};
+
+// Converts to RGB with the longer side scaled down to maxSize, 0 keeps the size. Every pixel is the
+// average of the pixels it covers so that text stays readable.
+RgbImage downscale(const CapturedPixels& captured, int maxSize);
@@ -2,14 +2,19 @@
 
 #include "cms/xmds/XmdsRequestSender.hpp"
 #include "common/logger/Logging.hpp"
+#include "control/screenshot/PerceptualHash.hpp"
 #include "control/screenshot/ScreeShoterFactory.hpp"
 
 const int DefaultInterval = 0;
+const std::chrono::minutes DefaultMaxAge{60};
+// small changes like a clock or a ticker only flip a few bits
+const int UnchangedHashDistance = 4;
 
 ScreenShotInterval::ScreenShotInterval(XmdsRequestSender& sender, Xibo::Window& window) :
     sender_(sender),
     screenShoter_(ScreenShoterFactory::create(window)),
-    interval_(DefaultInterval)
+    interval_(DefaultInterval),
+    maxAge_(DefaultMaxAge)
 {
 }
 
@@ -23,13 +28,24 @@ void ScreenShotInterval::updateInterval(int interval)
     }
 }
 
+void ScreenShotInterval::setEncoding(ScreenShotFormat format, int quality, int maxSize)
+{
+    screenShoter_->setEncoding(format, quality, maxSize);
+}
+
+void ScreenShotInterval::setMaxAge(std::chrono::minutes maxAge)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    maxAge_ = maxAge;
+}
+
 void ScreenShotInterval::restartTimer()
 {
     timer_.stop();
     if (interval_ != DefaultInterval)
     {
         timer_.start(std::chrono::minutes(interval_), [this]() {
-            takeScreenShot();
+            takeScreenShot(true);
             return true;
         });
     }
@@ -37,17 +53,50 @@ void ScreenShotInterval::restartTimer()
 
 void ScreenShotInterval::takeScreenShot()
 {
-    screenShoter_->takeBase64([this](const std::string& screenShot) {
-        if (!screenShot.empty())
-        {
-            submitScreenShot(screenShot);
-        }
-    });
+    takeScreenShot(false);
+}
+
+ScreenShotStatus ScreenShotInterval::status()
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    return status_;
+}
+
+void ScreenShotInterval::takeScreenShot(bool changedOnly)
+{
+    auto wanted = [this, changedOnly](uint64_t hash) { return !changedOnly || changedSinceSubmitted(hash); };
+    screenShoter_->takeBase64(wanted, [this](const ScreenShot& screenShot) { onScreenShotTaken(screenShot); });
+}
+
+bool ScreenShotInterval::changedSinceSubmitted(uint64_t hash)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    if (!submittedHash_ || maxAge_.count() == 0 || Clock::now() - submitted_ >= maxAge_) return true;
+
+    return hashDistance(hash, *submittedHash_) > UnchangedHashDistance;
+}
+
+void ScreenShotInterval::onScreenShotTaken(const ScreenShot& screenShot)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    status_.lastCaptured = DateTime::now();
+    status_.lastHash = fmt::format("{:016x}", screenShot.hash);
+    status_.copyTime = screenShot.copyTime;
+    status_.encodeTime = screenShot.encodeTime;
+    if (screenShot.base64.empty())
+    {
+        ++status_.unchangedSkipped;
+        Log::debug("[ScreenShotInterval] Display unchanged, screenshot not submitted");
+        return;
+    }
+    lock.unlock();
+
+    submitScreenShot(screenShot);
 }
 
-void ScreenShotInterval::submitScreenShot(const std::string& screenShot)
+void ScreenShotInterval::submitScreenShot(const ScreenShot& screenShot)
 {
-    sender_.submitScreenShot(screenShot).then([](auto future) {
+    sender_.submitScreenShot(screenShot.base64).then([this, hash = screenShot.hash](auto future) {
         auto [error, result] = future.get();
         if (error)
         {
@@ -58,5 +107,13 @@ void ScreenShotInterval::submitScreenShot(const std::string& screenShot)
             std::string message = result.success ? "Submitted" : "Not submitted";
             Log::debug("[XMDS::SubmitScreenShot] {}", message);
         }
+
+        if (!error && result.success)
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            submittedHash_ = hash;
+            submitted_ = Clock::now();
+            status_.lastSubmitted = DateTime::now();
+        }
     });
 }
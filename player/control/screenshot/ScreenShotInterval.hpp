@@ -1,28 +1,52 @@
 #pragma once
 
 #include "common/dt/Timer.hpp"
+#include "control/screenshot/ScreenShotFormat.hpp"
+#include "control/screenshot/ScreenShotStatus.hpp"
 #include "control/widgets/Window.hpp"
 
+#include <boost/optional/optional.hpp>
+
+#include <chrono>
 #include <memory>
+#include <mutex>
 
 class ScreenShoter;
+struct ScreenShot;
 class XmdsRequestSender;
 
+// Scheduled screenshots are only submitted when the display looks different from the last submitted
+// one or that one is older than the max age. Screenshots requested through XMR are always submitted.
 class ScreenShotInterval
 {
+    using Clock = std::chrono::steady_clock;
+
 public:
     ScreenShotInterval(XmdsRequestSender& sender, Xibo::Window& window);
 
     void updateInterval(int interval);
+    void setEncoding(ScreenShotFormat format, int quality, int maxSize);
+    // 0 submits every scheduled screenshot
+    void setMaxAge(std::chrono::minutes maxAge);
     void takeScreenShot();
+    ScreenShotStatus status();
 
 private:
     void restartTimer();
-    void submitScreenShot(const std::string& screenShot);
+    void takeScreenShot(bool changedOnly);
+    bool changedSinceSubmitted(uint64_t hash);
+    void onScreenShotTaken(const ScreenShot& screenShot);
+    void submitScreenShot(const ScreenShot& screenShot);
 
 private:
     XmdsRequestSender& sender_;
     std::unique_ptr<ScreenShoter> screenShoter_;
     int interval_;
+    std::chrono::minutes maxAge_;
     Timer timer_;
+
+    std::mutex mutex_;
+    boost::optional<uint64_t> submittedHash_;
+    Clock::time_point submitted_;
+    ScreenShotStatus status_;
 };
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "common/dt/DateTime.hpp"
+
+#include <chrono>
+#include <string>
+
+struct ScreenShotStatus
+{
+    DateTime lastCaptured;
+    DateTime lastSubmitted;
+    std::string lastHash;
+    std::chrono::milliseconds copyTime{0};
+    std::chrono::milliseconds encodeTime{0};
+    size_t unchangedSkipped = 0;
+};
@@ -1,20 +1,75 @@
 #include "ScreenShoter.hpp"
 
+#include "common/logger/Logging.hpp"
+#include "control/screenshot/PerceptualHash.hpp"
+
+#include <boost/asio/post.hpp>
 #include <boost/beast/core/detail/base64.hpp>
 
-ScreenShoter::ScreenShoter(Xibo::Window& window) : window_(window) {}
+#include <algorithm>
+#include <chrono>
+
+ScreenShoter::ScreenShoter(Xibo::Window& window) : window_(window), work_(ioc_)
+{
+    encodingThread_ = std::make_unique<JoinableThread>([this]() { ioc_.run(); });
+}
+
+ScreenShoter::~ScreenShoter()
+{
+    stopEncoding();
+}
+
+void ScreenShoter::setEncoding(ScreenShotFormat format, int quality, int maxSize)
+{
+    format_ = format;
+    quality_ = std::clamp(quality, 1, 100);
+    maxSize_ = std::max(maxSize, 0);
+}
 
-void ScreenShoter::takeBase64(const ScreenShotTaken& callback)
+// Encoding settings are taken when the screenshot is requested so the encoding thread has its own copy
+void ScreenShoter::takeBase64(const ScreenShotWanted& wanted, const ScreenShotTaken& callback)
 {
-    takeScreenshotNative(nativeWindow(), [callback = std::move(callback)](const ImageBuffer& buffer) {
-        std::string base64;
-        base64.resize(boost::beast::detail::base64::encoded_size(buffer.size()));
-        boost::beast::detail::base64::encode(&base64[0], buffer.data(), buffer.size());
-        callback(base64);
-    });
+    auto onCaptured = [this, wanted, callback, format = format_, quality = quality_, maxSize = maxSize_](
+                          CapturedPixels pixels) {
+        boost::asio::post(ioc_, [=, pixels = std::move(pixels)]() {
+            try
+            {
+                auto started = std::chrono::steady_clock::now();
+                auto image = downscale(pixels, maxSize);
+                ScreenShot screenShot{{}, differenceHash(image), pixels.copyTime, {}};
+                if (wanted(screenShot.hash))
+                {
+                    auto encoded = encode(image, format, quality);
+                    screenShot.base64.resize(boost::beast::detail::base64::encoded_size(encoded.size()));
+                    boost::beast::detail::base64::encode(&screenShot.base64[0], encoded.data(), encoded.size());
+                }
+                auto elapsed = std::chrono::steady_clock::now() - started;
+                screenShot.encodeTime = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+
+                Log::debug("[ScreenShoter] {}x{} captured in {} ms, hash {:016x}, encoded in {} ms",
+                           pixels.width,
+                           pixels.height,
+                           screenShot.copyTime.count(),
+                           screenShot.hash,
+                           screenShot.encodeTime.count());
+                callback(screenShot);
+            }
+            catch (std::exception& e)
+            {
+                Log::error("[ScreenShoter] Encoding error: {}", e.what());
+            }
+        });
+    };
+    takeScreenshotNative(nativeWindow(), onCaptured);
 }
 
 NativeWindow ScreenShoter::nativeWindow() const
 {
     return window_.nativeWindow();
 }
+
+void ScreenShoter::stopEncoding()
+{
+    ioc_.stop();
+    encodingThread_.reset();
+}
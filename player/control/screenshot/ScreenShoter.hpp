@@ -1,26 +1,55 @@
 #pragma once
 
+#include "common/JoinableThread.hpp"
+#include "control/screenshot/ScreenShotFormat.hpp"
+#include "control/screenshot/ScreenShotImage.hpp"
 #include "control/widgets/Window.hpp"
 
+#include <boost/asio/io_context.hpp>
 #include <boost/signals2/signal.hpp>
 #include <vector>
 
-using ScreenShotTaken = std::function<void(const std::string&)>;
+struct ScreenShot
+{
+    std::string base64;  // empty when it wasn't wanted
+    uint64_t hash;       // see differenceHash()
+    std::chrono::milliseconds copyTime;
+    std::chrono::milliseconds encodeTime;
+};
+
+// Tells from the hash of a capture whether it's worth encoding
+using ScreenShotWanted = std::function<bool(uint64_t hash)>;
+using ScreenShotTaken = std::function<void(const ScreenShot&)>;
 using ImageBuffer = std::vector<unsigned char>;
-using ImageBufferCreated = std::function<void(const ImageBuffer&)>;
+using PixelsCaptured = std::function<void(CapturedPixels)>;
 
+// Only copying the pixels of the window happens on the UI thread. Scaling and encoding run on a thread
+// of the shoter so that playback doesn't stall while a large display is captured.
 class ScreenShoter
 {
 public:
     ScreenShoter(Xibo::Window& window);
-    virtual ~ScreenShoter() = default;
+    virtual ~ScreenShoter();
 
-    void takeBase64(const ScreenShotTaken& callback);
+    // The longer side is scaled down to maxSize, 0 keeps the window size. Quality from 1 to 100 is
+    // used by JPEG and WebP.
+    void setEncoding(ScreenShotFormat format, int quality, int maxSize);
+    // both callbacks are called on the encoding thread
+    void takeBase64(const ScreenShotWanted& wanted, const ScreenShotTaken& callback);
     NativeWindow nativeWindow() const;
 
 protected:
-    virtual void takeScreenshotNative(NativeWindow window, const ImageBufferCreated& callback) = 0;
+    virtual void takeScreenshotNative(NativeWindow window, const PixelsCaptured& callback) = 0;
+    virtual ImageBuffer encode(const RgbImage& image, ScreenShotFormat format, int quality) = 0;
+    // called by subclasses before they are destroyed as encode() may be running
+    void stopEncoding();
 
 private:
     Xibo::Window& window_;
+    ScreenShotFormat format_ = ScreenShotFormat::Png;
+    int quality_ = 100;
+    int maxSize_ = 0;
+    boost::asio::io_context ioc_;
+    boost::asio::io_context::work work_;
+    std::unique_ptr<JoinableThread> encodingThread_;
 };
@@ -3,25 +3,25 @@
 #include "MainLoop.hpp"
 #include "common/logger/Logging.hpp"
 
-#include <cairomm/xlib_surface.h>
+#include <gdk/gdkx.h>
+#include <gdkmm/pixbuf.h>
+
+const int CapturedBitsPerPixel = 32;
+const unsigned long CapturedRedMask = 0xff0000;
 
 X11ScreenShoter::X11ScreenShoter(Xibo::Window& window) : ScreenShoter(window) {}
 
-void X11ScreenShoter::takeScreenshotNative(NativeWindow window, const ImageBufferCreated& callback)
+X11ScreenShoter::~X11ScreenShoter()
+{
+    stopEncoding();
+}
+
+void X11ScreenShoter::takeScreenshotNative(NativeWindow window, const PixelsCaptured& callback)
 {
     MainLoop::pushToUiThread([=]() {
         try
         {
-            Display* display = XOpenDisplay(nullptr);
-            XWindowAttributes gwa;
-            XGetWindowAttributes(display, window, &gwa);
-
-            auto surface = Cairo::XlibSurface::create(display, window, gwa.visual, gwa.width, gwa.height);
-
-            auto buffer = copySurfaceToBuffer(surface);
-            callback(buffer);
-
-            XCloseDisplay(display);
+            callback(capture(window));
         }
         catch (std::exception& e)
         {
@@ -30,14 +30,65 @@ void X11ScreenShoter::takeScreenshotNative(NativeWindow window, const ImageBuffe
     });
 }
 
-std::vector<unsigned char> X11ScreenShoter::copySurfaceToBuffer(const Cairo::RefPtr<Cairo::Surface>& surface)
+// The image is taken over the display connection of GDK, its X errors are trapped so that a window
+// which can't be captured doesn't end the player. The pixels stay in the XImage until they're encoded.
+CapturedPixels X11ScreenShoter::capture(NativeWindow window)
 {
-    std::vector<unsigned char> buffer;
+    auto started = std::chrono::steady_clock::now();
+    auto gdkDisplay = gdk_display_get_default();
+    auto display = gdk_x11_display_get_xdisplay(gdkDisplay);
 
-    surface->write_to_png_stream([&buffer](const unsigned char* data, unsigned int length) {
-        std::copy(data, data + length, std::back_inserter(buffer));
-        return CAIRO_STATUS_SUCCESS;
-    });
+    gdk_x11_display_error_trap_push(gdkDisplay);
+    XWindowAttributes attributes;
+    XImage* image = nullptr;
+    if (XGetWindowAttributes(display, window, &attributes))
+    {
+        image = XGetImage(display, window, 0, 0, attributes.width, attributes.height, AllPlanes, ZPixmap);
+    }
+    auto error = gdk_x11_display_error_trap_pop(gdkDisplay);
+    if (!image) throw std::runtime_error{"Window can't be captured, X error " + std::to_string(error)};
+
+    std::shared_ptr<const unsigned char> data{reinterpret_cast<unsigned char*>(image->data),
+                                              [image](const unsigned char*) { XDestroyImage(image); }};
+    if (image->bits_per_pixel != CapturedBitsPerPixel || image->byte_order != LSBFirst ||
+        image->red_mask != CapturedRedMask)
+        throw std::runtime_error{"Unsupported pixel format, depth " + std::to_string(image->depth)};
+
+    auto copyTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+    return CapturedPixels{image->width, image->height, image->bytes_per_line, std::move(data), copyTime};
+}
+
+ImageBuffer X11ScreenShoter::encode(const RgbImage& image, ScreenShotFormat format, int quality)
+{
+    auto pixbuf = Gdk::Pixbuf::create_from_data(
+        image.pixels.data(), Gdk::COLORSPACE_RGB, false, 8, image.width, image.height, image.width * 3);
+
+    std::vector<Glib::ustring> keys, values;
+    Glib::ustring type = "png";
+    if (format != ScreenShotFormat::Png)
+    {
+        type = format == ScreenShotFormat::Jpeg ? "jpeg" : "webp";
+        keys.push_back("quality");
+        values.push_back(std::to_string(quality));
+    }
+
+    gchar* buffer = nullptr;
+    gsize size = 0;
+    try
+    {
+        pixbuf->save_to_buffer(buffer, size, type, keys, values);
+    }
+    catch (Glib::Error& e)
+    {
+        std::string message = e.what();
+        // WebP needs a gdk-pixbuf loader which isn't installed everywhere
+        if (format != ScreenShotFormat::Webp) throw std::runtime_error{message};
+
+        Log::error("[X11ScreenShoter] WebP not available, JPEG is used: {}", message);
+        return encode(image, ScreenShotFormat::Jpeg, quality);
+    }
 
-    return buffer;
+    ImageBuffer result{buffer, buffer + size};
+    g_free(buffer);
+    return result;
 }
@@ -2,16 +2,16 @@
 
 #include "control/screenshot/ScreenShoter.hpp"
 
-#include <cairomm/surface.h>
-
 class X11ScreenShoter : public ScreenShoter
 {
 public:
     X11ScreenShoter(Xibo::Window& window);
+    ~X11ScreenShoter() override;
 
 protected:
-    void takeScreenshotNative(NativeWindow window, const ImageBufferCreated& callback) override;
+    void takeScreenshotNative(NativeWindow window, const PixelsCaptured& callback) override;
+    ImageBuffer encode(const RgbImage& image, ScreenShotFormat format, int quality) override;
 
 private:
-    std::vector<unsigned char> copySurfaceToBuffer(const Cairo::RefPtr<Cairo::Surface>& surface);
+    CapturedPixels capture(NativeWindow window);
 };
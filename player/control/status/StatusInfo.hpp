@@ -1,6 +1,7 @@
 #pragma once
 
 #include "cms/CmsStatus.hpp"
+#include "control/screenshot/ScreenShotStatus.hpp"
 #include "control/status/GeneralInfo.hpp"
 #include "control/status/StatusScreenFormatter.hpp"
 #include "schedule/SchedulerStatus.hpp"
@@ -18,4 +19,5 @@ struct StatusInfo
     CmsStatus cms;
     SchedulerStatus scheduler;
     XmrStatus xmr;
+    ScreenShotStatus screenShot;
 };
@@ -11,6 +11,7 @@ std::string StatusScreenFormatter::formatInfo(const StatusInfo& info)
     out << "CMS Info:" << std::endl << formatCmsInfo(info.cms) << std::endl;
     out << "Schedule Info:" << std::endl << formatSchedulerInfo(info.scheduler) << std::endl;
     out << "XMR Info:" << std::endl << formatXmrInfo(info.xmr) << std::endl;
+    out << "ScreenShot Info:" << std::endl << formatScreenShotInfo(info.screenShot) << std::endl;
 
     return out.str();
 }
@@ -84,3 +85,17 @@ std::string StatusScreenFormatter::formatXmrInfo(const XmrStatus& info)
 
     return out.str();
 }
+
+std::string StatusScreenFormatter::formatScreenShotInfo(const ScreenShotStatus& info)
+{
+    std::stringstream out;
+
+    out << "Last captured - " << info.lastCaptured.string() << std::endl;
+    out << "Last submitted - " << info.lastSubmitted.string() << std::endl;
+    out << "Hash - " << info.lastHash << std::endl;
+    out << "Capture time - " << info.copyTime.count() << " ms (UI thread), " << info.encodeTime.count()
+        << " ms (encoding)" << std::endl;
+    out << "Unchanged, not submitted - " << info.unchangedSkipped << std::endl;
+
+    return out.str();
+}
@@ -8,6 +8,7 @@ class GeneralInfo;
 class SchedulerStatus;
 class XmrStatus;
 class CmsStatus;
+struct ScreenShotStatus;
 
 class StatusScreenFormatter
 {
@@ -20,4 +21,5 @@ private:
     std::string formatSchedulerInfo(const SchedulerStatus& info);
     std::string layoutsToString(const std::vector<int>& layouts);
     std::string formatXmrInfo(const XmrStatus& info);
+    std::string formatScreenShotInfo(const ScreenShotStatus& info);
 };
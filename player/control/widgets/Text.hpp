@@ -0,0 +1,39 @@
+#pragma once
+
+#include "common/types/Color.hpp"
+#include "control/widgets/Widget.hpp"
+
+#include <memory>
+
+namespace Xibo
+{
+    // Pango markup drawn natively, optionally scrolling as a marquee
+    class Text : public Widget
+    {
+    public:
+        enum class Alignment
+        {
+            Left,
+            Center,
+            Right
+        };
+
+        enum class Scroll
+        {
+            None,
+            Left,
+            Right,
+            Up,
+            Down
+        };
+
+        virtual void setMarkup(const std::string& markup, Alignment alignment) = 0;
+        virtual void setBackground(const Color& color) = 0;
+        virtual void setScroll(Scroll scroll, double pixelsPerSecond) = 0;
+    };
+}
+
+namespace TextWidgetFactory
+{
+    std::unique_ptr<Xibo::Text> create(int width, int height);
+}
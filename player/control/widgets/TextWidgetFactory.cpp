@@ -0,0 +1,13 @@
+#ifdef USE_GTK
+#include "control/widgets/gtk/TextGtk.hpp"
+#endif
+#include "control/widgets/Text.hpp"
+
+std::unique_ptr<Xibo::Text> TextWidgetFactory::create(int width, int height)
+{
+#ifdef USE_GTK
+    return std::make_unique<TextGtk>(width, height);
+#else
+    return nullptr;
+#endif
+}
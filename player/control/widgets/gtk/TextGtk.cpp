@@ -0,0 +1,150 @@
+#include "control/widgets/gtk/TextGtk.hpp"
+
+const double MaxColorComponent = 255.0;
+const double MicrosecondsInSecond = 1000000.0;
+// WebKit's default font, which the HTML of the text editor is rendered with unless it sets its own
+const std::string DefaultFontFamily = "Sans";
+const double DefaultFontPixelSize = 16.0;
+
+TextGtk::TextGtk(int width, int height) : WidgetGtk(handler_), designWidth_(width), designHeight_(height)
+{
+    WidgetGtk::setSize(width, height);
+
+    layout_ = handler_.create_pango_layout("");
+    Pango::FontDescription font{DefaultFontFamily};
+    font.set_absolute_size(DefaultFontPixelSize * PANGO_SCALE);
+    layout_->set_font_description(font);
+    handler_.signal_draw().connect(sigc::mem_fun(*this, &TextGtk::onDraw));
+}
+
+void TextGtk::show()
+{
+    WidgetGtk::show();
+    startScrolling();
+}
+
+void TextGtk::hide()
+{
+    stopScrolling();
+    WidgetGtk::hide();
+}
+
+void TextGtk::setMarkup(const std::string& markup, Alignment alignment)
+{
+    layout_->set_markup(markup);
+    alignment_ = alignment;
+    updateLayout();
+}
+
+void TextGtk::setBackground(const Color& color)
+{
+    background_ = color;
+    handler_.queue_draw();
+}
+
+void TextGtk::setScroll(Scroll scroll, double pixelsPerSecond)
+{
+    scroll_ = scroll;
+    pixelsPerSecond_ = pixelsPerSecond;
+    updateLayout();
+}
+
+// Horizontal marquees run on a single line, everything else wraps at the region width
+void TextGtk::updateLayout()
+{
+    bool horizontal = scroll_ == Scroll::Left || scroll_ == Scroll::Right;
+    layout_->set_width(horizontal ? -1 : designWidth_ * PANGO_SCALE);
+    layout_->set_wrap(Pango::WRAP_WORD_CHAR);
+
+    switch (alignment_)
+    {
+        case Alignment::Left: layout_->set_alignment(Pango::ALIGN_LEFT); break;
+        case Alignment::Center: layout_->set_alignment(Pango::ALIGN_CENTER); break;
+        case Alignment::Right: layout_->set_alignment(Pango::ALIGN_RIGHT); break;
+    }
+    handler_.queue_draw();
+}
+
+bool TextGtk::onDraw(const Cairo::RefPtr<Cairo::Context>& context)
+{
+    context->scale(static_cast<double>(handler_.get_allocated_width()) / designWidth_,
+                   static_cast<double>(handler_.get_allocated_height()) / designHeight_);
+
+    if (background_)
+    {
+        auto hex = background_->hex();
+        context->set_source_rgba(((hex >> 24) & 0xFF) / MaxColorComponent,
+                                 ((hex >> 16) & 0xFF) / MaxColorComponent,
+                                 ((hex >> 8) & 0xFF) / MaxColorComponent,
+                                 (hex & 0xFF) / MaxColorComponent);
+        context->paint();
+    }
+
+    int textWidth, textHeight;
+    layout_->get_pixel_size(textWidth, textHeight);
+
+    double x = 0, y = 0;
+    switch (scroll_)
+    {
+        case Scroll::None: break;
+        case Scroll::Left: x = designWidth_ - offset_; break;
+        case Scroll::Right: x = offset_ - textWidth; break;
+        case Scroll::Up: y = designHeight_ - offset_; break;
+        case Scroll::Down: y = offset_ - textHeight; break;
+    }
+
+    context->rectangle(0, 0, designWidth_, designHeight_);
+    context->clip();
+    context->move_to(x, y);
+    context->set_source_rgb(0, 0, 0);
+    layout_->show_in_cairo_context(context);
+    return true;
+}
+
+// The text enters from one edge and leaves through the other before it starts again
+bool TextGtk::onTick(const Glib::RefPtr<Gdk::FrameClock>& clock)
+{
+    auto frameTime = clock->get_frame_time();
+    if (lastFrameTime_ != 0)
+    {
+        offset_ += pixelsPerSecond_ * (frameTime - lastFrameTime_) / MicrosecondsInSecond;
+        if (offset_ > scrollPeriod())
+        {
+            offset_ = 0;
+        }
+        handler_.queue_draw();
+    }
+    lastFrameTime_ = frameTime;
+    return true;
+}
+
+void TextGtk::startScrolling()
+{
+    offset_ = 0;
+    lastFrameTime_ = 0;
+    if (scroll_ == Scroll::None || tickCallbackId_ != 0) return;
+
+    tickCallbackId_ = handler_.add_tick_callback(sigc::mem_fun(*this, &TextGtk::onTick));
+}
+
+void TextGtk::stopScrolling()
+{
+    if (tickCallbackId_ == 0) return;
+
+    handler_.remove_tick_callback(tickCallbackId_);
+    tickCallbackId_ = 0;
+}
+
+double TextGtk::scrollPeriod() const
+{
+    int textWidth, textHeight;
+    layout_->get_pixel_size(textWidth, textHeight);
+
+    bool horizontal = scroll_ == Scroll::Left || scroll_ == Scroll::Right;
+    return horizontal ? designWidth_ + textWidth : designHeight_ + textHeight;
+}
+
+Gtk::DrawingArea& TextGtk::handler()
+{
+    return handler_;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "control/widgets/Text.hpp"
+#include "control/widgets/gtk/WidgetGtk.hpp"
+
+#include <boost/optional/optional.hpp>
+#include <gtkmm/drawingarea.h>
+#include <pangomm/layout.h>
+
+// Text is laid out at the size of the region in the layout's design and scaled when drawn, so it
+// keeps the proportions of the HTML rendering. Marquees advance on the frame clock which only ticks
+// while the widget is mapped.
+class TextGtk : public WidgetGtk<Xibo::Text>
+{
+public:
+    TextGtk(int width, int height);
+
+    void show() override;
+    void hide() override;
+
+    void setMarkup(const std::string& markup, Alignment alignment) override;
+    void setBackground(const Color& color) override;
+    void setScroll(Scroll scroll, double pixelsPerSecond) override;
+
+    Gtk::DrawingArea& handler() override;
+
+private:
+    void updateLayout();
+    bool onDraw(const Cairo::RefPtr<Cairo::Context>& context);
+    bool onTick(const Glib::RefPtr<Gdk::FrameClock>& clock);
+    void startScrolling();
+    void stopScrolling();
+    double scrollPeriod() const;
+
+private:
+    Gtk::DrawingArea handler_;
+    Glib::RefPtr<Pango::Layout> layout_;
+    int designWidth_;
+    int designHeight_;
+    Alignment alignment_ = Alignment::Left;
+    boost::optional<Color> background_;
+    Scroll scroll_ = Scroll::None;
+    double pixelsPerSecond_ = 0;
+    double offset_ = 0;
+    gint64 lastFrameTime_ = 0;
+    guint tickCallbackId_ = 0;
+};
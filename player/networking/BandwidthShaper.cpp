@@ -0,0 +1,97 @@
+#include "BandwidthShaper.hpp"
+
+#include "common/logger/Logging.hpp"
+
+#include <ctime>
+
+// Windows are defined in minutes so checking once a minute is enough, and it copes with clock changes
+const std::chrono::seconds UpdateInterval{60};
+
+BandwidthShaper::BandwidthShaper(boost::asio::io_context& ioc) : updateTimer_{ioc} {}
+
+void BandwidthShaper::setLimits(uint64_t globalBytesPerSecond, uint64_t requestBytesPerSecond)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    globalLimit_ = globalBytesPerSecond;
+    requestLimit_ = requestBytesPerSecond;
+    applyRate();
+}
+
+void BandwidthShaper::setDownloadWindows(const DownloadWindows& windows)
+{
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        windows_ = windows;
+    }
+    update();
+
+    if (!updatesScheduled_)
+    {
+        updatesScheduled_ = true;
+        scheduleUpdate();
+    }
+}
+
+bool BandwidthShaper::downloadsAllowed() const
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    return tier_.allowed;
+}
+
+TokenBucket& BandwidthShaper::globalBucket()
+{
+    return globalBucket_;
+}
+
+uint64_t BandwidthShaper::requestRate() const
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    return requestLimit_;
+}
+
+void BandwidthShaper::update()
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    auto tier = windows_.tierAt(localTimeOfDay());
+    if (tier == tier_) return;
+
+    if (tier.allowed != tier_.allowed)
+    {
+        Log::info("[HttpClient] Downloads {}", tier.allowed ? "resumed" : "paused until the next download window");
+    }
+    tier_ = tier;
+    applyRate();
+}
+
+void BandwidthShaper::scheduleUpdate()
+{
+    updateTimer_.expires_after(UpdateInterval);
+    updateTimer_.async_wait([this](const boost::system::error_code& ec) {
+        if (ec) return;
+
+        update();
+        scheduleUpdate();
+    });
+}
+
+// The lowest of the configured cap and the current tier's rate wins
+void BandwidthShaper::applyRate()
+{
+    auto rate = globalLimit_;
+    if (tier_.allowed && tier_.bytesPerSecond != 0 && (rate == 0 || tier_.bytesPerSecond < rate))
+    {
+        rate = tier_.bytesPerSecond;
+    }
+    globalBucket_.setRate(rate);
+}
+
+std::chrono::minutes BandwidthShaper::localTimeOfDay()
+{
+    auto now = std::time(nullptr);
+    std::tm local{};
+    localtime_r(&now, &local);
+
+    return std::chrono::hours{local.tm_hour} + std::chrono::minutes{local.tm_min};
+}
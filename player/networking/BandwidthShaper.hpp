@@ -0,0 +1,42 @@
+#pragma once
+
+#include "common/types/DownloadWindows.hpp"
+#include "networking/TokenBucket.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <mutex>
+
+// Applies download windows and rate caps to download traffic. Requests started outside of the
+// windows are refused so nothing waits for the next one to open; transfers already in progress are
+// not torn down but finish at the global cap.
+class BandwidthShaper
+{
+public:
+    explicit BandwidthShaper(boost::asio::io_context& ioc);
+
+    // Rates in bytes per second, 0 means unlimited
+    void setLimits(uint64_t globalBytesPerSecond, uint64_t requestBytesPerSecond);
+    void setDownloadWindows(const DownloadWindows& windows);
+
+    bool downloadsAllowed() const;
+    TokenBucket& globalBucket();
+    uint64_t requestRate() const;
+
+private:
+    void update();
+    void scheduleUpdate();
+    void applyRate();
+    static std::chrono::minutes localTimeOfDay();
+
+private:
+    boost::asio::steady_timer updateTimer_;
+    bool updatesScheduled_ = false;
+    DownloadWindows windows_;
+    DownloadWindows::Tier tier_;
+    uint64_t globalLimit_ = 0;
+    uint64_t requestLimit_ = 0;
+    TokenBucket globalBucket_;
+    mutable std::mutex mutex_;
+};
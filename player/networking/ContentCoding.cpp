@@ -0,0 +1,129 @@
+#include "ContentCoding.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <stdexcept>
+
+const int GzipWindowBits = 15 + 16;
+const int ZlibWindowBits = 15;
+const int RawDeflateWindowBits = -15;
+const size_t OutputChunkSize = 64 * 1024;
+
+ContentDecoder::ContentDecoder(Encoding encoding) : encoding_(encoding)
+{
+    switch (encoding_)
+    {
+        case Encoding::Gzip: init(GzipWindowBits); break;
+        case Encoding::Deflate: init(ZlibWindowBits); break;
+        case Encoding::Identity: break;
+        case Encoding::Unsupported: throw std::runtime_error{"Unsupported content encoding"};
+    }
+}
+
+ContentDecoder::~ContentDecoder()
+{
+    if (initialized_)
+    {
+        inflateEnd(&stream_);
+    }
+}
+
+ContentDecoder::Encoding ContentDecoder::encodingFrom(std::string_view contentEncoding)
+{
+    if (contentEncoding.empty() || boost::iequals(contentEncoding, "identity")) return Encoding::Identity;
+    if (boost::iequals(contentEncoding, "gzip") || boost::iequals(contentEncoding, "x-gzip")) return Encoding::Gzip;
+    if (boost::iequals(contentEncoding, "deflate")) return Encoding::Deflate;
+
+    return Encoding::Unsupported;
+}
+
+void ContentDecoder::init(int windowBits)
+{
+    if (initialized_)
+    {
+        inflateEnd(&stream_);
+        stream_ = z_stream{};
+    }
+    if (inflateInit2(&stream_, windowBits) != Z_OK) throw std::runtime_error{"Failed to initialize decoder"};
+
+    initialized_ = true;
+}
+
+void ContentDecoder::decode(std::string_view input, std::string& output)
+{
+    if (encoding_ == Encoding::Identity)
+    {
+        output.append(input);
+        return;
+    }
+    if (finished_ || input.empty()) return;
+
+    auto outputSize = output.size();
+    auto rc = inflate(input, output);
+
+    // some servers send raw deflate data instead of zlib format for "deflate"
+    if (rc == Z_DATA_ERROR && encoding_ == Encoding::Deflate && firstChunk_)
+    {
+        output.resize(outputSize);
+        init(RawDeflateWindowBits);
+        rc = inflate(input, output);
+    }
+    firstChunk_ = false;
+
+    if (rc == Z_STREAM_END)
+    {
+        finished_ = true;
+    }
+    else if (rc != Z_OK && rc != Z_BUF_ERROR)
+    {
+        throw std::runtime_error{std::string{"Content decoding failed: "} + (stream_.msg ? stream_.msg : "unknown")};
+    }
+}
+
+int ContentDecoder::inflate(std::string_view input, std::string& output)
+{
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream_.avail_in = static_cast<uInt>(input.size());
+
+    int rc = Z_OK;
+    while (rc == Z_OK && (stream_.avail_in > 0 || stream_.avail_out == 0))
+    {
+        auto offset = output.size();
+        output.resize(offset + OutputChunkSize);
+
+        stream_.next_out = reinterpret_cast<Bytef*>(output.data() + offset);
+        stream_.avail_out = static_cast<uInt>(OutputChunkSize);
+
+        rc = ::inflate(&stream_, Z_NO_FLUSH);
+        output.resize(offset + OutputChunkSize - stream_.avail_out);
+    }
+    return rc;
+}
+
+bool ContentDecoder::finished() const
+{
+    return encoding_ == Encoding::Identity || finished_;
+}
+
+std::string ContentEncoder::gzip(std::string_view input)
+{
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GzipWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        throw std::runtime_error{"Failed to initialize encoder"};
+
+    std::string output;
+    output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    auto rc = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    if (rc != Z_STREAM_END) throw std::runtime_error{"Content encoding failed"};
+
+    return output;
+}
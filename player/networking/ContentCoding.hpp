@@ -0,0 +1,48 @@
+#pragma once
+
+#include <zlib.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Streaming decoder for gzip and deflate Content-Encoding. Input may be fed in arbitrary pieces,
+// decoded bytes are appended to the output as soon as they are available.
+class ContentDecoder
+{
+public:
+    enum class Encoding
+    {
+        Identity,
+        Gzip,
+        Deflate,
+        Unsupported
+    };
+
+    explicit ContentDecoder(Encoding encoding);
+    ~ContentDecoder();
+
+    ContentDecoder(const ContentDecoder&) = delete;
+    ContentDecoder& operator=(const ContentDecoder&) = delete;
+
+    static Encoding encodingFrom(std::string_view contentEncoding);
+
+    void decode(std::string_view input, std::string& output);
+    bool finished() const;
+
+private:
+    void init(int windowBits);
+    int inflate(std::string_view input, std::string& output);
+
+private:
+    Encoding encoding_;
+    z_stream stream_{};
+    bool initialized_ = false;
+    bool finished_ = false;
+    bool firstChunk_ = true;
+};
+
+namespace ContentEncoder
+{
+    std::string gzip(std::string_view input);
+}
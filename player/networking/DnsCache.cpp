@@ -0,0 +1,53 @@
+#include "DnsCache.hpp"
+
+DnsCache::DnsCache(std::chrono::seconds ttl) : ttl_{ttl} {}
+
+std::optional<ip::tcp::resolver::results_type> DnsCache::find(const std::string& host, const std::string& port)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    auto it = entries_.find(key(host, port));
+    if (it == entries_.end()) return {};
+
+    if (it->second.expires <= Clock::now())
+    {
+        entries_.erase(it);
+        return {};
+    }
+    return it->second.results;
+}
+
+void DnsCache::store(const std::string& host,
+                     const std::string& port,
+                     const ip::tcp::resolver::results_type& results)
+{
+    if (results.empty()) return;
+
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    auto now = Clock::now();
+    removeExpired(now);
+    entries_[key(host, port)] = Entry{results, now + ttl_};
+}
+
+void DnsCache::invalidate(const std::string& host, const std::string& port)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    entries_.erase(key(host, port));
+}
+
+std::string DnsCache::key(const std::string& host, const std::string& port) const
+{
+    return host + ":" + port;
+}
+
+void DnsCache::removeExpired(Clock::time_point now)
+{
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        if (it->second.expires <= now)
+            it = entries_.erase(it);
+        else
+            ++it;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace ip = boost::asio::ip;
+
+// Resolved endpoints shared between HTTP sessions. getaddrinfo doesn't report record TTLs so
+// entries expire after a fixed period and are dropped early when connecting to them fails.
+class DnsCache
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr const std::chrono::seconds DefaultTtl{60};
+
+public:
+    explicit DnsCache(std::chrono::seconds ttl = DefaultTtl);
+
+    std::optional<ip::tcp::resolver::results_type> find(const std::string& host, const std::string& port);
+    void store(const std::string& host, const std::string& port, const ip::tcp::resolver::results_type& results);
+    void invalidate(const std::string& host, const std::string& port);
+
+private:
+    struct Entry
+    {
+        ip::tcp::resolver::results_type results;
+        Clock::time_point expires;
+    };
+
+    std::string key(const std::string& host, const std::string& port) const;
+    void removeExpired(Clock::time_point now);
+
+private:
+    std::chrono::seconds ttl_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::mutex mutex_;
+};
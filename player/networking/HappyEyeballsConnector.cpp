@@ -0,0 +1,122 @@
+#include "HappyEyeballsConnector.hpp"
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/error.hpp>
+
+HappyEyeballsConnector::HappyEyeballsConnector(boost::asio::io_context& ioc,
+                                               const ip::tcp::resolver::results_type& results) :
+    ioc_{ioc},
+    strand_{boost::asio::make_strand(ioc)},
+    delayTimer_{ioc},
+    endpoints_{interleave(results)}
+{
+}
+
+// Alternates address families starting with the first resolved one (RFC 8305, section 4)
+std::vector<ip::tcp::endpoint> HappyEyeballsConnector::interleave(const ip::tcp::resolver::results_type& results)
+{
+    std::vector<ip::tcp::endpoint> preferred, other;
+    bool preferV6 = !results.empty() && results.begin()->endpoint().address().is_v6();
+
+    for (auto&& entry : results)
+    {
+        auto&& endpoint = entry.endpoint();
+        (endpoint.address().is_v6() == preferV6 ? preferred : other).push_back(endpoint);
+    }
+
+    std::vector<ip::tcp::endpoint> endpoints;
+    endpoints.reserve(preferred.size() + other.size());
+    for (size_t i = 0; i < std::max(preferred.size(), other.size()); ++i)
+    {
+        if (i < preferred.size()) endpoints.push_back(preferred[i]);
+        if (i < other.size()) endpoints.push_back(other[i]);
+    }
+    return endpoints;
+}
+
+void HappyEyeballsConnector::connect(Callback callback)
+{
+    callback_ = std::move(callback);
+    boost::asio::dispatch(strand_, [self = shared_from_this()]() {
+        if (self->endpoints_.empty()) return self->finish(boost::asio::error::host_not_found, 0);
+
+        self->startAttempt();
+    });
+}
+
+void HappyEyeballsConnector::cancel()
+{
+    boost::asio::dispatch(strand_, [self = shared_from_this()]() {
+        self->finish(boost::asio::error::operation_aborted, 0);
+    });
+}
+
+void HappyEyeballsConnector::startAttempt()
+{
+    auto index = attempts_.size();
+    attempts_.push_back(std::make_unique<ip::tcp::socket>(ioc_));
+    ++pendingAttempts_;
+
+    attempts_[index]->async_connect(
+        endpoints_[index],
+        boost::asio::bind_executor(strand_, [self = shared_from_this(), index](const boost::system::error_code& ec) {
+            self->onAttemptFinished(index, ec);
+        }));
+
+    if (attempts_.size() < endpoints_.size())
+    {
+        delayTimer_.expires_after(AttemptDelay);
+        delayTimer_.async_wait(
+            boost::asio::bind_executor(strand_, [self = shared_from_this()](const boost::system::error_code& ec) {
+                self->onDelayExpired(ec);
+            }));
+    }
+}
+
+void HappyEyeballsConnector::onAttemptFinished(size_t index, const boost::system::error_code& ec)
+{
+    --pendingAttempts_;
+    if (finished_) return;
+
+    if (!ec) return finish(ec, index);
+
+    lastError_ = ec;
+    if (attempts_.size() < endpoints_.size())
+    {
+        // don't wait for the delay when the attempt has already failed
+        delayTimer_.cancel();
+        startAttempt();
+    }
+    else if (pendingAttempts_ == 0)
+    {
+        finish(lastError_, 0);
+    }
+}
+
+void HappyEyeballsConnector::onDelayExpired(const boost::system::error_code& ec)
+{
+    if (ec || finished_ || attempts_.size() >= endpoints_.size()) return;
+
+    startAttempt();
+}
+
+void HappyEyeballsConnector::finish(const boost::system::error_code& ec, size_t winner)
+{
+    if (finished_) return;
+    finished_ = true;
+
+    delayTimer_.cancel();
+    for (size_t i = 0; i != attempts_.size(); ++i)
+    {
+        if (ec || i != winner)
+        {
+            boost::system::error_code ignored;
+            attempts_[i]->close(ignored);
+        }
+    }
+
+    if (!ec)
+        callback_(ec, Result{std::move(*attempts_[winner]), winner});
+    else
+        callback_(ec, Result{ip::tcp::socket{ioc_}, 0});
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ip = boost::asio::ip;
+
+// Connects to the first reachable endpoint as described in RFC 8305. Endpoints are interleaved by
+// address family and a new attempt is started when the previous one fails or doesn't complete
+// within the attempt delay, so an unreachable IPv6 address doesn't block the IPv4 fallback.
+class HappyEyeballsConnector : public std::enable_shared_from_this<HappyEyeballsConnector>
+{
+    static constexpr const std::chrono::milliseconds AttemptDelay{250};
+
+public:
+    struct Result
+    {
+        ip::tcp::socket socket;
+        size_t endpointIndex;
+    };
+    using Callback = std::function<void(const boost::system::error_code&, Result)>;
+
+    HappyEyeballsConnector(boost::asio::io_context& ioc, const ip::tcp::resolver::results_type& results);
+
+    void connect(Callback callback);
+    void cancel();
+
+    static std::vector<ip::tcp::endpoint> interleave(const ip::tcp::resolver::results_type& results);
+
+private:
+    void startAttempt();
+    void onAttemptFinished(size_t index, const boost::system::error_code& ec);
+    void onDelayExpired(const boost::system::error_code& ec);
+    void finish(const boost::system::error_code& ec, size_t winner);
+
+private:
+    boost::asio::io_context& ioc_;
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+    boost::asio::steady_timer delayTimer_;
+    std::vector<ip::tcp::endpoint> endpoints_;
+    std::vector<std::unique_ptr<ip::tcp::socket>> attempts_;
+    size_t pendingAttempts_ = 0;
+    boost::system::error_code lastError_;
+    bool finished_ = false;
+    Callback callback_;
+};
@@ -0,0 +1,127 @@
+#include "HttpCapture.hpp"
+
+#include <sstream>
+
+// Header line followed by the raw fields of a record:
+// <started ms> <duration ms> <method> <target> <size of each of the 5 string fields>\n<fields>
+const std::string CaptureMagic = "xibo-http-capture 1\n";
+const size_t ReadBufferSize = 64 * 1024;
+
+HttpCapture::HttpCapture(const FilePath& path) :
+    file_{gzopen(path.string().c_str(), "wb")},
+    started_{std::chrono::steady_clock::now()}
+{
+    if (!file_) throw HttpCapture::Error{"HttpCapture", "Can't open " + path.string()};
+
+    write(CaptureMagic);
+}
+
+HttpCapture::~HttpCapture()
+{
+    gzclose(file_);
+}
+
+std::chrono::milliseconds HttpCapture::elapsed() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started_);
+}
+
+void HttpCapture::record(const HttpExchange& exchange)
+{
+    if (!active_) return;
+
+    std::ostringstream header;
+    header << exchange.started.count() << ' ' << exchange.duration.count() << ' ' << exchange.method << ' '
+           << exchange.target << ' ' << exchange.requestHeaders.size() << ' ' << exchange.requestBody.size() << ' '
+           << exchange.errorDomain.size() << ' ' << exchange.errorMessage.size() << ' '
+           << exchange.responseBody.size() << '\n';
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    if (!active_) return;
+
+    try
+    {
+        write(header.str());
+        write(exchange.requestHeaders);
+        write(exchange.requestBody);
+        write(exchange.errorDomain);
+        write(exchange.errorMessage);
+        write(exchange.responseBody);
+        if (gzflush(file_, Z_SYNC_FLUSH) != Z_OK) throw HttpCapture::Error{"HttpCapture", "Write failed"};
+    }
+    catch (std::exception&)
+    {
+        // a partly written record can't be read back, so nothing more is appended after it
+        active_ = false;
+        throw;
+    }
+}
+
+bool HttpCapture::active() const
+{
+    return active_;
+}
+
+void HttpCapture::write(const std::string& data)
+{
+    if (data.empty()) return;
+
+    if (gzwrite(file_, data.data(), static_cast<unsigned int>(data.size())) == 0)
+        throw HttpCapture::Error{"HttpCapture", "Write failed"};
+}
+
+std::vector<HttpExchange> HttpCapture::load(const FilePath& path)
+{
+    auto file = gzopen(path.string().c_str(), "rb");
+    if (!file) throw HttpCapture::Error{"HttpCapture", "Can't open " + path.string()};
+
+    std::string content;
+    std::vector<char> buffer(ReadBufferSize);
+    int read = 0;
+    while ((read = gzread(file, buffer.data(), static_cast<unsigned int>(buffer.size()))) > 0)
+    {
+        content.append(buffer.data(), static_cast<size_t>(read));
+    }
+    gzclose(file);
+
+    if (content.compare(0, CaptureMagic.size(), CaptureMagic) != 0)
+        throw HttpCapture::Error{"HttpCapture", path.string() + " is not a capture file"};
+
+    std::vector<HttpExchange> exchanges;
+    size_t pos = CaptureMagic.size();
+    while (pos < content.size())
+    {
+        auto headerEnd = content.find('\n', pos);
+        if (headerEnd == std::string::npos) throw HttpCapture::Error{"HttpCapture", "Truncated record"};
+
+        std::istringstream header{content.substr(pos, headerEnd - pos)};
+        HttpExchange exchange;
+        long long started = 0, duration = 0;
+        size_t sizes[5] = {};
+        header >> started >> duration >> exchange.method >> exchange.target;
+        for (auto&& size : sizes)
+        {
+            header >> size;
+        }
+        if (!header) throw HttpCapture::Error{"HttpCapture", "Invalid record header"};
+
+        exchange.started = std::chrono::milliseconds{started};
+        exchange.duration = std::chrono::milliseconds{duration};
+
+        pos = headerEnd + 1;
+        std::string* fields[] = {&exchange.requestHeaders,
+                                 &exchange.requestBody,
+                                 &exchange.errorDomain,
+                                 &exchange.errorMessage,
+                                 &exchange.responseBody};
+        for (size_t i = 0; i != 5; ++i)
+        {
+            if (content.size() - pos < sizes[i]) throw HttpCapture::Error{"HttpCapture", "Truncated record"};
+
+            fields[i]->assign(content, pos, sizes[i]);
+            pos += sizes[i];
+        }
+        exchanges.push_back(std::move(exchange));
+    }
+    return exchanges;
+}
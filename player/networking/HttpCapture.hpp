@@ -0,0 +1,57 @@
+#pragma once
+
+#include "common/PlayerRuntimeError.hpp"
+#include "common/fs/FilePath.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+// One request as seen by HttpClient and the result it produced. Bodies are kept as the caller
+// sent and received them, i.e. before request compression and after content decoding.
+struct HttpExchange
+{
+    std::string method;
+    std::string target;
+    std::string requestHeaders;  // "Name: value" lines
+    std::string requestBody;
+    std::chrono::milliseconds started{0};  // since the capture was started
+    std::chrono::milliseconds duration{0};
+    std::string errorDomain;  // empty when the request succeeded
+    std::string errorMessage;
+    std::string responseBody;
+};
+
+// Appends exchanges to a gzipped capture file which HttpReplay can serve later. Every record is
+// flushed so a capture taken on a misbehaving display survives a crash. Captures contain the CMS
+// key and all content, so they should be handled like the CMS settings themselves.
+class HttpCapture
+{
+public:
+    struct Error : PlayerRuntimeError
+    {
+        using PlayerRuntimeError::PlayerRuntimeError;
+    };
+
+    explicit HttpCapture(const FilePath& path);
+    ~HttpCapture();
+
+    std::chrono::milliseconds elapsed() const;
+    // throws when the record couldn't be written, the capture is stopped after that
+    void record(const HttpExchange& exchange);
+    bool active() const;
+
+    static std::vector<HttpExchange> load(const FilePath& path);
+
+private:
+    void write(const std::string& data);
+
+private:
+    std::mutex mutex_;
+    gzFile file_;
+    std::atomic<bool> active_ = true;
+    std::chrono::steady_clock::time_point started_;
+};
@@ -3,13 +3,42 @@
 #include "common/logger/Logging.hpp"
 #include "common/types/Uri.hpp"
 
+#include "networking/ContentCoding.hpp"
 #include "networking/HttpRequest.hpp"
 #include "networking/HttpSession.hpp"
 #include "networking/ProxyHttpRequest.hpp"
+#include "networking/RetryingHttpRequest.hpp"
 
 const int DefaultConcurrentRequests = 4;
+const size_t MinCompressedBodySize = 4 * 1024;
+const std::string AcceptedEncodings = "gzip, deflate";
+const size_t HedgedLatencySamples = 64;
+const size_t MinHedgedLatencySamples = 16;
+const double HedgePercentile = 0.95;
+const std::chrono::milliseconds MinHedgeDelay{1000};
 
-HttpClient::HttpClient() : work_{ioc_}
+void setContentHeaders(http::request<http::string_body>& request, bool bodyCompressed)
+{
+    request.set(http::field::accept_encoding, AcceptedEncodings);
+    if (bodyCompressed)
+    {
+        request.set(http::field::content_encoding, "gzip");
+    }
+}
+
+std::string headersOf(const http::request<http::string_body>& request)
+{
+    std::string headers;
+    for (auto&& field : request)
+    {
+        auto name = field.name_string();
+        auto value = field.value();
+        headers.append(name.data(), name.size()).append(": ").append(value.data(), value.size()).append("\r\n");
+    }
+    return headers;
+}
+
+HttpClient::HttpClient() : work_{ioc_}, hedgedLatencies_{HedgedLatencySamples}, shaper_{ioc_}
 {
     for (int i = 0; i != DefaultConcurrentRequests; ++i)
     {
@@ -33,7 +62,7 @@ void HttpClient::shutdown()
     if (!ioc_.stopped())
     {
         ioc_.stop();
-        cancelActiveSession();
+        cancelActiveRequests();
     }
 }
 
@@ -46,46 +75,231 @@ void HttpClient::setProxyServer(const boost::optional<Uri>& proxy)
     }
 }
 
-void HttpClient::cancelActiveSession()
+// Expected to be configured at startup before any request is sent
+void HttpClient::setTimeouts(const HttpTimeouts& timeouts)
+{
+    timeouts_ = timeouts;
+}
+
+void HttpClient::setRetryPolicy(const HttpRetryPolicy& policy)
+{
+    retryPolicy_ = policy;
+}
+
+void HttpClient::setBandwidthLimits(uint64_t globalBytesPerSecond, uint64_t requestBytesPerSecond)
+{
+    shaper_.setLimits(globalBytesPerSecond, requestBytesPerSecond);
+}
+
+void HttpClient::setDownloadWindows(const DownloadWindows& windows)
 {
-    for (auto&& session : activeSessions_)
+    shaper_.setDownloadWindows(windows);
+}
+
+bool HttpClient::downloadsAllowed() const
+{
+    return shaper_.downloadsAllowed();
+}
+
+// Capture and replay are debugging aids for reproducing field issues and are set up before any
+// request is sent
+void HttpClient::startCapture(const FilePath& captureFile)
+{
+    capture_ = std::make_unique<HttpCapture>(captureFile);
+    Log::info("[HttpClient] Capturing requests to {}", captureFile.string());
+}
+
+void HttpClient::replayFrom(const FilePath& captureFile, double speed)
+{
+    auto exchanges = HttpCapture::load(captureFile);
+    Log::info("[HttpClient] Replaying {} requests from {}", exchanges.size(), captureFile.string());
+
+    replay_ = std::make_unique<HttpReplay>(ioc_, std::move(exchanges), speed);
+}
+
+void HttpClient::cancelActiveRequests()
+{
+    std::unique_lock<std::mutex> lock{activeRequestsMutex_};
+    for (auto&& request : activeRequests_)
     {
-        if (!session.expired())
+        if (auto activeRequest = request.lock())
         {
-            session.lock()->cancel();
+            activeRequest->cancel();
         }
     }
 }
 
-boost::future<HttpResponseResult> HttpClient::get(const Uri& uri)
+// A failed peer request isn't retried as the next peer or the CMS can be asked instead
+boost::future<HttpResponseResult> HttpClient::get(const Uri& uri, RequestTraffic traffic)
 {
-    return send(http::verb::get, uri, {});
+    auto retry = traffic == RequestTraffic::Peer ? RequestRetry::None : RequestRetry::Idempotent;
+    return send(http::verb::get, uri, {}, RequestCompression::None, retry, traffic);
 }
 
-boost::future<HttpResponseResult> HttpClient::post(const Uri& uri, const std::string& body)
+// Request compression is opt-in as the server has to be configured to decode request bodies.
+// POST requests are not retried unless the caller knows that repeating them is harmless.
+boost::future<HttpResponseResult> HttpClient::post(const Uri& uri,
+                                                   std::string body,
+                                                   RequestCompression compression,
+                                                   RequestRetry retry,
+                                                   RequestTraffic traffic)
 {
-    return send(http::verb::post, uri, body);
+    return send(http::verb::post, uri, std::move(body), compression, retry, traffic);
 }
 
-boost::future<HttpResponseResult> HttpClient::send(http::verb method, const Uri& uri, const std::string& body)
+// Replayed requests have no response header
+boost::future<HttpFetchResult> HttpClient::fetch(const Uri& uri, RequestRetry retry, const HttpFetchOptions& options)
+{
+    auto header = std::make_shared<boost::optional<http::response_header<>>>();
+    auto onHeader = [header](const http::response_header<>& received) { *header = received; };
+
+    return send(http::verb::get, uri, {}, RequestCompression::None, retry, RequestTraffic::Control, onHeader, options)
+        .then([header](boost::future<HttpResponseResult> future) {
+            auto [error, body] = future.get();
+            return HttpFetchResult{error, HttpFetchedResponse{std::move(*header), std::move(body)}};
+        });
+}
+
+HttpTransferStats HttpClient::transferStats() const
+{
+    return counters_.stats();
+}
+
+boost::future<HttpResponseResult> HttpClient::send(http::verb method,
+                                                   const Uri& uri,
+                                                   std::string body,
+                                                   RequestCompression compression,
+                                                   RequestRetry retry,
+                                                   RequestTraffic traffic,
+                                                   HeaderCallback headerCallback,
+                                                   const HttpFetchOptions& options)
 {
     if (ioc_.stopped()) return managerStoppedError();
+    if (replay_) return replay_->respond(std::string{http::to_string(method)}, uri.string(), body);
 
-    auto session = std::make_shared<HttpSession>(ioc_);
-    activeSessions_.push_back(session);
+    // the body is moved along into the HTTP request, only a capture needs its own copy
+    auto unencodedSize = body.size();
+    bool captured = capture_ && capture_->active();
+    auto capturedBody = captured ? body : std::string{};
+    bool compressBody = compression == RequestCompression::Gzip && unencodedSize >= MinCompressedBodySize;
+    auto requestBody = compressBody ? ContentEncoder::gzip(body) : std::move(body);
+    counters_.sent(requestBody.size(), unencodedSize);
 
-    if (proxy_)
+    http::request<http::string_body> httpRequest;
+    bool proxied = proxy_ && traffic != RequestTraffic::Peer;
+    if (proxied)
+    {
+        ProxyHttpRequest request{method, proxy_->authority().optionalUserInfo(), uri, std::move(requestBody)};
+        httpRequest = request.get();
+    }
+    else
+    {
+        HttpRequest request{method, uri, std::move(requestBody)};
+        httpRequest = request.get();
+    }
+    setContentHeaders(httpRequest, compressBody);
+    if (!options.range.empty())
+    {
+        // a range of an encoded body couldn't be decoded on its own
+        httpRequest.set(http::field::range, options.range);
+        httpRequest.set(http::field::accept_encoding, "identity");
+    }
+    if (!options.ifNoneMatch.empty())
+    {
+        httpRequest.set(http::field::if_none_match, options.ifNoneMatch);
+    }
+    if (!options.ifModifiedSince.empty())
+    {
+        httpRequest.set(http::field::if_modified_since, options.ifModifiedSince);
+    }
+    auto capturedHeaders = captured ? headersOf(httpRequest) : std::string{};
+
+    bool shaped = traffic == RequestTraffic::Download;
+    auto sessionFactory = [this, shaped, maxBodySize = options.maxBodySize]() {
+        auto session = std::make_shared<HttpSession>(ioc_, dnsCache_, timeouts_, counters_);
+        session->setBodyLimit(maxBodySize);
+        if (shaped)
+        {
+            session->setShaping(shaper_.globalBucket(), shaper_.requestRate());
+        }
+        return session;
+    };
+    auto request = std::make_shared<RetryingHttpRequest>(
+        ioc_, proxied ? proxy_.value() : uri, std::move(httpRequest), sessionFactory, counters_);
+    applyRetryPolicy(*request, retry);
+    if (shaped)
+    {
+        request->setShaper(shaper_);
+    }
+    if (headerCallback)
     {
-        ProxyHttpRequest request{method, proxy_->authority().optionalUserInfo(), uri, body};
-        return session->send(proxy_.value(), request.get());
+        request->setHeaderCallback(std::move(headerCallback));
+    }
+    addActiveRequest(request);
+
+    auto result = std::make_shared<boost::promise<HttpResponseResult>>();
+    if (captured)
+    {
+        HttpExchange exchange;
+        exchange.method = std::string{http::to_string(method)};
+        exchange.target = uri.string();
+        exchange.requestHeaders = std::move(capturedHeaders);
+        exchange.requestBody = std::move(capturedBody);
+        exchange.started = capture_->elapsed();
+
+        request->start([result, capture = capture_.get(), exchange = std::move(exchange)](
+                           HttpResponseResult response) mutable {
+            exchange.duration = capture->elapsed() - exchange.started;
+            exchange.errorDomain = response.first.domain();
+            exchange.errorMessage = response.first.message();
+            exchange.responseBody = std::move(response.second);
+            try
+            {
+                capture->record(exchange);
+            }
+            catch (std::exception& e)
+            {
+                Log::error("[HttpClient] Capture stopped: {}", e.what());
+            }
+            response.second = std::move(exchange.responseBody);
+
+            result->set_value(std::move(response));
+        });
     }
     else
     {
-        HttpRequest request{method, uri, body};
-        return session->send(uri, request.get());
+        request->start([result](HttpResponseResult response) { result->set_value(std::move(response)); });
+    }
+    return result->get_future();
+}
+
+void HttpClient::applyRetryPolicy(RetryingHttpRequest& request, RequestRetry retry)
+{
+    if (retry == RequestRetry::None) return;
+
+    request.setRetryPolicy(retryPolicy_);
+    if (retry == RequestRetry::Hedged && retryPolicy_.hedging)
+    {
+        // requests are only hedged once there are enough samples to tell what a straggler is
+        boost::optional<std::chrono::milliseconds> hedgeDelay;
+        if (auto latency = hedgedLatencies_.percentile(HedgePercentile, MinHedgedLatencySamples))
+        {
+            hedgeDelay = std::max(*latency, MinHedgeDelay);
+        }
+        request.setHedging(hedgeDelay, hedgedLatencies_);
     }
 }
 
+void HttpClient::addActiveRequest(const std::shared_ptr<RetryingHttpRequest>& request)
+{
+    std::unique_lock<std::mutex> lock{activeRequestsMutex_};
+
+    auto expired = [](const std::weak_ptr<RetryingHttpRequest>& active) { return active.expired(); };
+    activeRequests_.erase(std::remove_if(activeRequests_.begin(), activeRequests_.end(), expired),
+                          activeRequests_.end());
+    activeRequests_.push_back(request);
+}
+
 boost::future<HttpResponseResult> HttpClient::managerStoppedError()
 {
     boost::promise<HttpResponseResult> result;
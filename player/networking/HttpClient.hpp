@@ -1,16 +1,54 @@
 #pragma once
 
 #include "common/JoinableThread.hpp"
+#include "common/types/DownloadWindows.hpp"
 #include "common/types/Uri.hpp"
+#include "networking/BandwidthShaper.hpp"
+#include "networking/DnsCache.hpp"
+#include "networking/HttpCapture.hpp"
+#include "networking/HttpRequestPolicy.hpp"
+#include "networking/HttpReplay.hpp"
+#include "networking/HttpTransferStats.hpp"
+#include "networking/LatencyTracker.hpp"
 #include "networking/ResponseResult.hpp"
 
 #include <boost/asio/io_context.hpp>
+#include <boost/beast/http/message.hpp>
 #include <boost/beast/http/verb.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/thread/future.hpp>
 
+#include <limits>
+#include <mutex>
+
 using HttpResponseResult = ResponseResult<std::string>;
-class HttpSession;
+class RetryingHttpRequest;
+
+// Decoded body along with the response header, which is present whenever a complete response was
+// received, also for a status reported as an error
+struct HttpFetchedResponse
+{
+    boost::optional<boost::beast::http::response_header<>> header;
+    std::string body;
+};
+using HttpFetchResult = ResponseResult<HttpFetchedResponse>;
+
+// A range is sent as given and answered with 206 Partial Content. A body which grows past the limit
+// fails the request without a retry. With validators of a stored copy the origin may answer 304 Not
+// Modified, which is reported as an error along with its header.
+struct HttpFetchOptions
+{
+    std::string range;
+    uint64_t maxBodySize = std::numeric_limits<uint64_t>::max();
+    std::string ifNoneMatch;
+    std::string ifModifiedSince;
+};
+
+enum class RequestCompression
+{
+    None,
+    Gzip
+};
 class Uri;
 
 class HttpClient : private boost::noncopyable
@@ -22,21 +60,59 @@ public:
 
     void shutdown();
     void setProxyServer(const boost::optional<Uri>& uri);
-    boost::future<HttpResponseResult> get(const Uri& uri);
-    boost::future<HttpResponseResult> post(const Uri& uri, const std::string& body);
+    void setTimeouts(const HttpTimeouts& timeouts);
+    void setRetryPolicy(const HttpRetryPolicy& policy);
+    void setBandwidthLimits(uint64_t globalBytesPerSecond, uint64_t requestBytesPerSecond);
+    void setDownloadWindows(const DownloadWindows& windows);
+    bool downloadsAllowed() const;
+    // every following exchange is appended to the capture file
+    void startCapture(const FilePath& captureFile);
+    // requests are answered from the capture file and never reach the network
+    void replayFrom(const FilePath& captureFile, double speed);
+    boost::future<HttpResponseResult> get(const Uri& uri, RequestTraffic traffic = RequestTraffic::Control);
+    boost::future<HttpResponseResult> post(const Uri& uri,
+                                           std::string body,
+                                           RequestCompression compression = RequestCompression::None,
+                                           RequestRetry retry = RequestRetry::None,
+                                           RequestTraffic traffic = RequestTraffic::Control);
+    // GET for callers which need the response header, e.g. to honour its caching fields
+    boost::future<HttpFetchResult> fetch(const Uri& uri,
+                                         RequestRetry retry = RequestRetry::Idempotent,
+                                         const HttpFetchOptions& options = {});
+    HttpTransferStats transferStats() const;
 
 private:
+    using HeaderCallback = std::function<void(const boost::beast::http::response_header<>&)>;
+
     HttpClient();
 
-    boost::future<HttpResponseResult> send(boost::beast::http::verb method, const Uri& uri, const std::string& body);
+    boost::future<HttpResponseResult> send(boost::beast::http::verb method,
+                                           const Uri& uri,
+                                           std::string body,
+                                           RequestCompression compression,
+                                           RequestRetry retry,
+                                           RequestTraffic traffic,
+                                           HeaderCallback headerCallback = {},
+                                           const HttpFetchOptions& options = {});
+    void applyRetryPolicy(RetryingHttpRequest& request, RequestRetry retry);
+    void addActiveRequest(const std::shared_ptr<RetryingHttpRequest>& request);
 
     boost::future<HttpResponseResult> managerStoppedError();
-    void cancelActiveSession();
+    void cancelActiveRequests();
 
 private:
     boost::asio::io_context ioc_;
     boost::asio::io_context::work work_;
     std::vector<std::unique_ptr<JoinableThread>> workerThreads_;
-    std::vector<std::weak_ptr<HttpSession>> activeSessions_;
+    std::vector<std::weak_ptr<RetryingHttpRequest>> activeRequests_;
+    std::mutex activeRequestsMutex_;
     boost::optional<Uri> proxy_;
+    HttpTimeouts timeouts_;
+    HttpRetryPolicy retryPolicy_;
+    LatencyTracker hedgedLatencies_;
+    BandwidthShaper shaper_;
+    DnsCache dnsCache_;
+    HttpTransferCounters counters_;
+    std::unique_ptr<HttpCapture> capture_;
+    std::unique_ptr<HttpReplay> replay_;
 };
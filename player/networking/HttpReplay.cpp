@@ -0,0 +1,95 @@
+#include "HttpReplay.hpp"
+
+#include "common/logger/Logging.hpp"
+
+#include <boost/asio/steady_timer.hpp>
+#include <boost/optional/optional.hpp>
+
+#include <algorithm>
+
+// Captures are usually replayed against another CMS address, so only the path and query are compared
+static std::string_view resourceOf(std::string_view target)
+{
+    auto schemeEnd = target.find("://");
+    if (schemeEnd == std::string_view::npos) return target;
+
+    auto pathStart = target.find('/', schemeEnd + 3);
+    return pathStart == std::string_view::npos ? std::string_view{"/"} : target.substr(pathStart);
+}
+
+HttpReplay::HttpReplay(boost::asio::io_context& ioc, std::vector<HttpExchange> exchanges, double speed) :
+    ioc_{ioc},
+    exchanges_{std::move(exchanges)},
+    used_(exchanges_.size(), false),
+    speed_{speed}
+{
+}
+
+boost::future<ResponseResult<std::string>> HttpReplay::respond(const std::string& method,
+                                                               const std::string& target,
+                                                               const std::string& body)
+{
+    using Result = ResponseResult<std::string>;
+
+    auto promise = std::make_shared<boost::promise<Result>>();
+    auto future = promise->get_future();
+
+    auto exchange = match(method, target, body);
+    if (!exchange)
+    {
+        Log::debug("[HttpReplay] Not captured: {} {}", method, target);
+        promise->set_value(Result{PlayerError{"HTTP", "Not captured"}, {}});
+        return future;
+    }
+
+    Result result{PlayerError{exchange->errorDomain, exchange->errorMessage}, exchange->responseBody};
+    if (speed_ <= 0)
+    {
+        promise->set_value(std::move(result));
+        return future;
+    }
+
+    auto delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(exchange->duration / speed_);
+    auto timer = std::make_shared<boost::asio::steady_timer>(ioc_, delay);
+    timer->async_wait([timer, promise, result = std::move(result)](const boost::system::error_code&) mutable {
+        promise->set_value(std::move(result));
+    });
+    return future;
+}
+
+const HttpExchange* HttpReplay::match(const std::string& method, const std::string& target, const std::string& body)
+{
+    auto commonPrefix = [&body](const std::string& other) {
+        auto mismatch = std::mismatch(body.begin(), body.end(), other.begin(), other.end());
+        return static_cast<size_t>(mismatch.first - body.begin());
+    };
+    auto resource = resourceOf(target);
+    auto bestOf = [&](bool unusedOnly) {
+        boost::optional<size_t> best;
+        size_t bestPrefix = 0;
+        for (size_t i = 0; i != exchanges_.size(); ++i)
+        {
+            auto&& exchange = exchanges_[i];
+            if ((unusedOnly && used_[i]) || exchange.method != method || resourceOf(exchange.target) != resource)
+                continue;
+
+            auto prefix = commonPrefix(exchange.requestBody);
+            if (!best || prefix > bestPrefix)
+            {
+                best = i;
+                bestPrefix = prefix;
+            }
+            if (prefix == body.size() && prefix == exchange.requestBody.size()) break;
+        }
+        return best;
+    };
+
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    auto best = bestOf(true);
+    if (!best) best = bestOf(false);
+    if (!best) return nullptr;
+
+    used_[*best] = true;
+    return &exchanges_[*best];
+}
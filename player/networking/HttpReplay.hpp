@@ -0,0 +1,34 @@
+#pragma once
+
+#include "networking/HttpCapture.hpp"
+#include "networking/ResponseResult.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/thread/future.hpp>
+
+// Serves responses from an HttpCapture instead of the network. A request gets the unused recorded
+// exchange with the same method, path and query whose body shares the longest prefix with its own, so
+// XMDS calls are told apart by their SOAP method and then by their arguments even when timestamps
+// in the body differ. Once every candidate has been used they are served again, which lets several
+// collection cycles run from one capture.
+class HttpReplay
+{
+public:
+    // speed scales the recorded durations: 1 replays in real time, 10 ten times faster and 0 answers
+    // immediately
+    HttpReplay(boost::asio::io_context& ioc, std::vector<HttpExchange> exchanges, double speed);
+
+    boost::future<ResponseResult<std::string>> respond(const std::string& method,
+                                                       const std::string& target,
+                                                       const std::string& body);
+
+private:
+    const HttpExchange* match(const std::string& method, const std::string& target, const std::string& body);
+
+private:
+    boost::asio::io_context& ioc_;
+    std::mutex mutex_;
+    std::vector<HttpExchange> exchanges_;
+    std::vector<bool> used_;
+    double speed_;
+};
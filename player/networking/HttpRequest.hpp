@@ -13,7 +13,7 @@ namespace http = boost::beast::http;
 class HttpRequest
 {
 public:
-    HttpRequest(http::verb method, const Uri& uri, const std::string& body) :
+    HttpRequest(http::verb method, const Uri& uri, std::string body) :
         method_(method),
         uri_(uri),
         body_(std::move(body))
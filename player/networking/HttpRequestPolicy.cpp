@@ -0,0 +1,17 @@
+#include "HttpRequestPolicy.hpp"
+
+#include <algorithm>
+#include <random>
+
+// Exponential backoff with "full jitter": a uniformly random delay up to the capped exponential
+// value, so players that failed together don't retry together
+std::chrono::milliseconds HttpRetryPolicy::backoff(unsigned int attempt) const
+{
+    thread_local std::mt19937 generator{std::random_device{}()};
+
+    auto exponent = std::min(attempt, 16u);
+    auto ceiling = std::min<std::chrono::milliseconds::rep>(baseDelay.count() << exponent, maxDelay.count());
+
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> distribution{0, std::max(ceiling, {0})};
+    return std::chrono::milliseconds{distribution(generator)};
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+
+// Deadlines for the phases of a single HTTP exchange. Each one is rearmed when the phase starts so
+// a large download is only aborted when it stalls, not when it takes long.
+struct HttpTimeouts
+{
+    std::chrono::milliseconds connect{std::chrono::seconds{15}};  // resolve and TCP connect
+    std::chrono::milliseconds handshake{std::chrono::seconds{15}};
+    std::chrono::milliseconds firstByte{std::chrono::seconds{60}};  // request sent until response header
+    std::chrono::milliseconds idle{std::chrono::seconds{30}};       // between pieces of the body
+};
+
+enum class RequestRetry
+{
+    None,        // the first result is reported as is
+    Idempotent,  // transient failures are retried with backoff
+    Hedged       // as Idempotent, and a duplicate request is sent when the first one straggles
+};
+
+enum class RequestTraffic
+{
+    Control,   // XMDS calls the player needs to stay in sync with the CMS
+    Download,  // content, subject to download windows and bandwidth limits
+    Peer       // content from other players on the LAN, sent directly rather than through the proxy
+};
+
+struct HttpRetryPolicy
+{
+    unsigned int maxAttempts = 3;
+    std::chrono::milliseconds baseDelay{500};
+    std::chrono::milliseconds maxDelay{std::chrono::seconds{8}};
+    bool hedging = false;
+
+    std::chrono::milliseconds backoff(unsigned int attempt) const;
+};
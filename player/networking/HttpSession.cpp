@@ -1,6 +1,8 @@
 #include "HttpSession.hpp"
 
+#include <boost/asio/bind_executor.hpp>
 #include <boost/asio/connect.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/ssl/rfc2818_verification.hpp>
 #include <boost/beast/core/detail/base64.hpp>
 #include <boost/beast/http/read.hpp>
@@ -8,49 +10,97 @@
 
 namespace ph = std::placeholders;
 
-HttpSession::HttpSession(boost::asio::io_context& ioc) : resolver_{ioc}
+const size_t BodyChunkSize = 64 * 1024;
+
+HttpSession::HttpSession(boost::asio::io_context& ioc,
+                         DnsCache& dnsCache,
+                         const HttpTimeouts& timeouts,
+                         HttpTransferCounters& counters) :
+    ioc_{ioc},
+    strand_{boost::asio::make_strand(ioc)},
+    timeouts_{timeouts},
+    deadline_{ioc},
+    resolver_{ioc},
+    dnsCache_{dnsCache},
+    bodyChunk_(BodyChunkSize),
+    throttleTimer_{ioc},
+    counters_{counters}
 {
     ssl::context ctx{ssl::context::sslv23_client};
     ctx.set_default_verify_paths();
     ctx.set_verify_mode(ssl::verify_peer);
 
     socket_ = std::make_unique<ssl::stream<ip::tcp::socket>>(ioc, ctx);
-    response_.body_limit(std::numeric_limits<std::uint64_t>::max());
+    response_.body_limit(bodyLimit_);
+}
+
+void HttpSession::setShaping(TokenBucket& globalBucket, uint64_t requestRate)
+{
+    globalBucket_ = &globalBucket;
+    requestBucket_ = std::make_unique<TokenBucket>(requestRate);
+}
+
+void HttpSession::setBodyLimit(uint64_t bytes)
+{
+    bodyLimit_ = bytes;
+    response_.body_limit(bytes);
 }
 
-boost::future<HttpResponseResult> HttpSession::send(const Uri& uri, const http::request<http::string_body>& request)
+void HttpSession::send(const Uri& uri, SharedHttpRequest request, ResultCallback callback)
 {
+    callback_ = std::move(callback);
     useSsl_ = uri.scheme() == Uri::HttpsScheme;
-    request_ = request;
+    request_ = std::move(request);
 
-    auto host = uri.authority().host();
-    auto hostString = static_cast<std::string>(host);
+    host_ = static_cast<std::string>(uri.authority().host());
+    port_ = uri.authority().port().string();
 
-    socket_->set_verify_callback(ssl::rfc2818_verification(hostString));
-    if (!SSL_set_tlsext_host_name(socket_->native_handle(), hostString.data()))
+    socket_->set_verify_callback(ssl::rfc2818_verification(host_));
+    if (!SSL_set_tlsext_host_name(socket_->native_handle(), host_.data()))
     {
         boost::beast::error_code ec{static_cast<int>(::ERR_get_error()), boost::asio::error::get_ssl_category()};
-        sessionFinished(ec);
+        return sessionFinished(ec);
     }
 
-    resolve(uri.authority().host(),
-            uri.authority().port(),
-            std::bind(&HttpSession::onResolved, shared_from_this(), ph::_1, ph::_2));
+    boost::asio::post(strand_, [self = shared_from_this()]() {
+        self->resolve(std::bind(&HttpSession::onResolved, self, ph::_1, ph::_2));
+    });
+}
+
+bool HttpSession::retryable() const
+{
+    return retryable_;
+}
 
-    return result_.get_future();
+// Set on the session's strand before the result is reported, so it's read only after that
+const boost::optional<http::response_header<>>& HttpSession::responseHeader() const
+{
+    return responseHeader_;
 }
 
 template <typename Callback>
-void HttpSession::resolve(const Uri::Host& host, const Uri::Port& port, Callback callback)
+void HttpSession::resolve(Callback callback)
 {
+    phaseStarted_ = std::chrono::steady_clock::now();
+    armDeadline(timeouts_.connect, "connecting");
+
+    if (auto results = dnsCache_.find(host_, port_))
+    {
+        counters_.resolved(std::chrono::steady_clock::duration::zero(), true);
+        return connect(*results, std::bind(&HttpSession::onConnected, shared_from_this(), ph::_1, ph::_2));
+    }
+
     resolver_.async_resolve(
-        static_cast<std::string>(host), port.string(), ip::resolver_base::numeric_service, callback);
+        host_, port_, ip::resolver_base::numeric_service, boost::asio::bind_executor(strand_, callback));
 }
 
 void HttpSession::onResolved(const boost::system::error_code& ec, ip::tcp::resolver::results_type results)
 {
     if (!ec)
     {
+        counters_.resolved(std::chrono::steady_clock::now() - phaseStarted_, false);
+        dnsCache_.store(host_, port_, results);
+
         connect(results, std::bind(&HttpSession::onConnected, shared_from_this(), ph::_1, ph::_2));
     }
     else
@@ -60,15 +110,27 @@ void HttpSession::onResolved(const boost::system::error_code& ec, ip::tcp::resol
 }
 
 template <typename Callback>
-void HttpSession::connect(ip::tcp::resolver::results_type results, Callback callback)
+void HttpSession::connect(const ip::tcp::resolver::results_type& results, Callback callback)
 {
-    boost::asio::async_connect(socket_->next_layer(), results.begin(), results.end(), callback);
+    phaseStarted_ = std::chrono::steady_clock::now();
+
+    // the connector completes on its own strand
+    connector_ = std::make_shared<HappyEyeballsConnector>(ioc_, results);
+    connector_->connect([this, callback](const boost::system::error_code& ec, HappyEyeballsConnector::Result result) {
+        boost::asio::post(strand_, [callback, ec, result = std::move(result)]() mutable {
+            callback(ec, std::move(result));
+        });
+    });
 }
 
-void HttpSession::onConnected(const boost::system::error_code& ec, ip::tcp::resolver::iterator)
+void HttpSession::onConnected(const boost::system::error_code& ec, HappyEyeballsConnector::Result result)
 {
+    connector_.reset();
     if (!ec)
     {
+        counters_.connected(std::chrono::steady_clock::now() - phaseStarted_, result.endpointIndex > 0);
+        socket_->next_layer() = std::move(result.socket);
+
         if (useSsl_)
         {
             handshake(std::bind(&HttpSession::onHandshaked, shared_from_this(), ph::_1));
@@ -80,6 +142,8 @@ void HttpSession::onConnected(const boost::system::error_code& ec, ip::tcp::reso
     }
     else
     {
+        // addresses may have changed since they were cached
+        dnsCache_.invalidate(host_, port_);
         sessionFinished(ec);
     }
 }
@@ -87,7 +151,8 @@ void HttpSession::onConnected(const boost::system::error_code& ec, ip::tcp::reso
 template <typename Callback>
 void HttpSession::handshake(Callback callback)
 {
-    socket_->async_handshake(ssl::stream_base::client, callback);
+    armDeadline(timeouts_.handshake, "handshaking");
+    socket_->async_handshake(ssl::stream_base::client, boost::asio::bind_executor(strand_, callback));
 }
 
 void HttpSession::onHandshaked(const boost::system::error_code& ec)
@@ -105,13 +170,14 @@ void HttpSession::onHandshaked(const boost::system::error_code& ec)
 template <typename Callback>
 void HttpSession::write(Callback callback)
 {
+    armDeadline(timeouts_.firstByte, "waiting for response");
     if (useSsl_)
     {
-        http::async_write(*socket_, request_, callback);
+        http::async_write(*socket_, *request_, boost::asio::bind_executor(strand_, callback));
     }
     else
     {
-        http::async_write(socket_->next_layer(), request_, callback);
+        http::async_write(socket_->next_layer(), *request_, boost::asio::bind_executor(strand_, callback));
     }
 }
 
@@ -119,7 +185,7 @@ void HttpSession::onWritten(const boost::system::error_code& ec, std::size_t /*b
 {
     if (!ec)
     {
-        read(std::bind(&HttpSession::onRead, shared_from_this(), ph::_1, ph::_2));
+        readHeader(std::bind(&HttpSession::onHeaderRead, shared_from_this(), ph::_1, ph::_2));
     }
     else
     {
@@ -128,34 +194,139 @@ void HttpSession::onWritten(const boost::system::error_code& ec, std::size_t /*b
 }
 
 template <typename Callback>
-void HttpSession::read(Callback callback)
+void HttpSession::readHeader(Callback callback)
+{
+    if (useSsl_)
+    {
+        http::async_read_header(*socket_, buffer_, response_, boost::asio::bind_executor(strand_, callback));
+    }
+    else
+    {
+        http::async_read_header(
+            socket_->next_layer(), buffer_, response_, boost::asio::bind_executor(strand_, callback));
+    }
+}
+
+void HttpSession::onHeaderRead(const boost::system::error_code& ec, std::size_t /*bytes*/)
+{
+    if (ec) return sessionFinished(ec);
+
+    auto contentEncoding = std::string{response_.get()[http::field::content_encoding]};
+    auto encoding = ContentDecoder::encodingFrom(contentEncoding);
+    if (encoding == ContentDecoder::Encoding::Unsupported)
+    {
+        deadline_.cancel();
+        return setHttpResult(HttpResponseResult{PlayerError{"HTTP", "Unsupported encoding " + contentEncoding}, {}});
+    }
+    decoder_ = std::make_unique<ContentDecoder>(encoding);
+
+    if (auto contentLength = response_.content_length())
+    {
+        body_.reserve(*contentLength);
+    }
+
+    if (response_.is_done()) return sessionFinished(ec);
+
+    readBody(std::bind(&HttpSession::onBodyRead, shared_from_this(), ph::_1, ph::_2));
+}
+
+template <typename Callback>
+void HttpSession::readBody(Callback callback)
 {
+    auto&& body = response_.get().body();
+    body.data = bodyChunk_.data();
+    body.size = bodyChunk_.size();
+
+    armDeadline(timeouts_.idle, "reading response");
     if (useSsl_)
     {
-        http::async_read(*socket_, buffer_, response_, callback);
+        http::async_read(*socket_, buffer_, response_, boost::asio::bind_executor(strand_, callback));
     }
     else
     {
-        http::async_read(socket_->next_layer(), buffer_, response_, callback);
+        http::async_read(socket_->next_layer(), buffer_, response_, boost::asio::bind_executor(strand_, callback));
     }
 }
 
-void HttpSession::onRead(const boost::system::error_code& ec, std::size_t /*bytes*/)
+void HttpSession::onBodyRead(boost::system::error_code ec, std::size_t /*bytes*/)
 {
-    sessionFinished(ec);
+    // the chunk buffer is full, it is not an actual error
+    if (ec == http::error::need_buffer)
+    {
+        ec = {};
+    }
+    if (ec) return sessionFinished(ec);
+
+    auto received = bodyChunk_.size() - response_.get().body().size;
+    receivedBodyBytes_ += received;
+    try
+    {
+        decoder_->decode(std::string_view{bodyChunk_.data(), received}, body_);
+    }
+    catch (std::exception& e)
+    {
+        deadline_.cancel();
+        return setHttpResult(HttpResponseResult{PlayerError{"HTTP", e.what()}, {}});
+    }
+    if (body_.size() > bodyLimit_) return sessionFinished(http::error::body_limit);
+
+    if (response_.is_done()) return sessionFinished(ec);
+
+    throttle(received);
+}
+
+// Not reading from the socket lets TCP flow control slow the sender down
+void HttpSession::throttle(uint64_t receivedBytes)
+{
+    std::chrono::steady_clock::duration delay{};
+    if (globalBucket_)
+    {
+        delay = std::max(globalBucket_->consume(receivedBytes), requestBucket_->consume(receivedBytes));
+    }
+
+    if (delay == std::chrono::steady_clock::duration::zero())
+    {
+        return readBody(std::bind(&HttpSession::onBodyRead, shared_from_this(), ph::_1, ph::_2));
+    }
+
+    // waiting for tokens doesn't count as idle time
+    deadline_.cancel();
+    throttleTimer_.expires_after(delay);
+    throttleTimer_.async_wait(
+        boost::asio::bind_executor(strand_, [self = shared_from_this()](const boost::system::error_code& ec) {
+            if (ec || self->resultSet_) return;
+
+            self->readBody(std::bind(&HttpSession::onBodyRead, self, ph::_1, ph::_2));
+        }));
 }
 
 void HttpSession::sessionFinished(const boost::system::error_code& ec)
 {
+    deadline_.cancel();
     if (!ec)
     {
         auto&& message = response_.get();
-        if (message.result() == http::status::ok)
+        counters_.received(receivedBodyBytes_, body_.size());
+        responseHeader_ = message.base();
+
+        // 206 only comes for requests which asked for a range
+        bool complete = message.result() == http::status::ok || message.result() == http::status::partial_content;
+        if (complete && receivedBodyBytes_ > 0 && decoder_ && !decoder_->finished())
+        {
+            // the encoded stream was cut off before its end, the decoded part is not the whole body
+            retryable_ = true;
+            setHttpResult(HttpResponseResult{PlayerError{"HTTP", "Truncated encoded response body"}, {}});
+        }
+        else if (complete)
         {
-            setHttpResult(HttpResponseResult{PlayerError{}, response_.get().body()});
+            setHttpResult(HttpResponseResult{PlayerError{}, std::move(body_)});
         }
         else
         {
+            auto status = message.result();
+            retryable_ = http::to_status_class(status) == http::status_class::server_error ||
+                         status == http::status::request_timeout || status == http::status::too_many_requests;
+
             std::string errorMessage = std::to_string(message.result_int()) + " " + std::string{message.reason()};
             PlayerError error{"HTTP", errorMessage};
             setHttpResult(HttpResponseResult{error, {}});
@@ -163,6 +334,7 @@ void HttpSession::sessionFinished(const boost::system::error_code& ec)
     }
     else
     {
+        retryable_ = ec != http::error::body_limit;
         PlayerError error{"HTTP", ec.message()};
         setHttpResult(HttpResponseResult{error, {}});
     }
@@ -171,13 +343,50 @@ void HttpSession::sessionFinished(const boost::system::error_code& ec)
 void HttpSession::cancel()
 {
     setHttpResult(HttpResponseResult{PlayerError{"HTTP", "Operation Aborted"}, {}});
+    boost::asio::post(strand_, [self = shared_from_this()]() {
+        self->deadline_.cancel();
+        self->throttleTimer_.cancel();
+        self->closeConnection();
+    });
 }
 
-void HttpSession::setHttpResult(const HttpResponseResult& result)
+void HttpSession::setHttpResult(HttpResponseResult result)
 {
-    if (!resultSet_)
+    if (!resultSet_.exchange(true))
     {
-        resultSet_ = true;
-        result_.set_value(result);
+        callback_(std::move(result));
     }
 }
+
+// Expiring timer rearms for the next phase so there is always at most one pending deadline
+void HttpSession::armDeadline(std::chrono::milliseconds timeout, const char* phase)
+{
+    phase_ = phase;
+    deadline_.expires_after(timeout);
+    deadline_.async_wait(
+        boost::asio::bind_executor(strand_, std::bind(&HttpSession::onDeadline, shared_from_this(), ph::_1)));
+}
+
+void HttpSession::onDeadline(const boost::system::error_code& ec)
+{
+    // the handler could have been queued already when the deadline was moved
+    if (ec || resultSet_ || deadline_.expiry() > std::chrono::steady_clock::now()) return;
+
+    counters_.timedOut();
+    retryable_ = true;
+    setHttpResult(HttpResponseResult{PlayerError{"HTTP", std::string{"Timed out while "} + phase_}, {}});
+    closeConnection();
+}
+
+// Pending operations complete with an error which is ignored as the result is already set
+void HttpSession::closeConnection()
+{
+    resolver_.cancel();
+    if (connector_)
+    {
+        connector_->cancel();
+    }
+
+    boost::system::error_code ignored;
+    socket_->next_layer().close(ignored);
+}
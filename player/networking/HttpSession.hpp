@@ -1,17 +1,27 @@
 #pragma once
 
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
 #include <boost/asio/ssl/error.hpp>
 #include <boost/asio/ssl/stream.hpp>
 
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/buffer_body.hpp>
 #include <boost/beast/http/string_body.hpp>
+#include <boost/optional/optional.hpp>
 
-#include <boost/thread/future.hpp>
+#include <limits>
 
 #include "common/types/Uri.hpp"
+#include "networking/ContentCoding.hpp"
+#include "networking/DnsCache.hpp"
+#include "networking/HappyEyeballsConnector.hpp"
+#include "networking/HttpRequestPolicy.hpp"
+#include "networking/HttpTransferStats.hpp"
+#include "networking/TokenBucket.hpp"
 #include "networking/ResponseResult.hpp"
 
 namespace http = boost::beast::http;
@@ -20,25 +30,46 @@ namespace ssl = boost::asio::ssl;
 
 using HttpResponseResult = ResponseResult<std::string>;
 
+// Retries and hedged duplicates of a request share its body instead of copying it per attempt
+using SharedHttpRequest = std::shared_ptr<const http::request<http::string_body>>;
+
 class HttpSession : public std::enable_shared_from_this<HttpSession>
 {
 public:
-    HttpSession(boost::asio::io_context& ioc);
+    using ResultCallback = std::function<void(HttpResponseResult)>;
+
+    HttpSession(boost::asio::io_context& ioc,
+                DnsCache& dnsCache,
+                const HttpTimeouts& timeouts,
+                HttpTransferCounters& counters);
 
-    boost::future<HttpResponseResult> send(const Uri& uri, const http::request<http::string_body>& request);
+    // Body reads are paced by both the shared bucket and a bucket of this session capped at requestRate
+    void setShaping(TokenBucket& globalBucket, uint64_t requestRate);
+    // Applies to both the received and the decoded body, a larger one fails the session for good
+    void setBodyLimit(uint64_t bytes);
+    void send(const Uri& uri, SharedHttpRequest request, ResultCallback callback);
     void cancel();
 
+    // Whether a failed exchange might succeed when repeated (network errors, timeouts, 5xx etc.)
+    bool retryable() const;
+    // Status and fields of a response which was received completely, whatever its status
+    const boost::optional<http::response_header<>>& responseHeader() const;
+
 private:
     void sessionFinished(const boost::system::error_code& ec);
-    void setHttpResult(const HttpResponseResult& result);
+    void setHttpResult(HttpResponseResult result);
+
+    void armDeadline(std::chrono::milliseconds timeout, const char* phase);
+    void onDeadline(const boost::system::error_code& ec);
+    void closeConnection();
 
     template <typename Callback>
-    void resolve(const Uri::Host& host, const Uri::Port& port, Callback callback);
+    void resolve(Callback callback);
     void onResolved(const boost::system::error_code& ec, ip::tcp::resolver::results_type results);
 
     template <typename Callback>
-    void connect(ip::tcp::resolver::results_type results, Callback callback);
-    void onConnected(const boost::system::error_code& ec, ip::tcp::resolver::iterator);
+    void connect(const ip::tcp::resolver::results_type& results, Callback callback);
+    void onConnected(const boost::system::error_code& ec, HappyEyeballsConnector::Result result);
 
     template <typename Callback>
     void handshake(Callback callback);
@@ -49,16 +80,43 @@ private:
     void onWritten(const boost::system::error_code& ec, std::size_t bytesTransferred);
 
     template <typename Callback>
-    void read(Callback callback);
-    void onRead(const boost::system::error_code& ec, std::size_t bytesTransferred);
+    void readHeader(Callback callback);
+    void onHeaderRead(const boost::system::error_code& ec, std::size_t bytesTransferred);
+
+    template <typename Callback>
+    void readBody(Callback callback);
+    void onBodyRead(boost::system::error_code ec, std::size_t bytesTransferred);
+    void throttle(uint64_t receivedBytes);
 
 private:
+    boost::asio::io_context& ioc_;
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+    HttpTimeouts timeouts_;
+    boost::asio::steady_timer deadline_;
+    const char* phase_ = "";
     ip::tcp::resolver resolver_;
+    DnsCache& dnsCache_;
+    std::string host_;
+    std::string port_;
+    std::chrono::steady_clock::time_point phaseStarted_;
+    std::shared_ptr<HappyEyeballsConnector> connector_;
     bool useSsl_ = false;
     std::unique_ptr<ssl::stream<ip::tcp::socket>> socket_;
-    http::request<http::string_body> request_;
-    http::response_parser<http::string_body> response_;
+    SharedHttpRequest request_;
+    // body is read in pieces through bodyChunk_ so that it can be decoded while downloading
+    http::response_parser<http::buffer_body> response_;
     boost::beast::flat_buffer buffer_;
-    boost::promise<HttpResponseResult> result_;
+    std::vector<char> bodyChunk_;
+    std::unique_ptr<ContentDecoder> decoder_;
+    std::string body_;
+    uint64_t receivedBodyBytes_ = 0;
+    uint64_t bodyLimit_ = std::numeric_limits<uint64_t>::max();
+    TokenBucket* globalBucket_ = nullptr;
+    std::unique_ptr<TokenBucket> requestBucket_;
+    boost::asio::steady_timer throttleTimer_;
+    HttpTransferCounters& counters_;
+    ResultCallback callback_;
     std::atomic<bool> resultSet_ = false;
+    bool retryable_ = false;
+    boost::optional<http::response_header<>> responseHeader_;
 };
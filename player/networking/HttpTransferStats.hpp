@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+struct HttpTransferStats
+{
+    uint64_t receivedBytes = 0;  // response bodies as transferred
+    uint64_t decodedBytes = 0;   // response bodies after content decoding
+    uint64_t sentBytes = 0;      // request bodies as transferred
+    uint64_t unencodedSentBytes = 0;
+
+    uint64_t resolves = 0;
+    uint64_t resolveCacheHits = 0;
+    std::chrono::milliseconds resolveTime{0};
+    uint64_t connects = 0;
+    uint64_t connectFallbacks = 0;  // connections established to other than the first endpoint
+    std::chrono::milliseconds connectTime{0};
+
+    uint64_t timeouts = 0;
+    uint64_t retries = 0;
+    uint64_t hedges = 0;  // duplicate requests sent for stragglers
+};
+
+class HttpTransferCounters
+{
+public:
+    void received(uint64_t transferred, uint64_t decoded)
+    {
+        receivedBytes_ += transferred;
+        decodedBytes_ += decoded;
+    }
+
+    void sent(uint64_t transferred, uint64_t unencoded)
+    {
+        sentBytes_ += transferred;
+        unencodedSentBytes_ += unencoded;
+    }
+
+    void resolved(std::chrono::steady_clock::duration duration, bool cached)
+    {
+        ++resolves_;
+        if (cached) ++resolveCacheHits_;
+        resolveTimeMs_ += toMs(duration);
+    }
+
+    void connected(std::chrono::steady_clock::duration duration, bool fallback)
+    {
+        ++connects_;
+        if (fallback) ++connectFallbacks_;
+        connectTimeMs_ += toMs(duration);
+    }
+
+    void timedOut()
+    {
+        ++timeouts_;
+    }
+
+    void retried()
+    {
+        ++retries_;
+    }
+
+    void hedged()
+    {
+        ++hedges_;
+    }
+
+    HttpTransferStats stats() const
+    {
+        HttpTransferStats stats;
+        stats.receivedBytes = receivedBytes_;
+        stats.decodedBytes = decodedBytes_;
+        stats.sentBytes = sentBytes_;
+        stats.unencodedSentBytes = unencodedSentBytes_;
+        stats.resolves = resolves_;
+        stats.resolveCacheHits = resolveCacheHits_;
+        stats.resolveTime = std::chrono::milliseconds{resolveTimeMs_};
+        stats.connects = connects_;
+        stats.connectFallbacks = connectFallbacks_;
+        stats.connectTime = std::chrono::milliseconds{connectTimeMs_};
+        stats.timeouts = timeouts_;
+        stats.retries = retries_;
+        stats.hedges = hedges_;
+        return stats;
+    }
+
+private:
+    static uint64_t toMs(std::chrono::steady_clock::duration duration)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+    }
+
+private:
+    std::atomic<uint64_t> receivedBytes_{0};
+    std::atomic<uint64_t> decodedBytes_{0};
+    std::atomic<uint64_t> sentBytes_{0};
+    std::atomic<uint64_t> unencodedSentBytes_{0};
+    std::atomic<uint64_t> resolves_{0};
+    std::atomic<uint64_t> resolveCacheHits_{0};
+    std::atomic<uint64_t> resolveTimeMs_{0};
+    std::atomic<uint64_t> connects_{0};
+    std::atomic<uint64_t> connectFallbacks_{0};
+    std::atomic<uint64_t> connectTimeMs_{0};
+    std::atomic<uint64_t> timeouts_{0};
+    std::atomic<uint64_t> retries_{0};
+    std::atomic<uint64_t> hedges_{0};
+};
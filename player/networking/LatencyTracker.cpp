@@ -0,0 +1,37 @@
+#include "LatencyTracker.hpp"
+
+#include <algorithm>
+
+LatencyTracker::LatencyTracker(size_t capacity) : capacity_{capacity}
+{
+    samples_.reserve(capacity);
+}
+
+void LatencyTracker::record(std::chrono::milliseconds latency)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    if (samples_.size() < capacity_)
+    {
+        samples_.push_back(latency);
+    }
+    else
+    {
+        samples_[next_] = latency;
+        next_ = (next_ + 1) % capacity_;
+    }
+}
+
+boost::optional<std::chrono::milliseconds> LatencyTracker::percentile(double fraction, size_t minSamples) const
+{
+    std::vector<std::chrono::milliseconds> sorted;
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        if (samples_.empty() || samples_.size() < minSamples) return {};
+        sorted = samples_;
+    }
+
+    auto index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1));
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<long>(index), sorted.end());
+    return sorted[index];
+}
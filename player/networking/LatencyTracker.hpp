@@ -0,0 +1,23 @@
+#pragma once
+
+#include <boost/optional/optional.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+// Keeps the most recent request latencies to derive percentiles from (e.g. hedging thresholds)
+class LatencyTracker
+{
+public:
+    explicit LatencyTracker(size_t capacity);
+
+    void record(std::chrono::milliseconds latency);
+    boost::optional<std::chrono::milliseconds> percentile(double fraction, size_t minSamples) const;
+
+private:
+    size_t capacity_;
+    size_t next_ = 0;
+    std::vector<std::chrono::milliseconds> samples_;
+    mutable std::mutex mutex_;
+};
@@ -0,0 +1,171 @@
+#include "PeerDiscovery.hpp"
+
+#include "common/logger/Logging.hpp"
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/asio/ip/multicast.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+const std::string DiscoveryGroup = "239.255.77.77";
+const std::string AnnouncementTag = "xibo-peer";
+
+static LogRateLimiter g_discoveryErrorsLimiter{1, 60};
+
+PeerDiscovery::PeerDiscovery(unsigned short discoveryPort) :
+    work_{ioc_},
+    socket_{ioc_},
+    announceTimer_{ioc_},
+    groupEndpoint_{ip::make_address(DiscoveryGroup), discoveryPort},
+    random_{std::random_device{}()}
+{
+    instanceId_ = std::to_string(random_());
+}
+
+PeerDiscovery::~PeerDiscovery()
+{
+    stop();
+}
+
+void PeerDiscovery::start(unsigned short servicePort)
+{
+    try
+    {
+        socket_.open(groupEndpoint_.protocol());
+        socket_.set_option(ip::udp::socket::reuse_address(true));
+        socket_.bind(ip::udp::endpoint{ip::address_v4::any(), groupEndpoint_.port()});
+        socket_.set_option(ip::multicast::join_group(groupEndpoint_.address()));
+        // several players on one machine see each other's announcements, others stay on the LAN
+        socket_.set_option(ip::multicast::enable_loopback(true));
+        socket_.set_option(ip::multicast::hops(1));
+
+        if (servicePort != 0)
+        {
+            announcement_ = AnnouncementTag + " " + instanceId_ + " " + std::to_string(servicePort);
+            announce();
+        }
+        receive();
+
+        thread_ = std::make_unique<JoinableThread>([this]() { ioc_.run(); });
+        Log::info("[PeerDiscovery] Listening on {}:{}", DiscoveryGroup, groupEndpoint_.port());
+    }
+    catch (std::exception& e)
+    {
+        Log::error("[PeerDiscovery] Start error: {}", e.what());
+    }
+}
+
+void PeerDiscovery::stop()
+{
+    ioc_.stop();
+    thread_.reset();
+}
+
+void PeerDiscovery::addStaticPeers(const std::string& peers)
+{
+    std::vector<std::string> addresses;
+    boost::split(addresses, peers, [](char c) { return c == ','; });
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    for (auto&& address : addresses)
+    {
+        boost::trim(address);
+        if (address.empty()) continue;
+
+        try
+        {
+            staticPeers_.push_back(Uri::fromString("http://" + address + "/"));
+        }
+        catch (std::exception& e)
+        {
+            Log::error("[PeerDiscovery] Invalid peer {}: {}", address, e.what());
+        }
+    }
+}
+
+std::vector<Uri> PeerDiscovery::peers()
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    auto now = Clock::now();
+    std::vector<Uri> discovered;
+    for (auto it = discoveredPeers_.begin(); it != discoveredPeers_.end();)
+    {
+        if (it->second <= now)
+        {
+            it = discoveredPeers_.erase(it);
+        }
+        else
+        {
+            discovered.push_back(Uri::fromString("http://" + it->first + "/"));
+            ++it;
+        }
+    }
+    std::shuffle(discovered.begin(), discovered.end(), random_);
+
+    auto peers = staticPeers_;
+    peers.insert(peers.end(), discovered.begin(), discovered.end());
+    return peers;
+}
+
+void PeerDiscovery::announce()
+{
+    sendAnnouncement();
+
+    announceTimer_.expires_after(AnnouncePeriod);
+    announceTimer_.async_wait([this](const boost::system::error_code& ec) {
+        if (!ec) announce();
+    });
+}
+
+void PeerDiscovery::sendAnnouncement()
+{
+    auto onSent = [](const boost::system::error_code& ec, size_t) {
+        if (ec)
+        {
+            Log::limited(
+                g_discoveryErrorsLimiter, spdlog::level::err, "[PeerDiscovery] Announce error: {}", ec.message());
+        }
+    };
+    socket_.async_send_to(boost::asio::buffer(announcement_), groupEndpoint_, onSent);
+}
+
+void PeerDiscovery::receive()
+{
+    socket_.async_receive_from(
+        boost::asio::buffer(buffer_), senderEndpoint_, [this](const boost::system::error_code& ec, size_t size) {
+            if (ec == boost::asio::error::operation_aborted) return;
+
+            if (!ec)
+            {
+                onReceived(std::string{buffer_.data(), size}, senderEndpoint_);
+            }
+            receive();
+        });
+}
+
+void PeerDiscovery::onReceived(const std::string& datagram, const ip::udp::endpoint& sender)
+{
+    std::istringstream stream{datagram};
+    std::string tag, instanceId;
+    unsigned short servicePort = 0;
+
+    if (!(stream >> tag >> instanceId >> servicePort) || tag != AnnouncementTag || servicePort == 0) return;
+    if (instanceId == instanceId_) return;
+
+    auto peer = sender.address().to_string() + ":" + std::to_string(servicePort);
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    bool found = discoveredPeers_.count(peer) == 0;
+    discoveredPeers_[peer] = Clock::now() + PeerTtl;
+    lock.unlock();
+
+    // a player which has just started learns about the others without waiting for their next period
+    if (found)
+    {
+        Log::debug("[PeerDiscovery] Peer found: {}", peer);
+        if (!announcement_.empty()) sendAnnouncement();
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "common/JoinableThread.hpp"
+#include "common/types/Uri.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace ip = boost::asio::ip;
+
+// Finds other players on the LAN which share their downloaded media. Every sharing player multicasts
+// the port of its file server to a group limited to the local network and listens for the others'
+// announcements, so a peer disappears a few announcement periods after it stops. Peers configured
+// by hand are always used, which covers networks where multicast is filtered.
+class PeerDiscovery
+{
+    using Clock = std::chrono::steady_clock;
+    static constexpr const std::chrono::seconds AnnouncePeriod{10};
+    static constexpr const std::chrono::seconds PeerTtl{35};
+    static constexpr const size_t MaxDatagramSize = 128;
+
+public:
+    explicit PeerDiscovery(unsigned short discoveryPort);
+    ~PeerDiscovery();
+
+    // servicePort is announced to others, 0 only listens for peers without sharing anything
+    void start(unsigned short servicePort);
+    void stop();
+
+    // comma separated host:port list
+    void addStaticPeers(const std::string& peers);
+
+    // static peers first, then the discovered ones in random order to spread the load between them
+    std::vector<Uri> peers();
+
+private:
+    void announce();
+    void sendAnnouncement();
+    void receive();
+    void onReceived(const std::string& datagram, const ip::udp::endpoint& sender);
+
+private:
+    boost::asio::io_context ioc_;
+    boost::asio::io_context::work work_;
+    ip::udp::socket socket_;
+    boost::asio::steady_timer announceTimer_;
+    ip::udp::endpoint groupEndpoint_;
+    ip::udp::endpoint senderEndpoint_;
+    std::array<char, MaxDatagramSize> buffer_;
+    std::string announcement_;
+    std::string instanceId_;
+
+    std::mutex mutex_;
+    std::vector<Uri> staticPeers_;
+    std::map<std::string, Clock::time_point> discoveredPeers_;
+    std::mt19937 random_;
+
+    std::unique_ptr<JoinableThread> thread_;
+};
@@ -18,7 +18,7 @@ public:
     ProxyHttpRequest(http::verb method,
                      const boost::optional<Uri::UserInfo>& proxyUserInfo,
                      const Uri& target,
-                     const std::string& body) :
+                     std::string body) :
         method_(method),
         proxyUserInfo_(proxyUserInfo),
         target_(target),
@@ -0,0 +1,160 @@
+#include "RetryingHttpRequest.hpp"
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+
+RetryingHttpRequest::RetryingHttpRequest(boost::asio::io_context& ioc,
+                                         const Uri& target,
+                                         http::request<http::string_body> request,
+                                         SessionFactory sessionFactory,
+                                         HttpTransferCounters& counters) :
+    strand_{boost::asio::make_strand(ioc)},
+    backoffTimer_{ioc},
+    hedgeTimer_{ioc},
+    target_{target},
+    request_{std::make_shared<const http::request<http::string_body>>(std::move(request))},
+    sessionFactory_{std::move(sessionFactory)},
+    counters_{counters}
+{
+    policy_.maxAttempts = 1;
+}
+
+void RetryingHttpRequest::setRetryPolicy(const HttpRetryPolicy& policy)
+{
+    policy_ = policy;
+}
+
+void RetryingHttpRequest::setHedging(boost::optional<std::chrono::milliseconds> delay, LatencyTracker& latencies)
+{
+    hedgeDelay_ = delay;
+    latencies_ = &latencies;
+}
+
+void RetryingHttpRequest::setShaper(BandwidthShaper& shaper)
+{
+    shaper_ = &shaper;
+}
+
+void RetryingHttpRequest::setHeaderCallback(HeaderCallback callback)
+{
+    headerCallback_ = std::move(callback);
+}
+
+void RetryingHttpRequest::start(ResultCallback callback)
+{
+    callback_ = std::move(callback);
+    boost::asio::post(strand_, [self = shared_from_this()]() { self->startAttempt(); });
+}
+
+// The result is reported immediately as the io_context might be already stopped
+void RetryingHttpRequest::cancel()
+{
+    finish(HttpResponseResult{PlayerError{"HTTP", "Operation Aborted"}, {}});
+    boost::asio::post(strand_, [self = shared_from_this()]() {
+        self->backoffTimer_.cancel();
+        self->hedgeTimer_.cancel();
+        self->cancelSessions();
+    });
+}
+
+void RetryingHttpRequest::startAttempt()
+{
+    if (finished_) return;
+
+    // callers wait for the result, so downloads are refused instead of being held until the next window
+    if (shaper_ && !shaper_->downloadsAllowed())
+    {
+        PlayerError error{"HTTP", "Downloads are paused until the next download window"};
+        return finish(HttpResponseResult{error, {}});
+    }
+
+    ++attempt_;
+    attemptStarted_ = std::chrono::steady_clock::now();
+    startSession();
+
+    if (hedgeDelay_)
+    {
+        hedgeTimer_.expires_after(*hedgeDelay_);
+        hedgeTimer_.async_wait(boost::asio::bind_executor(
+            strand_, std::bind(&RetryingHttpRequest::onHedgeDelayExpired, shared_from_this(), std::placeholders::_1)));
+    }
+}
+
+void RetryingHttpRequest::startSession()
+{
+    auto session = sessionFactory_();
+    sessions_.push_back(session);
+
+    session->send(target_, request_, [self = shared_from_this(), session](HttpResponseResult result) {
+        boost::asio::post(self->strand_, [self, session, result = std::move(result)]() mutable {
+            self->onSessionFinished(session, std::move(result));
+        });
+    });
+}
+
+void RetryingHttpRequest::onHedgeDelayExpired(const boost::system::error_code& ec)
+{
+    if (ec || finished_ || sessions_.size() != 1) return;
+
+    counters_.hedged();
+    startSession();
+}
+
+void RetryingHttpRequest::onSessionFinished(const std::shared_ptr<HttpSession>& session, HttpResponseResult result)
+{
+    sessions_.erase(std::remove(sessions_.begin(), sessions_.end(), session), sessions_.end());
+    if (finished_) return;
+
+    if (!result.first)
+    {
+        if (latencies_)
+        {
+            auto latency = std::chrono::steady_clock::now() - attemptStarted_;
+            latencies_->record(std::chrono::duration_cast<std::chrono::milliseconds>(latency));
+        }
+        hedgeTimer_.cancel();
+        cancelSessions();
+        return finish(*session, std::move(result));
+    }
+
+    // the hedged duplicate may still succeed
+    if (!sessions_.empty()) return;
+
+    hedgeTimer_.cancel();
+    if (!session->retryable() || attempt_ >= policy_.maxAttempts) return finish(*session, std::move(result));
+
+    counters_.retried();
+    backoffTimer_.expires_after(policy_.backoff(attempt_ - 1));
+    backoffTimer_.async_wait(
+        boost::asio::bind_executor(strand_, [self = shared_from_this()](const boost::system::error_code& ec) {
+            if (!ec) self->startAttempt();
+        }));
+}
+
+void RetryingHttpRequest::finish(const HttpSession& session, HttpResponseResult result)
+{
+    if (headerCallback_ && !finished_ && session.responseHeader())
+    {
+        headerCallback_(*session.responseHeader());
+    }
+    finish(std::move(result));
+}
+
+void RetryingHttpRequest::finish(HttpResponseResult result)
+{
+    if (!finished_.exchange(true))
+    {
+        callback_(std::move(result));
+    }
+}
+
+void RetryingHttpRequest::cancelSessions()
+{
+    for (auto&& session : sessions_)
+    {
+        session->cancel();
+    }
+    sessions_.clear();
+}
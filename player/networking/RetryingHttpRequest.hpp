@@ -0,0 +1,63 @@
+#pragma once
+
+#include "networking/BandwidthShaper.hpp"
+#include "networking/HttpRequestPolicy.hpp"
+#include "networking/HttpSession.hpp"
+#include "networking/LatencyTracker.hpp"
+
+#include <boost/optional/optional.hpp>
+
+// Drives one logical request through as many HttpSessions as the retry policy allows. With a hedge
+// delay a second session is started when the first hasn't finished in time and whichever succeeds
+// first wins; the other one is cancelled.
+class RetryingHttpRequest : public std::enable_shared_from_this<RetryingHttpRequest>
+{
+public:
+    using SessionFactory = std::function<std::shared_ptr<HttpSession>()>;
+    using ResultCallback = std::function<void(HttpResponseResult)>;
+    using HeaderCallback = std::function<void(const http::response_header<>&)>;
+
+    RetryingHttpRequest(boost::asio::io_context& ioc,
+                        const Uri& target,
+                        http::request<http::string_body> request,
+                        SessionFactory sessionFactory,
+                        HttpTransferCounters& counters);
+
+    void setRetryPolicy(const HttpRetryPolicy& policy);
+    void setHedging(boost::optional<std::chrono::milliseconds> delay, LatencyTracker& latencies);
+    // attempts are refused outside of the shaper's download windows
+    void setShaper(BandwidthShaper& shaper);
+    // called with the header of the response which ends the request, before the result
+    void setHeaderCallback(HeaderCallback callback);
+
+    void start(ResultCallback callback);
+    void cancel();
+
+private:
+    void startAttempt();
+    void startSession();
+    void onSessionFinished(const std::shared_ptr<HttpSession>& session, HttpResponseResult result);
+    void onHedgeDelayExpired(const boost::system::error_code& ec);
+    void finish(const HttpSession& session, HttpResponseResult result);
+    void finish(HttpResponseResult result);
+    void cancelSessions();
+
+private:
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+    boost::asio::steady_timer backoffTimer_;
+    boost::asio::steady_timer hedgeTimer_;
+    Uri target_;
+    SharedHttpRequest request_;
+    SessionFactory sessionFactory_;
+    HttpTransferCounters& counters_;
+    HttpRetryPolicy policy_;
+    boost::optional<std::chrono::milliseconds> hedgeDelay_;
+    LatencyTracker* latencies_ = nullptr;
+    BandwidthShaper* shaper_ = nullptr;
+    std::vector<std::shared_ptr<HttpSession>> sessions_;
+    unsigned int attempt_ = 0;
+    std::chrono::steady_clock::time_point attemptStarted_;
+    ResultCallback callback_;
+    HeaderCallback headerCallback_;
+    std::atomic<bool> finished_ = false;
+};
@@ -0,0 +1,49 @@
+#include "TokenBucket.hpp"
+
+#include <algorithm>
+
+// Bursts up to one second worth of data are allowed
+TokenBucket::TokenBucket(uint64_t bytesPerSecond) :
+    bytesPerSecond_{bytesPerSecond},
+    tokens_{static_cast<double>(bytesPerSecond)},
+    lastRefill_{Clock::now()}
+{
+}
+
+void TokenBucket::setRate(uint64_t bytesPerSecond)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    refill(Clock::now());
+    bytesPerSecond_ = bytesPerSecond;
+    tokens_ = std::min(tokens_, static_cast<double>(bytesPerSecond));
+}
+
+uint64_t TokenBucket::rate() const
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+    return bytesPerSecond_;
+}
+
+TokenBucket::Clock::duration TokenBucket::consume(uint64_t bytes)
+{
+    std::unique_lock<std::mutex> lock{mutex_};
+
+    if (bytesPerSecond_ == 0) return Clock::duration::zero();
+
+    refill(Clock::now());
+    tokens_ -= static_cast<double>(bytes);
+    if (tokens_ >= 0) return Clock::duration::zero();
+
+    auto seconds = -tokens_ / static_cast<double>(bytesPerSecond_);
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{seconds});
+}
+
+void TokenBucket::refill(Clock::time_point now)
+{
+    auto elapsed = std::chrono::duration<double>{now - lastRefill_}.count();
+    lastRefill_ = now;
+
+    auto capacity = static_cast<double>(bytesPerSecond_);
+    tokens_ = std::min(tokens_ + elapsed * capacity, capacity);
+}
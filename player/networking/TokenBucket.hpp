@@ -0,0 +1,31 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+// Byte rate limiter for the read path. Readers consume what they have already received and wait
+// for the returned delay before reading again, so the balance may go negative ("debt") instead of
+// making a reader guess how much it is going to get.
+class TokenBucket
+{
+    using Clock = std::chrono::steady_clock;
+
+public:
+    explicit TokenBucket(uint64_t bytesPerSecond = 0);
+
+    // 0 disables limiting
+    void setRate(uint64_t bytesPerSecond);
+    uint64_t rate() const;
+
+    Clock::duration consume(uint64_t bytes);
+
+private:
+    void refill(Clock::time_point now);
+
+private:
+    uint64_t bytesPerSecond_;
+    double tokens_;
+    Clock::time_point lastRefill_;
+    mutable std::mutex mutex_;
+};
@@ -1,12 +1,10 @@
 #include "ScheduleParser.hpp"
 
 #include "cms/xmds/Resources.hpp"
-#include "common/parsing/Parsing.hpp"
 #include "common/dt/DateTime.hpp"
 #include "common/fs/FilePath.hpp"
 #include "common/fs/FileSystem.hpp"
-
-#include <boost/core/ignore_unused.hpp>
+#include "common/parsing/XmlReader.hpp"
 
 namespace Resources = XmdsResources::Schedule;
 
@@ -16,7 +14,7 @@ LayoutSchedule ScheduleParser::scheduleFrom(const FilePath& path)
     {
         if (!FileSystem::exists(path)) return {};
 
-        return scheduleFromImpl(Parsing::xmlFrom(path));
+        return scheduleFromImpl(FileSystem::readFromFile(path));
     }
     catch (std::exception&)
     {
@@ -28,7 +26,7 @@ LayoutSchedule ScheduleParser::scheduleFrom(const std::string& xmlSchedule)
 {
     try
     {
-        return scheduleFromImpl(Parsing::xmlFrom(xmlSchedule));
+        return scheduleFromImpl(xmlSchedule);
     }
     catch (std::exception&)
     {
@@ -36,80 +34,94 @@ LayoutSchedule ScheduleParser::scheduleFrom(const std::string& xmlSchedule)
     }
 }
 
-LayoutSchedule ScheduleParser::scheduleFromImpl(const XmlNode& scheduleXml)
+// Schedule is decoded in a single pass without building an intermediate tree
+LayoutSchedule ScheduleParser::scheduleFromImpl(std::string_view xmlSchedule)
 {
-    LayoutSchedule schedule;
-    auto scheduleNode = scheduleXml.get_child(Resources::Schedule);
+    XmlReader reader{xmlSchedule};
+    if (!reader.nextChild(0) || reader.name() != Resources::Schedule)
+        throw ScheduleParser::Error{"ScheduleParser", "Schedule node is missing"};
 
-    schedule.generatedTime = DateTime::fromString(scheduleNode.get<std::string>(Resources::Generated));
+    LayoutSchedule schedule;
+    schedule.generatedTime = DateTime::fromString(reader.requiredAttribute(Resources::Attrs::Generated));
 
-    for (auto [name, node] : scheduleNode)
+    auto scheduleDepth = reader.depth();
+    while (reader.nextChild(scheduleDepth))
     {
+        auto name = reader.name();
         if (name == Resources::Layout)
-            schedule.regularLayouts.emplace_back(scheduledLayoutFrom(node));
+            schedule.regularLayouts.emplace_back(scheduledLayoutFrom(reader));
         else if (name == Resources::DefaultLayout)
-            schedule.defaultLayout = defaultLayoutFrom(node);
+            schedule.defaultLayout = defaultLayoutFrom(reader);
         else if (name == Resources::Overlays)
-            schedule.overlayLayouts = overlayLayoutsFrom(node);
+            schedule.overlayLayouts = overlayLayoutsFrom(reader);
         else if (name == Resources::GlobalDependants)
-            schedule.globalDependants = dependantsFrom(node);
+            schedule.globalDependants = dependantsFrom(reader);
     }
 
     return schedule;
 }
 
-ScheduledLayout ScheduleParser::scheduledLayoutFrom(const XmlNode& node)
+ScheduledLayout ScheduleParser::scheduledLayoutFrom(XmlReader& reader)
 {
     ScheduledLayout layout;
 
-    layout.scheduleId = node.get<int>(Resources::ScheduleId);
-    layout.id = node.get<int>(Resources::Id);
-    layout.startDT = DateTime::fromString(node.get<std::string>(Resources::StartDT));
-    layout.endDT = DateTime::fromString(node.get<std::string>(Resources::EndDT));
-    layout.priority = node.get<int>(Resources::Priority);
+    layout.scheduleId = reader.attribute<int>(Resources::Attrs::ScheduleId);
+    layout.id = reader.attribute<int>(Resources::Attrs::Id);
+    layout.startDT = DateTime::fromString(reader.requiredAttribute(Resources::Attrs::StartDT));
+    layout.endDT = DateTime::fromString(reader.requiredAttribute(Resources::Attrs::EndDT));
+    layout.priority = reader.attribute<int>(Resources::Attrs::Priority);
 
-    if (auto dependants = node.get_child_optional(Resources::LocalDependants))
+    auto layoutDepth = reader.depth();
+    while (reader.nextChild(layoutDepth))
     {
-        layout.dependants = dependantsFrom(dependants.value());
+        if (reader.name() == Resources::LocalDependants)
+        {
+            layout.dependants = dependantsFrom(reader);
+        }
     }
 
     return layout;
 }
 
-DefaultScheduledLayout ScheduleParser::defaultLayoutFrom(const XmlNode& node)
+DefaultScheduledLayout ScheduleParser::defaultLayoutFrom(XmlReader& reader)
 {
     DefaultScheduledLayout layout;
 
-    layout.id = node.get<int>(Resources::Id);
-    if (auto dependants = node.get_child_optional(Resources::LocalDependants))
+    layout.id = reader.attribute<int>(Resources::Attrs::Id);
+
+    auto layoutDepth = reader.depth();
+    while (reader.nextChild(layoutDepth))
     {
-        layout.dependants = dependantsFrom(dependants.value());
+        if (reader.name() == Resources::LocalDependants)
+        {
+            layout.dependants = dependantsFrom(reader);
+        }
     }
 
     return layout;
 }
 
-LayoutList ScheduleParser::overlayLayoutsFrom(const XmlNode& overlaysNode)
+LayoutList ScheduleParser::overlayLayoutsFrom(XmlReader& reader)
 {
     LayoutList overlayLayouts;
 
-    for (auto [name, node] : overlaysNode)
+    auto overlaysDepth = reader.depth();
+    while (reader.nextChild(overlaysDepth))
     {
-        boost::ignore_unused(name);
-        overlayLayouts.emplace_back(scheduledLayoutFrom(node));
+        overlayLayouts.emplace_back(scheduledLayoutFrom(reader));
     }
 
     return overlayLayouts;
 }
 
-LayoutDependants ScheduleParser::dependantsFrom(const XmlNode& dependantsNode)
+LayoutDependants ScheduleParser::dependantsFrom(XmlReader& reader)
 {
     LayoutDependants dependants;
 
-    for (auto&& [name, file] : dependantsNode)
+    auto dependantsDepth = reader.depth();
+    while (reader.nextChild(dependantsDepth))
     {
-        boost::ignore_unused(name);
-        dependants.emplace_back(file.get_value<std::string>());
+        dependants.emplace_back(reader.readText());
     }
 
     return dependants;
@@ -1,10 +1,10 @@
 #pragma once
 
-#include "common/parsing/Parsing.hpp"
 #include "common/PlayerRuntimeError.hpp"
 #include "schedule/LayoutSchedule.hpp"
 
 class FilePath;
+class XmlReader;
 
 class ScheduleParser
 {
@@ -18,9 +18,9 @@ public:
     LayoutSchedule scheduleFrom(const std::string& xmlSchedule);
 
 private:
-    LayoutSchedule scheduleFromImpl(const XmlNode& scheduleXml);
-    ScheduledLayout scheduledLayoutFrom(const XmlNode& layoutNode);
-    DefaultScheduledLayout defaultLayoutFrom(const XmlNode& layoutNode);
-    LayoutList overlayLayoutsFrom(const XmlNode& overlaysNode);
-    LayoutDependants dependantsFrom(const XmlNode& dependantsNode);
+    LayoutSchedule scheduleFromImpl(std::string_view xmlSchedule);
+    ScheduledLayout scheduledLayoutFrom(XmlReader& reader);
+    DefaultScheduledLayout defaultLayoutFrom(XmlReader& reader);
+    LayoutList overlayLayoutsFrom(XmlReader& reader);
+    LayoutDependants dependantsFrom(XmlReader& reader);
 };
@@ -13,8 +13,17 @@ public:
     MOCK_CONST_METHOD1(cached, bool(const ResourceFile& file));
     MOCK_CONST_METHOD2(cached, bool(const std::string& filename, const Md5Hash& hash));
     MOCK_CONST_METHOD0(cachedFiles, std::vector<std::string>());
+    MOCK_CONST_METHOD1(cachedFile, boost::optional<std::string>(const Md5Hash& hash));
     MOCK_CONST_METHOD0(invalidFiles, std::vector<std::string>());
     MOCK_METHOD1(markAsInvalid, void(const std::string& filename));
     MOCK_METHOD3(save, void(const std::string& filename, const std::string& content, const Md5Hash& md5));
     MOCK_METHOD3(save, void(const std::string& filename, const std::string& content, const DateTime& lastUpdate));
+
+    SignalFileSaved& fileSaved() override
+    {
+        return fileSaved_;
+    }
+
+private:
+    SignalFileSaved fileSaved_;
 };
@@ -21,6 +21,8 @@ Recorder::Recorder()
     }
 }
 
+Recorder::Recorder(std::unique_ptr<DataProvider> dataProvider) : dataProvider_{std::move(dataProvider)} {}
+
 void Recorder::addLayoutRecord(std::unique_ptr<LayoutRecord> record)
 {
     try
@@ -64,7 +66,7 @@ void Recorder::addMediaRecords(MediaRecords&& records)
     }
 }
 
-void Recorder::removeFromQueue(size_t count)
+void Recorder::removeFromQueue(int firstId, int lastId)
 {
     try
     {
@@ -72,7 +74,7 @@ void Recorder::removeFromQueue(size_t count)
 
         checkIfCacheIsValid();
 
-        dataProvider_->remove(count);
+        dataProvider_->remove(firstId, lastId);
     }
     catch (const std::exception& e)
     {
@@ -96,7 +98,7 @@ size_t Recorder::recordsCount() const
     }
 }
 
-Records Recorder::records(size_t count) const
+RecordsBatch Recorder::records(int afterId, size_t count) const
 {
     try
     {
@@ -104,16 +106,22 @@ Records Recorder::records(size_t count) const
 
         checkIfCacheIsValid();
 
-        Records records;
-        for (auto&& data : dataProvider_->retrieve(count))
+        RecordsBatch batch;
+        for (auto&& data : dataProvider_->retrieve(afterId, count))
         {
+            if (batch.firstId == InvalidId)
+            {
+                batch.firstId = data.id;
+            }
+            batch.lastId = data.id;
+
             auto record = createPlayingRecord(data);
             if (record)
             {
-                records.add(std::move(record));
+                batch.records.add(std::move(record));
             }
         }
-        return records;
+        return batch;
     }
     catch (const std::exception& e)
     {
@@ -18,12 +18,13 @@ namespace Stats
         DECLARE_EXCEPTION(Stats::Recorder)
     public:
         Recorder();
+        explicit Recorder(std::unique_ptr<DataProvider> dataProvider);
 
         void addLayoutRecord(std::unique_ptr<LayoutRecord> record);
         void addMediaRecords(MediaRecords&& records);
-        void removeFromQueue(size_t count);
+        void removeFromQueue(int firstId, int lastId);
         size_t recordsCount() const;
-        Records records(size_t count) const;
+        RecordsBatch records(int afterId, size_t count) const;
 
     private:
         std::unique_ptr<Record> createPlayingRecord(const RecordDto& data) const;
@@ -10,4 +10,17 @@ namespace Stats
 {
     using Records = Container<std::unique_ptr<Record>>;
     using MediaRecords = Container<std::unique_ptr<MediaRecord>>;
+
+    // Page of stored records together with the id range it was read from
+    struct RecordsBatch
+    {
+        Records records;
+        int firstId = InvalidId;
+        int lastId = InvalidId;
+
+        bool empty() const
+        {
+            return records.empty();
+        }
+    };
 }
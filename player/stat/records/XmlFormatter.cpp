@@ -3,22 +3,25 @@
 using namespace Stats;
 using namespace std::string_literals;
 
-std::string XmlFormatter::format(const Records& records) const
+const size_t ApproxRecordSize = 192;
+const char* const StatDateFormat = "%Y-%m-%d %H:%M:%S";
+
+std::string XmlFormatter::format(const Records& records)
 {
     try
     {
-        XmlNode root;
-        auto&& stats = root.put_child("stats", XmlNode{});
+        writer_ = XmlWriter{ApproxRecordSize * (records.size() + 1)};
+        writer_.declaration().startElement("stats");
 
         for (auto&& record : records)
         {
-            XmlFormatter formatter;
-            record->apply(formatter);
-
-            stats.add_child("stat", formatter.node_);
+            writer_.startElement("stat");
+            record->apply(*this);
+            writer_.endElement();
         }
 
-        return Parsing::xmlTreeToString(root);
+        writer_.endElement();
+        return writer_.release();
     }
     catch (const std::exception& e)
     {
@@ -28,27 +31,27 @@ std::string XmlFormatter::format(const Records& records) const
 
 void XmlFormatter::fillBase(const Record& record)
 {
-    node_.put(Parsing::xmlAttr("scheduleid"), std::to_string(record.scheduleId()));
-    node_.put(Parsing::xmlAttr("fromdt"), record.started().string("%Y-%m-%d %H:%M:%S"));
-    node_.put(Parsing::xmlAttr("todt"), record.finished().string("%Y-%m-%d %H:%M:%S"));
-    node_.put(Parsing::xmlAttr("duration"), std::to_string(record.duration()));
-    node_.put(Parsing::xmlAttr("count"), std::to_string(record.count()));
+    writer_.attribute("scheduleid", record.scheduleId());
+    writer_.attribute("fromdt", record.started().string(StatDateFormat));
+    writer_.attribute("todt", record.finished().string(StatDateFormat));
+    writer_.attribute("duration", record.duration());
+    writer_.attribute("count", record.count());
 }
 
 void XmlFormatter::visit(const LayoutRecord& record)
 {
     fillBase(record);
 
-    node_.put(Parsing::xmlAttr("type"), Stats::recordTypeToString(RecordType::Layout));
-    node_.put(Parsing::xmlAttr("layoutid"), std::to_string(record.id()));
-    node_.put(Parsing::xmlAttr("mediaid"), "");
+    writer_.attribute("type", Stats::recordTypeToString(RecordType::Layout));
+    writer_.attribute("layoutid", record.id());
+    writer_.attribute("mediaid", "");
 }
 
 void XmlFormatter::visit(const MediaRecord& record)
 {
     fillBase(record);
 
-    node_.put(Parsing::xmlAttr("type"), Stats::recordTypeToString(RecordType::Media));
-    node_.put(Parsing::xmlAttr("layoutid"), std::to_string(record.parentId()));
-    node_.put(Parsing::xmlAttr("mediaid"), record.id());
+    writer_.attribute("type", Stats::recordTypeToString(RecordType::Media));
+    writer_.attribute("layoutid", record.parentId());
+    writer_.attribute("mediaid", record.id());
 }
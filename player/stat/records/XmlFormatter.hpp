@@ -5,7 +5,7 @@
 #include "RecordVisitor.hpp"
 #include "Records.hpp"
 
-#include "common/parsing/Parsing.hpp"
+#include "common/parsing/XmlWriter.hpp"
 #include "common/PlayerRuntimeError.hpp"
 
 namespace Stats
@@ -14,7 +14,7 @@ namespace Stats
     {
         DECLARE_EXCEPTION(Stats::XmlFormatter)        
     public:
-        std::string format(const Records& records) const;
+        std::string format(const Records& records);
 
     protected:
         void visit(const LayoutRecord& record) override;
@@ -24,6 +24,6 @@ namespace Stats
         void fillBase(const Record& record);
 
     private:
-        XmlNode node_;
+        XmlWriter writer_;
     };
 }
@@ -90,14 +90,20 @@ void DatabaseProvider::save(PlayingRecordDtoCollection&& records)
     }
 }
 
-PlayingRecordDtoCollection DatabaseProvider::retrieve(size_t count) const
+PlayingRecordDtoCollection DatabaseProvider::retrieve(int afterId, size_t count) const
 {
     PlayingRecordDtoCollection records;
     
     try
     {
-        SQLite::Statement query(data_->db, "SELECT id, type, started, finished, scheduleId, layoutId, mediaId, duration, count FROM stats LIMIT ?");
-        query.bind(1, static_cast<int>(count));
+        // Records with unknown type are filtered out here so they can't stall paging by id
+        SQLite::Statement query(data_->db,
+            "SELECT id, type, started, finished, scheduleId, layoutId, mediaId, duration, count FROM stats "
+            "WHERE id > ? AND type IN (?, ?) ORDER BY id LIMIT ?");
+        query.bind(1, afterId);
+        query.bind(2, recordTypeToString(RecordType::Layout));
+        query.bind(3, recordTypeToString(RecordType::Media));
+        query.bind(4, static_cast<int>(count));
         
         while (query.executeStep())
         {
@@ -152,12 +158,13 @@ void DatabaseProvider::removeAll()
     }
 }
 
-void DatabaseProvider::remove(size_t count)
+void DatabaseProvider::remove(int fromId, int toId)
 {
     try
     {
-        SQLite::Statement query(data_->db, "DELETE FROM stats WHERE id IN (SELECT id FROM stats ORDER BY id LIMIT ?)");
-        query.bind(1, static_cast<int>(count));
+        SQLite::Statement query(data_->db, "DELETE FROM stats WHERE id BETWEEN ? AND ?");
+        query.bind(1, fromId);
+        query.bind(2, toId);
         query.exec();
     }
     catch (const std::exception& e)
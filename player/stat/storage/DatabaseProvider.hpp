@@ -22,9 +22,9 @@ namespace Stats
 
         void save(const RecordDto& record) override;
         void save(PlayingRecordDtoCollection&& records) override;
-        PlayingRecordDtoCollection retrieve(size_t count) const override;
+        PlayingRecordDtoCollection retrieve(int afterId, size_t count) const override;
         void removeAll() override;
-        void remove(size_t count) override;
+        void remove(int fromId, int toId) override;
         size_t recordsCount() const override;
 
     private: